@@ -12,26 +12,27 @@ import android.media.ImageReader;
 import android.os.Build;
 import android.os.Handler;
 import android.os.HandlerThread;
-import android.os.Environment;
+import android.os.SystemClock;
 import android.util.Log;
+import android.util.Range;
 import android.util.SizeF;
+import android.util.SparseArray;
 import android.view.Surface;
 import java.nio.ByteBuffer;
+import java.util.ArrayList;
 import java.util.Arrays;
 import android.Manifest;
-import org.json.JSONArray;
-import org.json.JSONObject;
 import java.lang.reflect.Field;
 import java.lang.reflect.Method;
 import java.util.List;
-import java.io.File;
-import java.io.FileOutputStream;
-import java.nio.charset.StandardCharsets;
 
 public class Camera2Helper {
     private static final String TAG = "Camera2Helper";
     private static final int CAMERA_PERMISSION_REQUEST_CODE = 100;
-    private static Camera2Helper instance;
+    
+    // One helper per native camera stream, keyed by the native stream id
+    private static final SparseArray<Camera2Helper> instances = new SparseArray<>();
+    private final int streamId;
     
     private Context context;
     private CameraManager cameraManager;
@@ -47,32 +48,115 @@ public class Camera2Helper {
     private int frameHeight = 960;
     private boolean isCapturing = false;
     
-    // Native callback
-    private static native void onFrameAvailable(byte[] data, int width, int height);
-    private static native void onIntrinsicsAvailable(float fx, float fy, float cx, float cy, float skew, int width, int height);
-    private static native void onDistortionAvailable(float[] coeffs, int length);
-    private static native void onOriginalResolutionAvailable(int width, int height);
-    private static native void onPixelArraySizeAvailable(int width, int height);
-    private static native void onActiveArraySizeAvailable(int width, int height);
-    private static native void onCharacteristicsDumpAvailable(String json);
-    private static native void onCameraSelected(String cameraId, boolean isLeftCamera);
-    private static native void onCameraPoseAvailable(float tx, float ty, float tz, float qx, float qy, float qz, float qw);
+    // Warm standby (pauseCapture): no repeating request, but device, session and ImageReader stay open
+    private volatile boolean paused = false;
+    
+    // Startup milestones reported through onStartupMilestone; values shared with ECamera2StartupMilestone
+    private static final int STARTUP_JAVA_START = 4;
+    private static final int STARTUP_CAMERAS_PROBED = 5;
+    private static final int STARTUP_CHARACTERISTICS_READ = 6;
+    private static final int STARTUP_OPEN_REQUESTED = 7;
+    private static final int STARTUP_CAMERA_OPENED = 8;
+    private static final int STARTUP_SESSION_CONFIGURED = 9;
+    private static final int STARTUP_FIRST_IMAGE = 10;
+    // Set by startCamera until the first image of that start arrives
+    private volatile boolean firstImagePending = false;
+    
+    // SENSOR_INFO_TIMESTAMP_SOURCE: true when Image timestamps are elapsedRealtimeNanos (CLOCK_BOOTTIME),
+    // false when they are only comparable with System.nanoTime() (CLOCK_MONOTONIC)
+    private boolean timestampSourceRealtime = false;
+    
+    // Per-frame capture result metadata, joined to Images by sensor timestamp.
+    // Layout is shared with the native side (Camera2FrameMetadataLayout in Camera2Stream.cpp)
+    private static final int META_TIMESTAMP_NS = 0;
+    private static final int META_FRAME_NUMBER = 1;
+    private static final int META_EXPOSURE_TIME_NS = 2;
+    private static final int META_FRAME_DURATION_NS = 3;
+    private static final int META_ROLLING_SHUTTER_SKEW_NS = 4;
+    private static final int META_SENSITIVITY_ISO = 5;
+    private static final int META_FLAGS = 6;
+    private static final int META_CAPTURE_FAILURES = 7;
+    private static final int META_CONTROL_STATE = 8;
+    private static final int META_FIELD_COUNT = 9;
+    private static final long META_FLAG_STARTED = 1;   // timestamp + frame number known
+    private static final long META_FLAG_COMPLETED = 2; // exposure/duration/skew/ISO known
+    private static final long META_CONTROL_MANUAL_EXPOSURE = 1; // CONTROL_AE_MODE_OFF was applied
+    private static final long META_CONTROL_AE_LOCKED = 2;
+    private static final long META_CONTROL_AWB_LOCKED = 4;
+    
+    // Results for recent captures; both the capture callback and the ImageReader listener run on
+    // backgroundHandler, so these are only touched from that thread
+    private static final int META_RING_SIZE = 16;
+    private final long[] captureResultRing = new long[META_RING_SIZE * META_FIELD_COUNT];
+    private int captureResultHead = 0;
+    private long captureFailures = 0;
+    
+    // Reused for every frame handed to native
+    private final long[] frameMetadata = new long[META_FIELD_COUNT];
+    
+    // Sensor controls requested by native (setSensorControls); read whenever the repeating request is built.
+    // Zero values leave the device default in place.
+    private final Object sensorControlLock = new Object();
+    private boolean manualExposure = false;
+    private long manualExposureTimeNs = 0;
+    private int manualSensitivityIso = 0;
+    private long manualFrameDurationNs = 0;
+    private boolean aeLock = false;
+    private boolean awbLock = false;
+    private int targetFpsMin = 0;
+    private int targetFpsMax = 0;
     
-    private Camera2Helper(Context ctx) {
+    // Control ranges of the selected camera, read when it is opened (guarded by sensorControlLock)
+    private boolean manualSensorSupported = false;
+    private Range<Long> exposureTimeRange;
+    private Range<Integer> sensitivityRange;
+    private long maxFrameDurationNs = 0;
+    private Range<Integer>[] availableFpsRanges;
+    
+    // Native callbacks; streamId routes each call to the native stream that owns this helper
+    // metadata is frameMetadata (see META_* layout); sensorClockNowNs is the Image timestamp clock read
+    // just before the call, which the native side pairs with engine time to map sensor timestamps into engine time
+    private static native void onFrameAvailable(int streamId, byte[] data, int width, int height, long[] metadata, long sensorClockNowNs);
+    // YUV_420_888 planes for native conversion; U and V share row and pixel stride per the Image contract
+    private static native void onYuvFrameAvailable(int streamId, ByteBuffer y, ByteBuffer u, ByteBuffer v, int width, int height,
+        int yRowStride, int uvRowStride, int uvPixelStride, long[] metadata, long sensorClockNowNs);
+    private static native void onIntrinsicsAvailable(int streamId, float fx, float fy, float cx, float cy, float skew, int width, int height);
+    private static native void onDistortionAvailable(int streamId, float[] coeffs, int length);
+    private static native void onOriginalResolutionAvailable(int streamId, int width, int height);
+    private static native void onPixelArraySizeAvailable(int streamId, int width, int height);
+    private static native void onActiveArraySizeAvailable(int streamId, int width, int height);
+    // Delivered once per requestCharacteristicsDump, from its thread: keys[i] is described by entries[i * CHAR_ENTRY_FIELDS...]
+    // and its values live in ints, floats or strings (see CharacteristicsTable)
+    private static native void onCharacteristicsAvailable(int streamId, String cameraId, int sdk, String[] keys, int[] entries,
+        long[] ints, float[] floats, String[] strings);
+    private static native void onCameraSelected(int streamId, String cameraId, boolean isLeftCamera);
+    private static native void onCameraPoseAvailable(int streamId, float tx, float ty, float tz, float qx, float qy, float qz, float qw);
+    private static native void onStartupMilestone(int streamId, int milestone);
+    
+    private Camera2Helper(Context ctx, int streamId) {
         this.context = ctx;
+        this.streamId = streamId;
         this.cameraManager = (CameraManager) context.getSystemService(Context.CAMERA_SERVICE);
     }
     
-    public static Camera2Helper getInstance(Context ctx) {
-        Log.d(TAG, "Camera2Helper.getInstance called");
-        if (instance == null) {
-            Log.d(TAG, "Creating new Camera2Helper instance");
-            instance = new Camera2Helper(ctx);
-            Log.d(TAG, "Camera2Helper instance created successfully");
-        } else {
-            Log.d(TAG, "Using existing Camera2Helper instance");
+    public static synchronized Camera2Helper getInstance(Context ctx, int streamId) {
+        Camera2Helper helper = instances.get(streamId);
+        if (helper == null) {
+            Log.d(TAG, "Creating Camera2Helper for stream " + streamId);
+            helper = new Camera2Helper(ctx, streamId);
+            instances.put(streamId, helper);
+        }
+        return helper;
+    }
+    
+    // Stops the stream's camera (if running) and forgets the helper
+    public static synchronized void releaseInstance(int streamId) {
+        Camera2Helper helper = instances.get(streamId);
+        if (helper != null) {
+            helper.stopCamera();
+            instances.remove(streamId);
+            Log.d(TAG, "Released Camera2Helper for stream " + streamId);
         }
-        return instance;
     }
     
     // Helper method to check camera permission
@@ -104,6 +188,7 @@ public class Camera2Helper {
                 Log.w(TAG, "Camera already started - returning true");
                 return true;
             }
+            onStartupMilestone(streamId, STARTUP_JAVA_START);
             
             // Check and request camera permission
             if (!checkCameraPermission()) {
@@ -142,38 +227,13 @@ public class Camera2Helper {
             boolean isLeftCamera = false;
             
             // First pass: look for Quest 3 special cameras (50 = left, 51 = right)
-            boolean has50 = false;
-            boolean has51 = false;
-            for (String id : cameraIds) {
-                if (id.equals("50")) has50 = true;
-                if (id.equals("51")) has51 = true;
-            }
-            
             // Use the camera based on preference (set via setPreferredCamera)
             Log.d(TAG, "Camera preference: " + (preferLeftCamera ? "LEFT" : "RIGHT"));
-            
-            if (preferLeftCamera) {
-                // Prefer left camera (50)
-                if (has50) {
-                    cameraId = "50";
-                    isLeftCamera = true;
-                    Log.d(TAG, "Selected Quest 3 LEFT camera (ID 50) - matches preference");
-                } else if (has51) {
-                    cameraId = "51";
-                    isLeftCamera = false;
-                    Log.d(TAG, "Selected Quest 3 RIGHT camera (ID 51) - fallback (left not available)");
-                }
-            } else {
-                // Prefer right camera (51)
-                if (has51) {
-                    cameraId = "51";
-                    isLeftCamera = false;
-                    Log.d(TAG, "Selected Quest 3 RIGHT camera (ID 51) - matches preference");
-                } else if (has50) {
-                    cameraId = "50";
-                    isLeftCamera = true;
-                    Log.d(TAG, "Selected Quest 3 LEFT camera (ID 50) - fallback (right not available)");
-                }
+            cameraId = pickQuestCamera(cameraIds);
+            if (cameraId != null) {
+                isLeftCamera = cameraId.equals("50");
+                Log.d(TAG, "Selected Quest 3 " + (isLeftCamera ? "LEFT camera (ID 50)" : "RIGHT camera (ID 51)")
+                    + (isLeftCamera == preferLeftCamera ? " - matches preference" : " - fallback (preferred not available)"));
             }
             
             if (cameraId != null) {
@@ -251,18 +311,29 @@ public class Camera2Helper {
             
             // Notify native side which camera was selected
             try {
-                onCameraSelected(cameraId, isLeftCamera);
+                onCameraSelected(streamId, cameraId, isLeftCamera);
                 Log.d(TAG, "Notified native: camera=" + cameraId + " isLeft=" + isLeftCamera);
             } catch (Exception e) {
                 Log.w(TAG, "Failed to notify camera selection: " + e.getMessage());
             }
+            onStartupMilestone(streamId, STARTUP_CAMERAS_PROBED);
             
-            // Trigger an immediate dump of characteristics for this camera
-            try { dumpCameraCharacteristics(); } catch (Exception e) { Log.w(TAG, "Auto dump failed: " + e.getMessage()); }
+            // The full dump is a reflection walk plus a file write; only diagnostics want it at every start,
+            // and even then it runs on its own thread instead of delaying the camera open
+            if (dumpCharacteristicsOnStart) {
+                requestCharacteristicsDump();
+            }
             
             // Query intrinsics for selected camera (if available)
             try {
                 CameraCharacteristics cc = cameraManager.getCameraCharacteristics(cameraId);
+                Integer tsSource = cc.get(CameraCharacteristics.SENSOR_INFO_TIMESTAMP_SOURCE);
+                timestampSourceRealtime = (tsSource != null &&
+                    tsSource == CameraCharacteristics.SENSOR_INFO_TIMESTAMP_SOURCE_REALTIME);
+                Log.d(TAG, "Timestamp source: " + (timestampSourceRealtime ? "REALTIME" : "UNKNOWN (monotonic)"));
+
+                readSensorControlRanges(cc);
+
                 float[] intr = cc.get(CameraCharacteristics.LENS_INTRINSIC_CALIBRATION);
                 float fx = 0, fy = 0, cx = 0, cy = 0, skew = 0;
                 if (intr != null && intr.length >= 4) {
@@ -298,7 +369,7 @@ public class Camera2Helper {
                         srcW = pixelArray.getWidth();
                         srcH = pixelArray.getHeight();
                         Log.d(TAG, "Pixel array size: " + srcW + "x" + srcH);
-                        onPixelArraySizeAvailable(srcW, srcH);
+                        onPixelArraySizeAvailable(streamId, srcW, srcH);
                     }
                 } catch (Exception e) {
                     Log.w(TAG, "SENSOR_INFO_PIXEL_ARRAY_SIZE unavailable: " + e.getMessage());
@@ -311,7 +382,7 @@ public class Camera2Helper {
                             srcW = active.width();
                             srcH = active.height();
                             Log.d(TAG, "Active array size: " + srcW + "x" + srcH);
-                            onActiveArraySizeAvailable(srcW, srcH);
+                            onActiveArraySizeAvailable(streamId, srcW, srcH);
                         }
                     } catch (Exception e) {
                         Log.w(TAG, "ACTIVE_ARRAY_SIZE unavailable: " + e.getMessage());
@@ -319,7 +390,7 @@ public class Camera2Helper {
                 }
 
                 if (srcW > 0 && srcH > 0) {
-                    onOriginalResolutionAvailable(srcW, srcH);
+                    onOriginalResolutionAvailable(streamId, srcW, srcH);
                 }
 
                 // Try to fetch distortion coefficients (varies by device)
@@ -349,7 +420,7 @@ public class Camera2Helper {
 
                 if (lensDist != null && lensDist.length > 0) {
                     Log.d(TAG, "Distortion length=" + lensDist.length);
-                    onDistortionAvailable(lensDist, lensDist.length);
+                    onDistortionAvailable(streamId, lensDist, lensDist.length);
                 } else {
                     Log.d(TAG, "No distortion array available on this device");
                 }
@@ -363,9 +434,9 @@ public class Camera2Helper {
                 Log.d(TAG, "Adjusted intrinsics: fx=" + kStream.fx + " fy=" + kStream.fy + " cx=" + kStream.cx + " cy=" + kStream.cy + " (for " + frameWidth + "x" + frameHeight + ")");
                 
                 // Send ADJUSTED intrinsics that match the output stream resolution
-                onIntrinsicsAvailable(kStream.fx, kStream.fy, kStream.cx, kStream.cy, skew, frameWidth, frameHeight);
+                onIntrinsicsAvailable(streamId, kStream.fx, kStream.fy, kStream.cx, kStream.cy, skew, frameWidth, frameHeight);
 
-                onOriginalResolutionAvailable(srcW, srcH); // keep sending this if your native side logs it
+                onOriginalResolutionAvailable(streamId, srcW, srcH); // keep sending this if your native side logs it
                 
                 // Try to extract and send camera pose (CamInHmd) if available
                 try {
@@ -379,7 +450,7 @@ public class Camera2Helper {
                         Log.d(TAG, "Camera pose found - Rotation: [" + 
                               poseRotation[0] + ", " + poseRotation[1] + ", " + poseRotation[2] + ", " + poseRotation[3] + "]");
                         onCameraPoseAvailable(
-                            poseTranslation[0], poseTranslation[1], poseTranslation[2],
+                            streamId, poseTranslation[0], poseTranslation[1], poseTranslation[2],
                             poseRotation[0], poseRotation[1], poseRotation[2], poseRotation[3]);
                     } else {
                         Log.d(TAG, "Camera pose not available from characteristics");
@@ -391,8 +462,7 @@ public class Camera2Helper {
             } catch (Exception e) {
                 Log.w(TAG, "Failed to get intrinsics: "+e.getMessage());
             }
-
-            
+            onStartupMilestone(streamId, STARTUP_CHARACTERISTICS_READ);
 
             // Setup ImageReader for camera frames
             Log.d(TAG, "Creating ImageReader " + frameWidth + "x" + frameHeight);
@@ -401,13 +471,19 @@ public class Camera2Helper {
             Log.d(TAG, "ImageReader created successfully");
                 
             Log.d(TAG, "Setting up ImageReader listener...");
+            firstImagePending = true;
             imageReader.setOnImageAvailableListener(new ImageReader.OnImageAvailableListener() {
                 @Override
                 public void onImageAvailable(ImageReader reader) {
+                    if (firstImagePending) {
+                        firstImagePending = false;
+                        onStartupMilestone(streamId, STARTUP_FIRST_IMAGE);
+                    }
                     Image image = null;
                     try {
                         image = reader.acquireLatestImage();
-                        if (image != null) {
+                        // Images still in flight when the capture was paused are dropped
+                        if (image != null && !paused) {
                             processImage(image);
                         }
                     } catch (Exception e) {
@@ -423,10 +499,12 @@ public class Camera2Helper {
             
             // Open camera
             Log.d(TAG, "Opening camera...");
+            onStartupMilestone(streamId, STARTUP_OPEN_REQUESTED);
             cameraManager.openCamera(cameraId, new CameraDevice.StateCallback() {
                 @Override
                 public void onOpened(CameraDevice camera) {
                     Log.d(TAG, "Camera opened");
+                    onStartupMilestone(streamId, STARTUP_CAMERA_OPENED);
                     cameraDevice = camera;
                     createCaptureSession();
                 }
@@ -458,6 +536,11 @@ public class Camera2Helper {
         }
     }
 
+    // Current time in the clock domain of Image.getTimestamp()
+    private long sensorClockNowNs() {
+        return timestampSourceRealtime ? SystemClock.elapsedRealtimeNanos() : System.nanoTime();
+    }
+
     private static class Intr {
         float fx, fy, cx, cy;
     }
@@ -483,76 +566,286 @@ public class Camera2Helper {
     // Remember if current camera is left (50) or right (51)
     private boolean currentIsLeftCamera;
     
-    // Static preference for which camera to use (set before startCamera)
+    // Preference for which camera this stream uses (set before startCamera)
     // true = left camera (ID 50), false = right camera (ID 51)
-    private static boolean preferLeftCamera = true;
+    private boolean preferLeftCamera = true;
     
     /**
      * Set the preferred camera before calling startCamera.
      * @param useLeft true for left camera (ID 50), false for right camera (ID 51)
      */
-    public static void setPreferredCamera(boolean useLeft) {
+    public void setPreferredCamera(boolean useLeft) {
         preferLeftCamera = useLeft;
-        Log.d(TAG, "Camera preference set to: " + (useLeft ? "LEFT (50)" : "RIGHT (51)"));
+        Log.d(TAG, "Stream " + streamId + " camera preference set to: " + (useLeft ? "LEFT (50)" : "RIGHT (51)"));
+    }
+    
+    // Quest 3 camera for the preference: the preferred one of 50 (left) / 51 (right), else the other, else null
+    private String pickQuestCamera(String[] cameraIds) {
+        boolean has50 = false;
+        boolean has51 = false;
+        for (String id : cameraIds) {
+            if (id.equals("50")) has50 = true;
+            if (id.equals("51")) has51 = true;
+        }
+        if (preferLeftCamera) {
+            return has50 ? "50" : (has51 ? "51" : null);
+        }
+        return has51 ? "51" : (has50 ? "50" : null);
     }
     
     /**
      * Get the current camera preference.
      * @return true if left camera is preferred
      */
-    public static boolean getPreferredCamera() {
+    public boolean getPreferredCamera() {
         return preferLeftCamera;
     }
-	// Remember last saved dump file path
-	private String lastCharacteristicsDumpPath;
-	// Remember last JSON text
-	private String lastCharacteristicsDumpJson;
-
-    // Public method to dump all CameraCharacteristics to JSON and send to native
-    public void dumpCameraCharacteristics() {
+    // Characteristics are marshalled one request at a time on their own thread (see requestCharacteristicsDump)
+    private final Object characteristicsDumpLock = new Object();
+    private Thread characteristicsDumpThread;
+    // Marshal at every startCamera (Camera2.Diagnostics.DumpCharacteristics); otherwise only on request
+    private volatile boolean dumpCharacteristicsOnStart = false;
+    
+    public void setDumpCharacteristicsOnStart(boolean enabled) {
+        dumpCharacteristicsOnStart = enabled;
+    }
+    
+    /**
+     * Marshal the characteristics of the selected camera on a background thread and deliver the table once
+     * through onCharacteristicsAvailable. A request while one is running joins it.
+     * Does not need the camera to be open.
+     */
+    public void requestCharacteristicsDump() {
+        synchronized (characteristicsDumpLock) {
+            if (characteristicsDumpThread != null) {
+                return;
+            }
+            characteristicsDumpThread = new Thread(new Runnable() {
+                @Override
+                public void run() {
+                    try {
+                        marshalCameraCharacteristics();
+                    } finally {
+                        synchronized (characteristicsDumpLock) {
+                            characteristicsDumpThread = null;
+                        }
+                    }
+                }
+            }, "CameraCharacteristics-" + streamId);
+            characteristicsDumpThread.setPriority(Thread.MIN_PRIORITY);
+            characteristicsDumpThread.start();
+        }
+    }
+    
+    // Value types of the characteristics table, shared with the native side (ECamera2CharacteristicType in
+    // Camera2CharacteristicsTable.h). Each entry is CHAR_ENTRY_FIELDS ints: type, array flag, offset into the
+    // arena of its type and element count.
+    private static final int CHAR_BOOL = 0;
+    private static final int CHAR_INT = 1;
+    private static final int CHAR_FLOAT = 2;
+    private static final int CHAR_RATIONAL = 3;
+    private static final int CHAR_SIZE = 4;
+    private static final int CHAR_SIZEF = 5;
+    private static final int CHAR_RECT = 6;
+    private static final int CHAR_INT_RANGE = 7;
+    private static final int CHAR_FLOAT_RANGE = 8;
+    private static final int CHAR_STRING = 9;
+    private static final int CHAR_ENTRY_FIELDS = 4;
+    
+    // Characteristics flattened in one pass: bools, ints, rationals, sizes, rects and integer ranges go to the
+    // long arena, floats, float sizes and float ranges to the float arena, anything else to the string arena as text
+    private static final class CharacteristicsTable {
+        final ArrayList<String> keys = new ArrayList<>();
+        final ArrayList<String> strings = new ArrayList<>();
+        int[] entries = new int[64 * CHAR_ENTRY_FIELDS];
+        long[] ints = new long[512];
+        float[] floats = new float[64];
+        int intCount = 0;
+        int floatCount = 0;
+        
+        void add(String key, Object val) {
+            if (val == null) {
+                return;
+            }
+            if (val instanceof android.hardware.camera2.params.ColorSpaceTransform) {
+                android.util.Rational[] elements = new android.util.Rational[9];
+                ((android.hardware.camera2.params.ColorSpaceTransform) val).copyElements(elements, 0);
+                val = elements;
+            } else if (val instanceof android.hardware.camera2.params.BlackLevelPattern) {
+                int[] offsets = new int[android.hardware.camera2.params.BlackLevelPattern.COUNT];
+                ((android.hardware.camera2.params.BlackLevelPattern) val).copyTo(offsets, 0);
+                val = offsets;
+            } else if (val instanceof java.util.Collection) {
+                val = ((java.util.Collection<?>) val).toArray();
+            }
+            
+            if (!val.getClass().isArray()) {
+                int type = typeOf(val);
+                int offset = arenaOffset(type);
+                put(type, val);
+                addEntry(key, type, false, offset, 1);
+                return;
+            }
+            
+            // One type for the whole array; mixed arrays are kept as text per element
+            int length = java.lang.reflect.Array.getLength(val);
+            int type = length > 0 ? -1 : CHAR_INT;
+            for (int i = 0; i < length; i++) {
+                int elementType = typeOf(java.lang.reflect.Array.get(val, i));
+                type = (type == -1 || type == elementType) ? elementType : CHAR_STRING;
+            }
+            int offset = arenaOffset(type);
+            for (int i = 0; i < length; i++) {
+                put(type, java.lang.reflect.Array.get(val, i));
+            }
+            addEntry(key, type, true, offset, length);
+        }
+        
+        private static int typeOf(Object v) {
+            if (v instanceof Boolean) return CHAR_BOOL;
+            // Rational is a Number too
+            if (v instanceof android.util.Rational) return CHAR_RATIONAL;
+            if (v instanceof Float || v instanceof Double) return CHAR_FLOAT;
+            if (v instanceof Number) return CHAR_INT;
+            if (v instanceof android.util.Size) return CHAR_SIZE;
+            if (v instanceof SizeF) return CHAR_SIZEF;
+            if (v instanceof android.graphics.Rect) return CHAR_RECT;
+            if (v instanceof Range) {
+                Object lower = ((Range<?>) v).getLower();
+                if (lower instanceof Float || lower instanceof Double) return CHAR_FLOAT_RANGE;
+                if (lower instanceof Number) return CHAR_INT_RANGE;
+            }
+            return CHAR_STRING;
+        }
+        
+        private int arenaOffset(int type) {
+            if (type == CHAR_STRING) return strings.size();
+            if (type == CHAR_FLOAT || type == CHAR_SIZEF || type == CHAR_FLOAT_RANGE) return floatCount;
+            return intCount;
+        }
+        
+        private void put(int type, Object v) {
+            switch (type) {
+                case CHAR_BOOL:
+                    putInt(((Boolean) v) ? 1 : 0);
+                    break;
+                case CHAR_INT:
+                    putInt(((Number) v).longValue());
+                    break;
+                case CHAR_FLOAT:
+                    putFloat(((Number) v).floatValue());
+                    break;
+                case CHAR_RATIONAL:
+                    putInt(((android.util.Rational) v).getNumerator());
+                    putInt(((android.util.Rational) v).getDenominator());
+                    break;
+                case CHAR_SIZE:
+                    putInt(((android.util.Size) v).getWidth());
+                    putInt(((android.util.Size) v).getHeight());
+                    break;
+                case CHAR_SIZEF:
+                    putFloat(((SizeF) v).getWidth());
+                    putFloat(((SizeF) v).getHeight());
+                    break;
+                case CHAR_RECT: {
+                    android.graphics.Rect r = (android.graphics.Rect) v;
+                    putInt(r.left);
+                    putInt(r.top);
+                    putInt(r.right);
+                    putInt(r.bottom);
+                    break;
+                }
+                case CHAR_INT_RANGE:
+                    putInt(((Number) ((Range<?>) v).getLower()).longValue());
+                    putInt(((Number) ((Range<?>) v).getUpper()).longValue());
+                    break;
+                case CHAR_FLOAT_RANGE:
+                    putFloat(((Number) ((Range<?>) v).getLower()).floatValue());
+                    putFloat(((Number) ((Range<?>) v).getUpper()).floatValue());
+                    break;
+                default:
+                    strings.add(toText(v));
+                    break;
+            }
+        }
+        
+        private static String toText(Object v) {
+            if (v == null || !v.getClass().isArray()) {
+                return String.valueOf(v);
+            }
+            StringBuilder sb = new StringBuilder("[");
+            int length = java.lang.reflect.Array.getLength(v);
+            for (int i = 0; i < length; i++) {
+                sb.append(i > 0 ? ", " : "").append(toText(java.lang.reflect.Array.get(v, i)));
+            }
+            return sb.append(']').toString();
+        }
+        
+        private void putInt(long v) {
+            if (intCount == ints.length) ints = Arrays.copyOf(ints, ints.length * 2);
+            ints[intCount++] = v;
+        }
+        
+        private void putFloat(float v) {
+            if (floatCount == floats.length) floats = Arrays.copyOf(floats, floats.length * 2);
+            floats[floatCount++] = v;
+        }
+        
+        private void addEntry(String key, int type, boolean isArray, int offset, int count) {
+            int base = keys.size() * CHAR_ENTRY_FIELDS;
+            if (base + CHAR_ENTRY_FIELDS > entries.length) entries = Arrays.copyOf(entries, entries.length * 2);
+            entries[base] = type;
+            entries[base + 1] = isArray ? 1 : 0;
+            entries[base + 2] = offset;
+            entries[base + 3] = count;
+            keys.add(key);
+        }
+    }
+    
+    // Marshal all CameraCharacteristics into a typed table and send it to native; blocks for the whole walk,
+    // so call it through requestCharacteristicsDump
+    private void marshalCameraCharacteristics() {
         try {
             if (cameraManager == null) {
-                Log.e(TAG, "cameraManager is null; cannot dump characteristics");
+                Log.e(TAG, "cameraManager is null; cannot marshal characteristics");
                 return;
             }
             String id = currentCameraId;
             if (id == null) {
-                // Try a best-effort default
+                // Not started yet: the camera startCamera would pick for this stream's preference
                 String[] ids = cameraManager.getCameraIdList();
-                if (ids != null && ids.length > 0) {
-                    id = ids[0];
+                if (ids != null) {
+                    id = pickQuestCamera(ids);
+                    if (id == null && ids.length > 0) {
+                        id = ids[0];
+                    }
                 }
             }
             if (id == null) {
-                Log.e(TAG, "No cameraId available for dump");
+                Log.e(TAG, "No cameraId available for characteristics");
                 return;
             }
-
+            
+            long startNs = SystemClock.elapsedRealtimeNanos();
             CameraCharacteristics cc = cameraManager.getCameraCharacteristics(id);
-            JSONObject root = new JSONObject();
-            root.put("cameraId", id);
-            root.put("sdk", Build.VERSION.SDK_INT);
-
-            JSONObject values = new JSONObject();
+            CharacteristicsTable table = new CharacteristicsTable();
             // Prefer official getKeys() when available
-            boolean dumpedAny = false;
+            boolean marshalledAny = false;
             try {
                 Method getKeysMethod = CameraCharacteristics.class.getMethod("getKeys");
                 @SuppressWarnings("unchecked")
                 List<CameraCharacteristics.Key<?>> keys = (List<CameraCharacteristics.Key<?>>) getKeysMethod.invoke(cc);
                 if (keys != null) {
                     for (CameraCharacteristics.Key<?> key : keys) {
-                        String keyName = getKeyName(key);
-                        Object val = safeGet(cc, key);
-                        values.put(keyName, toJsonValue(val));
-                        dumpedAny = true;
+                        table.add(getKeyName(key), safeGet(cc, key));
+                        marshalledAny = true;
                     }
                 }
             } catch (Throwable t) {
                 Log.w(TAG, "getKeys() unavailable; will use reflection fallback: " + t.getMessage());
             }
-
-            if (!dumpedAny) {
+            
+            if (!marshalledAny) {
                 // Reflection fallback: static fields of type CameraCharacteristics.Key
                 for (Field f : CameraCharacteristics.class.getFields()) {
                     try {
@@ -561,29 +854,23 @@ public class Camera2Helper {
                             CameraCharacteristics.Key<?> key = (CameraCharacteristics.Key<?>) f.get(null);
                             if (key != null) {
                                 // Prefer the public constant field name for readability
-                                String keyName = f.getName();
-                                Object val = safeGet(cc, key);
-                                values.put(keyName, toJsonValue(val));
+                                table.add(f.getName(), safeGet(cc, key));
                             }
                         }
                     } catch (Throwable ignored) { }
                 }
             }
-
-            root.put("values", values);
-            String json = root.toString();
-            Log.d(TAG, "Dumped CameraCharacteristics JSON length=" + json.length());
-			lastCharacteristicsDumpJson = json;
-			// Also persist the dump to a file accessible via adb (scoped storage safe)
-			try {
-				String fileName = "camera_characteristics_" + id + ".json";
-				saveJsonToFile(fileName, json);
-			} catch (Exception e) {
-				Log.w(TAG, "Failed to save characteristics JSON to file: " + e.getMessage());
-			}
-            onCharacteristicsDumpAvailable(json);
+            
+            Log.d(TAG, "Marshalled " + table.keys.size() + " CameraCharacteristics of camera " + id + " in "
+                + ((SystemClock.elapsedRealtimeNanos() - startNs) / 1000) + " us");
+            onCharacteristicsAvailable(streamId, id, Build.VERSION.SDK_INT,
+                table.keys.toArray(new String[0]),
+                Arrays.copyOf(table.entries, table.keys.size() * CHAR_ENTRY_FIELDS),
+                Arrays.copyOf(table.ints, table.intCount),
+                Arrays.copyOf(table.floats, table.floatCount),
+                table.strings.toArray(new String[0]));
         } catch (Exception e) {
-            Log.e(TAG, "Failed to dump CameraCharacteristics: " + e.getMessage());
+            Log.e(TAG, "Failed to marshal CameraCharacteristics: " + e.getMessage());
         }
     }
 
@@ -613,51 +900,6 @@ public class Camera2Helper {
         }
     }
 
-    private static Object toJsonValue(Object val) {
-        if (val == null) return JSONObject.NULL;
-        if (val instanceof Number || val instanceof Boolean || val instanceof String) return val;
-        if (val instanceof android.util.Size) {
-            android.util.Size s = (android.util.Size) val;
-            JSONObject o = new JSONObject();
-            try { o.put("width", s.getWidth()); o.put("height", s.getHeight()); } catch (Exception ignored) {}
-            return o;
-        }
-        if (val instanceof android.graphics.Rect) {
-            android.graphics.Rect r = (android.graphics.Rect) val;
-            JSONObject o = new JSONObject();
-            try { o.put("left", r.left); o.put("top", r.top); o.put("right", r.right); o.put("bottom", r.bottom); } catch (Exception ignored) {}
-            return o;
-        }
-        if (val instanceof android.util.Range) {
-            android.util.Range<?> r = (android.util.Range<?>) val;
-            JSONObject o = new JSONObject();
-            try { o.put("lower", String.valueOf(r.getLower())); o.put("upper", String.valueOf(r.getUpper())); } catch (Exception ignored) {}
-            return o;
-        }
-        if (val instanceof SizeF) {
-            SizeF s = (SizeF) val;
-            JSONObject o = new JSONObject();
-            try { o.put("width", s.getWidth()); o.put("height", s.getHeight()); } catch (Exception ignored) {}
-            return o;
-        }
-        if (val.getClass().isArray()) {
-            JSONArray arr = new JSONArray();
-            int len = java.lang.reflect.Array.getLength(val);
-            for (int i = 0; i < len; i++) {
-                Object e = java.lang.reflect.Array.get(val, i);
-                arr.put(toJsonValue(e));
-            }
-            return arr;
-        }
-        if (val instanceof java.util.Collection) {
-            JSONArray arr = new JSONArray();
-            for (Object e : (java.util.Collection<?>) val) arr.put(toJsonValue(e));
-            return arr;
-        }
-        // Fallback
-        return String.valueOf(val);
-    }
-
     private static Intr intrinsicsForStream(float fx, float fy, float cx, float cy,  int sensorW, int sensorH, int outW, int outH) {
         android.graphics.Rect crop = centerCrop(sensorW, sensorH, outW, outH);
         float sx = (float) outW / (float) crop.width();
@@ -669,55 +911,6 @@ public class Camera2Helper {
         k.cy = (cy - crop.top) * sy;
         return k;
     }
-	
-	private void saveJsonToFile(String fileName, String jsonContent) {
-		File baseDir = null;
-		try {
-			// Prefer Documents in the app-specific external files (no WRITE permission required)
-			baseDir = context.getExternalFilesDir(Environment.DIRECTORY_DOCUMENTS);
-			if (baseDir == null) {
-				// Fallback to generic external files dir
-				baseDir = context.getExternalFilesDir(null);
-			}
-			if (baseDir == null) {
-				// Final fallback to internal files dir
-				baseDir = context.getFilesDir();
-			}
-			File outDir = new File(baseDir, "Camera2");
-			if (!outDir.exists()) {
-				//noinspection ResultOfMethodCallIgnored
-				outDir.mkdirs();
-			}
-			File outFile = new File(outDir, fileName);
-			try (FileOutputStream fos = new FileOutputStream(outFile, false)) {
-				byte[] bytes = jsonContent.getBytes(StandardCharsets.UTF_8);
-				fos.write(bytes);
-				fos.flush();
-			}
-			lastCharacteristicsDumpPath = outFile.getAbsolutePath();
-			Log.i(TAG, "CameraCharacteristics JSON saved: " + outFile.getAbsolutePath());
-		} catch (Throwable t) {
-			Log.w(TAG, "Error saving JSON to file in " + (baseDir != null ? baseDir.getAbsolutePath() : "<null>") + ": " + t.getMessage());
-		}
-	}
-	
-	// Exposed getters/wrappers for native side
-	public String getLastCharacteristicsDumpPath() {
-		return lastCharacteristicsDumpPath != null ? lastCharacteristicsDumpPath : "";
-	}
-	public String getLastCharacteristicsDumpJson() {
-		return lastCharacteristicsDumpJson != null ? lastCharacteristicsDumpJson : "";
-	}
-	
-	public String dumpCameraCharacteristicsAndReturnPath() {
-		dumpCameraCharacteristics();
-		return getLastCharacteristicsDumpPath();
-	}
-	
-	public String[] dumpCameraCharacteristicsAndReturnJsonAndPath() {
-		dumpCameraCharacteristics();
-		return new String[] { getLastCharacteristicsDumpJson(), getLastCharacteristicsDumpPath() };
-	}
     
     private void createCaptureSession() {
         try {
@@ -730,6 +923,7 @@ public class Camera2Helper {
                         Log.d(TAG, "Capture session configured");
                         captureSession = session;
                         startCapture();
+                        onStartupMilestone(streamId, STARTUP_SESSION_CONFIGURED);
                     }
                     
                     @Override
@@ -743,20 +937,95 @@ public class Camera2Helper {
         }
     }
     
+    private final CameraCaptureSession.CaptureCallback captureCallback = new CameraCaptureSession.CaptureCallback() {
+        @Override
+        public void onCaptureStarted(CameraCaptureSession session, CaptureRequest request, long timestamp, long frameNumber) {
+            int base = captureResultSlot(timestamp);
+            captureResultRing[base + META_FRAME_NUMBER] = frameNumber;
+            captureResultRing[base + META_FLAGS] |= META_FLAG_STARTED;
+        }
+        
+        @Override
+        public void onCaptureCompleted(CameraCaptureSession session, CaptureRequest request, TotalCaptureResult result) {
+            Long timestamp = result.get(CaptureResult.SENSOR_TIMESTAMP);
+            if (timestamp == null) {
+                return;
+            }
+            int base = captureResultSlot(timestamp);
+            captureResultRing[base + META_FRAME_NUMBER] = result.getFrameNumber();
+            captureResultRing[base + META_EXPOSURE_TIME_NS] = longOrZero(result.get(CaptureResult.SENSOR_EXPOSURE_TIME));
+            captureResultRing[base + META_FRAME_DURATION_NS] = longOrZero(result.get(CaptureResult.SENSOR_FRAME_DURATION));
+            captureResultRing[base + META_ROLLING_SHUTTER_SKEW_NS] = longOrZero(result.get(CaptureResult.SENSOR_ROLLING_SHUTTER_SKEW));
+            Integer iso = result.get(CaptureResult.SENSOR_SENSITIVITY);
+            captureResultRing[base + META_SENSITIVITY_ISO] = iso != null ? iso : 0;
+            Integer aeMode = result.get(CaptureResult.CONTROL_AE_MODE);
+            long controlState = 0;
+            if (aeMode != null && aeMode == CameraMetadata.CONTROL_AE_MODE_OFF) controlState |= META_CONTROL_MANUAL_EXPOSURE;
+            if (Boolean.TRUE.equals(result.get(CaptureResult.CONTROL_AE_LOCK))) controlState |= META_CONTROL_AE_LOCKED;
+            if (Boolean.TRUE.equals(result.get(CaptureResult.CONTROL_AWB_LOCK))) controlState |= META_CONTROL_AWB_LOCKED;
+            captureResultRing[base + META_CONTROL_STATE] = controlState;
+            captureResultRing[base + META_FLAGS] |= META_FLAG_STARTED | META_FLAG_COMPLETED;
+        }
+        
+        @Override
+        public void onCaptureFailed(CameraCaptureSession session, CaptureRequest request, CaptureFailure failure) {
+            captureFailures++;
+        }
+        
+        @Override
+        public void onCaptureBufferLost(CameraCaptureSession session, CaptureRequest request, Surface target, long frameNumber) {
+            captureFailures++;
+        }
+    };
+    
+    private static long longOrZero(Long value) {
+        return value != null ? value : 0L;
+    }
+    
+    // Ring offset of the entry for a sensor timestamp, claiming the oldest entry if it is new
+    private int captureResultSlot(long timestampNs) {
+        for (int i = 0; i < META_RING_SIZE; i++) {
+            int base = i * META_FIELD_COUNT;
+            if (captureResultRing[base + META_TIMESTAMP_NS] == timestampNs && captureResultRing[base + META_FLAGS] != 0) {
+                return base;
+            }
+        }
+        int base = captureResultHead * META_FIELD_COUNT;
+        captureResultHead = (captureResultHead + 1) % META_RING_SIZE;
+        Arrays.fill(captureResultRing, base, base + META_FIELD_COUNT, 0L);
+        captureResultRing[base + META_TIMESTAMP_NS] = timestampNs;
+        return base;
+    }
+    
+    // Fill frameMetadata for an Image; fields stay zero if its capture result has not arrived
+    private long[] metadataForImage(Image image) {
+        long timestampNs = image.getTimestamp();
+        Arrays.fill(frameMetadata, 0L);
+        frameMetadata[META_TIMESTAMP_NS] = timestampNs;
+        for (int i = 0; i < META_RING_SIZE; i++) {
+            int base = i * META_FIELD_COUNT;
+            if (captureResultRing[base + META_TIMESTAMP_NS] == timestampNs && captureResultRing[base + META_FLAGS] != 0) {
+                System.arraycopy(captureResultRing, base, frameMetadata, 0, META_FIELD_COUNT);
+                break;
+            }
+        }
+        frameMetadata[META_CAPTURE_FAILURES] = captureFailures;
+        return frameMetadata;
+    }
+    
     private void startCapture() {
         try {
-            CaptureRequest.Builder requestBuilder = 
-                cameraDevice.createCaptureRequest(CameraDevice.TEMPLATE_PREVIEW);
-            requestBuilder.addTarget(imageReader.getSurface());
+            // Reset per-session capture bookkeeping; frame numbers restart with the session
+            Arrays.fill(captureResultRing, 0L);
+            captureResultHead = 0;
+            captureFailures = 0;
             
-            // Set auto-focus and auto-exposure
-            requestBuilder.set(CaptureRequest.CONTROL_AF_MODE,
-                CaptureRequest.CONTROL_AF_MODE_CONTINUOUS_PICTURE);
-            requestBuilder.set(CaptureRequest.CONTROL_AE_MODE,
-                CaptureRequest.CONTROL_AE_MODE_ON_AUTO_FLASH);
-            
-            captureSession.setRepeatingRequest(requestBuilder.build(),
-                null, backgroundHandler);
+            if (paused) {
+                Log.d(TAG, "Capture session ready, paused");
+                return;
+            }
+            captureSession.setRepeatingRequest(buildRepeatingRequest(),
+                captureCallback, backgroundHandler);
                 
             Log.d(TAG, "Camera capture started");
             
@@ -765,6 +1034,182 @@ public class Camera2Helper {
         }
     }
     
+    // Preview request with the current sensor controls. Focus and flash are left to the template:
+    // passthrough sensors are fixed-focus and have no flash.
+    private CaptureRequest buildRepeatingRequest() throws CameraAccessException {
+        CaptureRequest.Builder requestBuilder = 
+            cameraDevice.createCaptureRequest(CameraDevice.TEMPLATE_PREVIEW);
+        requestBuilder.addTarget(imageReader.getSurface());
+        
+        synchronized (sensorControlLock) {
+            if (manualExposure && manualSensorSupported) {
+                requestBuilder.set(CaptureRequest.CONTROL_AE_MODE, CaptureRequest.CONTROL_AE_MODE_OFF);
+                if (manualExposureTimeNs > 0) {
+                    requestBuilder.set(CaptureRequest.SENSOR_EXPOSURE_TIME, clampToRange(manualExposureTimeNs, exposureTimeRange));
+                }
+                if (manualSensitivityIso > 0) {
+                    requestBuilder.set(CaptureRequest.SENSOR_SENSITIVITY, clampToRange(manualSensitivityIso, sensitivityRange));
+                }
+                long frameDurationNs = manualFrameDurationNs > 0 ? manualFrameDurationNs
+                    : (targetFpsMax > 0 ? 1000000000L / targetFpsMax : 0);
+                if (frameDurationNs > 0) {
+                    requestBuilder.set(CaptureRequest.SENSOR_FRAME_DURATION,
+                        maxFrameDurationNs > 0 ? Math.min(frameDurationNs, maxFrameDurationNs) : frameDurationNs);
+                }
+            } else {
+                if (manualExposure) {
+                    Log.w(TAG, "Stream " + streamId + ": MANUAL_SENSOR not supported, keeping auto-exposure");
+                }
+                requestBuilder.set(CaptureRequest.CONTROL_AE_MODE, CaptureRequest.CONTROL_AE_MODE_ON);
+                requestBuilder.set(CaptureRequest.CONTROL_AE_LOCK, aeLock);
+                Range<Integer> fpsRange = chooseFpsRange(targetFpsMin, targetFpsMax);
+                if (fpsRange != null) {
+                    requestBuilder.set(CaptureRequest.CONTROL_AE_TARGET_FPS_RANGE, fpsRange);
+                }
+            }
+            requestBuilder.set(CaptureRequest.CONTROL_AWB_LOCK, awbLock);
+        }
+        return requestBuilder.build();
+    }
+    
+    /**
+     * Set exposure controls. Applied by replacing the repeating request on the running session,
+     * or with the first request when the camera starts. Zero values keep the device default.
+     * @param manual CONTROL_AE_MODE_OFF with the given exposure, ISO and frame duration (needs MANUAL_SENSOR)
+     * @param fpsMin,fpsMax CONTROL_AE_TARGET_FPS_RANGE under auto-exposure (closest supported range);
+     *        with manual exposure and no frame duration, fpsMax sets it
+     */
+    public void setSensorControls(boolean manual, long exposureTimeNs, int sensitivityIso, long frameDurationNs,
+                                  boolean lockAe, boolean lockAwb, int fpsMin, int fpsMax) {
+        synchronized (sensorControlLock) {
+            manualExposure = manual;
+            manualExposureTimeNs = exposureTimeNs;
+            manualSensitivityIso = sensitivityIso;
+            manualFrameDurationNs = frameDurationNs;
+            aeLock = lockAe;
+            awbLock = lockAwb;
+            targetFpsMin = fpsMin;
+            targetFpsMax = fpsMax;
+        }
+        
+        Handler handler = backgroundHandler;
+        if (handler != null) {
+            handler.post(new Runnable() {
+                @Override
+                public void run() {
+                    updateRepeatingRequest();
+                }
+            });
+        }
+    }
+    
+    // Swap the repeating request on the live session (background thread); no-op before the session exists
+    private void updateRepeatingRequest() {
+        if (paused || captureSession == null || cameraDevice == null || imageReader == null) {
+            return;
+        }
+        try {
+            captureSession.setRepeatingRequest(buildRepeatingRequest(), captureCallback, backgroundHandler);
+            Log.d(TAG, "Stream " + streamId + ": repeating request updated");
+        } catch (Exception e) {
+            Log.e(TAG, "Failed to update repeating request: " + e.getMessage());
+        }
+    }
+    
+    /**
+     * Stop frame delivery but keep the camera device, capture session and ImageReader open,
+     * so resumeCapture only has to reissue the repeating request.
+     * @return false if the camera is not running
+     */
+    public boolean pauseCapture() {
+        Handler handler = backgroundHandler;
+        if (!isCapturing || handler == null) {
+            return false;
+        }
+        paused = true;
+        handler.post(new Runnable() {
+            @Override
+            public void run() {
+                try {
+                    if (captureSession != null) {
+                        captureSession.stopRepeating();
+                    }
+                    Log.d(TAG, "Stream " + streamId + ": capture paused");
+                } catch (Exception e) {
+                    Log.e(TAG, "Failed to pause capture: " + e.getMessage());
+                }
+            }
+        });
+        return true;
+    }
+    
+    /**
+     * Reissue the repeating request after pauseCapture.
+     * @return false if the camera is gone (e.g. disconnected while in the background) and must be restarted
+     */
+    public boolean resumeCapture() {
+        Handler handler = backgroundHandler;
+        if (!isCapturing || handler == null || cameraDevice == null) {
+            return false;
+        }
+        paused = false;
+        handler.post(new Runnable() {
+            @Override
+            public void run() {
+                updateRepeatingRequest();
+            }
+        });
+        return true;
+    }
+    
+    @SuppressWarnings("unchecked")
+    private void readSensorControlRanges(CameraCharacteristics cc) {
+        synchronized (sensorControlLock) {
+            manualSensorSupported = false;
+            int[] capabilities = cc.get(CameraCharacteristics.REQUEST_AVAILABLE_CAPABILITIES);
+            if (capabilities != null) {
+                for (int capability : capabilities) {
+                    if (capability == CameraMetadata.REQUEST_AVAILABLE_CAPABILITIES_MANUAL_SENSOR) {
+                        manualSensorSupported = true;
+                    }
+                }
+            }
+            exposureTimeRange = cc.get(CameraCharacteristics.SENSOR_INFO_EXPOSURE_TIME_RANGE);
+            sensitivityRange = cc.get(CameraCharacteristics.SENSOR_INFO_SENSITIVITY_RANGE);
+            Long maxDuration = cc.get(CameraCharacteristics.SENSOR_INFO_MAX_FRAME_DURATION);
+            maxFrameDurationNs = maxDuration != null ? maxDuration : 0;
+            availableFpsRanges = cc.get(CameraCharacteristics.CONTROL_AE_AVAILABLE_TARGET_FPS_RANGES);
+        }
+        Log.d(TAG, "Stream " + streamId + ": manual sensor " + (manualSensorSupported ? "supported" : "not supported")
+            + ", exposure " + exposureTimeRange + " ns, ISO " + sensitivityRange);
+    }
+    
+    private static long clampToRange(long value, Range<Long> range) {
+        return range != null ? Math.max(range.getLower(), Math.min(range.getUpper(), value)) : value;
+    }
+    
+    private static int clampToRange(int value, Range<Integer> range) {
+        return range != null ? Math.max(range.getLower(), Math.min(range.getUpper(), value)) : value;
+    }
+    
+    // Supported AE fps range closest to [fpsMin, fpsMax], preferring a matching upper bound; null to keep the default
+    private Range<Integer> chooseFpsRange(int fpsMin, int fpsMax) {
+        if (fpsMax <= 0 || availableFpsRanges == null) {
+            return null;
+        }
+        int lower = fpsMin > 0 ? fpsMin : fpsMax;
+        Range<Integer> best = null;
+        int bestCost = Integer.MAX_VALUE;
+        for (Range<Integer> range : availableFpsRanges) {
+            int cost = Math.abs(range.getUpper() - fpsMax) * 1000 + Math.abs(range.getLower() - lower);
+            if (cost < bestCost) {
+                best = range;
+                bestCost = cost;
+            }
+        }
+        return best;
+    }
+    
     private void processImage(Image image) {
         try {
             // Get all planes (Y, U, V) for full color processing
@@ -780,41 +1225,11 @@ public class Camera2Helper {
                 Log.v(TAG, "Full color processing: " + imageWidth + "x" + imageHeight + 
                       " planes=" + planes.length);
                 
-                // Extract Y data (full resolution)
-                ByteBuffer yBuffer = yPlane.getBuffer();
-                int ySize = yBuffer.remaining();
-                byte[] yData = new byte[ySize];
-                yBuffer.get(yData);
-                
-                // Extract U data (usually half resolution)
-                ByteBuffer uBuffer = uPlane.getBuffer();
-                int uSize = uBuffer.remaining();
-                byte[] uData = new byte[uSize];
-                uBuffer.get(uData);
-                
-                // Extract V data (usually half resolution)
-                ByteBuffer vBuffer = vPlane.getBuffer();
-                int vSize = vBuffer.remaining();
-                byte[] vData = new byte[vSize];
-                vBuffer.get(vData);
-                
-                Log.d(TAG, "YUV data sizes - Y: " + ySize + ", U: " + uSize + ", V: " + vSize);
-                Log.d(TAG, "Plane strides - Y: " + yPlane.getRowStride() + 
-                      ", U: " + uPlane.getRowStride() + ", V: " + vPlane.getRowStride());
-                Log.d(TAG, "Pixel strides - Y: " + yPlane.getPixelStride() + 
-                      ", U: " + uPlane.getPixelStride() + ", V: " + vPlane.getPixelStride());
-                
-                // Convert YUV to RGB
-                byte[] rgbaData = convertYuvToRgba(yData, uData, vData, imageWidth, imageHeight,
-                    yPlane.getRowStride(), uPlane.getRowStride(), vPlane.getRowStride(),
-                    yPlane.getPixelStride(), uPlane.getPixelStride(), vPlane.getPixelStride());
-                
-                // Send to native
-                if (rgbaData != null) {
-                    latestFrameData = rgbaData;
-                    Log.v(TAG, "Sending full color RGBA data to native: size=" + rgbaData.length);
-                    onFrameAvailable(rgbaData, frameWidth, frameHeight);
-                }
+                // Hand the plane buffers to native as-is: they are direct buffers that stay valid
+                // until the image is closed, which happens after this synchronous call returns
+                onYuvFrameAvailable(streamId, yPlane.getBuffer(), uPlane.getBuffer(), vPlane.getBuffer(),
+                    imageWidth, imageHeight, yPlane.getRowStride(), uPlane.getRowStride(), uPlane.getPixelStride(),
+                    metadataForImage(image), sensorClockNowNs());
             } else {
                 Log.w(TAG, "Not enough planes for color processing (got " + planes.length + "), falling back to grayscale");
                 // Fallback to grayscale processing if not enough planes
@@ -861,7 +1276,7 @@ public class Camera2Helper {
                 
                 if (rgbaData != null) {
                     latestFrameData = rgbaData;
-                    onFrameAvailable(rgbaData, frameWidth, frameHeight);
+                    onFrameAvailable(streamId, rgbaData, frameWidth, frameHeight, metadataForImage(image), sensorClockNowNs());
                 }
             }
         } catch (Exception e) {
@@ -869,75 +1284,6 @@ public class Camera2Helper {
         }
     }
     
-    // New full-color YUV to RGBA conversion
-    private byte[] convertYuvToRgba(byte[] yData, byte[] uData, byte[] vData, 
-                                   int width, int height,
-                                   int yRowStride, int uRowStride, int vRowStride,
-                                   int yPixelStride, int uPixelStride, int vPixelStride) {
-        
-        byte[] rgba = new byte[frameWidth * frameHeight * 4];
-        
-        try {
-            // YUV420 typically has U and V planes at half resolution
-            int uvHeight = height / 2;
-            int uvWidth = width / 2;
-            
-            Log.d(TAG, "YUV conversion - Full: " + width + "x" + height + 
-                  ", UV: " + uvWidth + "x" + uvHeight);
-            
-            for (int row = 0; row < frameHeight && row < height; row++) {
-                for (int col = 0; col < frameWidth && col < width; col++) {
-                    
-                    // Get Y value (full resolution)
-                    int yIndex = row * yRowStride + col * yPixelStride;
-                    int yValue = (yIndex < yData.length) ? (yData[yIndex] & 0xFF) : 128;
-                    
-                    // Get U and V values (half resolution, so divide by 2)
-                    int uvRow = row / 2;
-                    int uvCol = col / 2;
-                    int uIndex = uvRow * uRowStride + uvCol * uPixelStride;
-                    int vIndex = uvRow * vRowStride + uvCol * vPixelStride;
-                    
-                    int uValue = (uIndex < uData.length) ? (uData[uIndex] & 0xFF) : 128;
-                    int vValue = (vIndex < vData.length) ? (vData[vIndex] & 0xFF) : 128;
-                    
-                    // YUV to RGB conversion - try full range (0-255) first
-                    // Many modern cameras use full range YUV instead of limited range
-                    int y = yValue;
-                    int u = uValue - 128;
-                    int v = vValue - 128;
-                    
-                    // Apply conversion matrix (full range version)
-                    int r = (int)(y + 1.402f * v);
-                    int g = (int)(y - 0.344f * u - 0.714f * v);
-                    int b = (int)(y + 1.772f * u);
-                    
-                    // Clamp to 0-255 range
-                    r = Math.max(0, Math.min(255, r));
-                    g = Math.max(0, Math.min(255, g));
-                    b = Math.max(0, Math.min(255, b));
-                    
-                    // Set BGRA format for UE5
-                    int pixelIndex = (row * frameWidth + col) * 4;
-                    rgba[pixelIndex] = (byte)b;       // B
-                    rgba[pixelIndex + 1] = (byte)g;   // G
-                    rgba[pixelIndex + 2] = (byte)r;   // R
-                    rgba[pixelIndex + 3] = (byte)255; // A
-                }
-            }
-            
-            // Log first few RGB values for debugging
-            Log.d(TAG, "RGB conversion sample - R:" + (rgba[2] & 0xFF) + 
-                  " G:" + (rgba[1] & 0xFF) + " B:" + (rgba[0] & 0xFF));
-            
-            return rgba;
-            
-        } catch (Exception e) {
-            Log.e(TAG, "Error in YUV to RGBA conversion: " + e.getMessage());
-            return convertGrayscaleToRgba(yData, frameWidth, frameHeight);
-        }
-    }
-    
     // Legacy grayscale conversion method (renamed)
     private byte[] convertGrayscaleToRgba(byte[] yuv, int width, int height) {
         byte[] rgba = new byte[width * height * 4];
@@ -1006,6 +1352,7 @@ public class Camera2Helper {
     
     public void stopCamera() {
         isCapturing = false;
+        paused = false;
         
         if (captureSession != null) {
             captureSession.close();
@@ -1027,7 +1374,7 @@ public class Camera2Helper {
     }
     
     private void startBackgroundThread() {
-        backgroundThread = new HandlerThread("CameraBackground");
+        backgroundThread = new HandlerThread("CameraBackground-" + streamId);
         backgroundThread.start();
         backgroundHandler = new Handler(backgroundThread.getLooper());
     }
@@ -13,6 +13,8 @@ public class AndroidCamera2Plugin : ModuleRules
 				"CoreUObject",    // UObject、UTexture2D など
 				"Engine",         // UE 基本機能
 				"RenderCore",
+				"Media",          // IMediaPlayer for camera2:// URLs
+				"MediaUtils",     // FMediaSamples, sample pools
 				"InputCore",      // 入力機能
 				"ApplicationCore" // FAndroidApplication::GetJavaEnv() を含む
 			}
@@ -21,7 +23,7 @@ public class AndroidCamera2Plugin : ModuleRules
 		PrivateDependencyModuleNames.AddRange(
 			new string[]
 			{
-				// Keep it minimal for now
+				"HeadMountedDisplay" // IXRTrackingSystem for HMD pose history
 			}
 		);
 
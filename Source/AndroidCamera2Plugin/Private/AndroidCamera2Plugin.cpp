@@ -1,12 +1,36 @@
 ﻿// AndroidCamera2Plugin.cpp
 
 #include "Modules/ModuleManager.h"
+#include "Camera2HmdPoseSampler.h"
+#include "Camera2MediaPlayer.h"
+#include "IMediaModule.h"
 
 class FAndroidCamera2PluginModule : public IModuleInterface
 {
 public:
-	virtual void StartupModule() override {}
-	virtual void ShutdownModule() override {}
+	virtual void StartupModule() override
+	{
+		FCamera2HmdPoseSampler::Startup();
+
+		// camera2:// URLs for UMediaPlayer, media textures and Media Plates
+		if (IMediaModule* MediaModule = FModuleManager::LoadModulePtr<IMediaModule>("Media"))
+		{
+			MediaModule->RegisterPlayerFactory(MediaPlayerFactory);
+		}
+	}
+
+	virtual void ShutdownModule() override
+	{
+		if (IMediaModule* MediaModule = FModuleManager::GetModulePtr<IMediaModule>("Media"))
+		{
+			MediaModule->UnregisterPlayerFactory(MediaPlayerFactory);
+		}
+
+		FCamera2HmdPoseSampler::Shutdown();
+	}
+
+private:
+	FCamera2MediaPlayerFactory MediaPlayerFactory;
 };
 
 IMPLEMENT_MODULE(FAndroidCamera2PluginModule, AndroidCamera2Plugin);
@@ -0,0 +1,152 @@
+#include "Camera2ChangeDetector.h"
+#include "Camera2ImageConversion.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarCamera2ChangeEnable(
+    TEXT("Camera2.Change.Enable"),
+    0,
+    TEXT("Skip conversion, upload, mirror and pipeline work for frames that did not change since the last processed one."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarCamera2ChangeThreshold(
+    TEXT("Camera2.Change.Threshold"),
+    3.0f,
+    TEXT("Mean absolute luma difference (0-255) above which a tile counts as changed."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCamera2ChangeMaxSkip(
+    TEXT("Camera2.Change.MaxSkip"),
+    15,
+    TEXT("Unchanged frames skipped in a row before one is processed anyway."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCamera2ChangeGridStep(
+    TEXT("Camera2.Change.GridStep"),
+    8,
+    TEXT("Pixels per side of a change-detection grid cell."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCamera2ChangeTileCells(
+    TEXT("Camera2.Change.TileCells"),
+    8,
+    TEXT("Grid cells per side of a change-detection tile."),
+    ECVF_Default);
+
+bool FCamera2ChangeDetector::IsEnabled()
+{
+    return CVarCamera2ChangeEnable.GetValueOnAnyThread() != 0;
+}
+
+void FCamera2ChangeDetector::BuildGrid(const uint8* Luma, int32 Width, int32 Height, int32 RowStride, int32 PixelStride, int32 Step)
+{
+    GridSize = FIntPoint(Width / Step, Height / Step);
+    Grid.SetNumUninitialized(GridSize.X * GridSize.Y);
+    const int32 CellArea = Step * Step;
+
+    Camera2ImageConversion::ParallelForRowTiles(GridSize.Y, GridSize.X, RowStride * Step, [&](int32 RowBegin, int32 RowEnd)
+        {
+            for (int32 Row = RowBegin; Row < RowEnd; ++Row)
+            {
+                uint8* Out = Grid.GetData() + Row * GridSize.X;
+                for (int32 Col = 0; Col < GridSize.X; ++Col)
+                {
+                    int32 Sum = 0;
+                    for (int32 DY = 0; DY < Step; ++DY)
+                    {
+                        const uint8* Src = Luma + static_cast<int64>(Row * Step + DY) * RowStride + static_cast<int64>(Col * Step) * PixelStride;
+                        for (int32 DX = 0; DX < Step; ++DX)
+                        {
+                            Sum += Src[DX * PixelStride];
+                        }
+                    }
+                    Out[Col] = static_cast<uint8>((Sum + CellArea / 2) / CellArea);
+                }
+            }
+        });
+}
+
+bool FCamera2ChangeDetector::Evaluate(const uint8* Luma, int32 Width, int32 Height, int32 RowStride, int32 PixelStride)
+{
+    ++FramesEvaluated;
+
+    const int32 Step = FMath::Max(CVarCamera2ChangeGridStep.GetValueOnAnyThread(), 1);
+    if (!Luma || Width < Step || Height < Step)
+    {
+        LastScore = -1.0f;
+        return true;
+    }
+    BuildGrid(Luma, Width, Height, RowStride, PixelStride, Step);
+
+    if (bResetRequested.exchange(false) || GridSize != ReferenceGridSize)
+    {
+        Swap(Grid, ReferenceGrid);
+        ReferenceGridSize = GridSize;
+        SkippedInARow = 0;
+        LastScore = -1.0f;
+        return true;
+    }
+
+    // Sum of absolute differences per tile; the inner loop over one tile row is plain and contiguous
+    // so it vectorizes (SAD instructions on both SSE and NEON)
+    const int32 TileCells = FMath::Max(CVarCamera2ChangeTileCells.GetValueOnAnyThread(), 1);
+    TileCount = FIntPoint(FMath::DivideAndRoundUp(GridSize.X, TileCells), FMath::DivideAndRoundUp(GridSize.Y, TileCells));
+    TArray<uint32, TInlineAllocator<1024>> TileSums;
+    TileSums.SetNumZeroed(TileCount.X * TileCount.Y);
+
+    for (int32 Row = 0; Row < GridSize.Y; ++Row)
+    {
+        const uint8* Current = Grid.GetData() + Row * GridSize.X;
+        const uint8* Reference = ReferenceGrid.GetData() + Row * GridSize.X;
+        uint32* RowSums = TileSums.GetData() + (Row / TileCells) * TileCount.X;
+        for (int32 Tile = 0; Tile < TileCount.X; ++Tile)
+        {
+            const int32 Begin = Tile * TileCells;
+            const int32 End = FMath::Min(Begin + TileCells, GridSize.X);
+            uint32 Sum = 0;
+            for (int32 Col = Begin; Col < End; ++Col)
+            {
+                Sum += static_cast<uint32>(FMath::Abs(static_cast<int32>(Current[Col]) - static_cast<int32>(Reference[Col])));
+            }
+            RowSums[Tile] += Sum;
+        }
+    }
+
+    const float Threshold = CVarCamera2ChangeThreshold.GetValueOnAnyThread();
+    ChangedTiles.Init(false, TileSums.Num());
+    float MaxDifference = 0.0f;
+    for (int32 Index = 0; Index < TileSums.Num(); ++Index)
+    {
+        const int32 TileX = Index % TileCount.X;
+        const int32 TileY = Index / TileCount.X;
+        const int32 Cells = (FMath::Min((TileX + 1) * TileCells, GridSize.X) - TileX * TileCells)
+            * (FMath::Min((TileY + 1) * TileCells, GridSize.Y) - TileY * TileCells);
+        const float Difference = static_cast<float>(TileSums[Index]) / Cells;
+        MaxDifference = FMath::Max(MaxDifference, Difference);
+        ChangedTiles[Index] = Difference > Threshold;
+    }
+    LastScore = MaxDifference;
+
+    if (MaxDifference <= Threshold)
+    {
+        if (SkippedInARow < CVarCamera2ChangeMaxSkip.GetValueOnAnyThread())
+        {
+            ++SkippedInARow;
+            ++FramesSkipped;
+            return false;
+        }
+        ++FramesForced;
+    }
+
+    Swap(Grid, ReferenceGrid);
+    SkippedInARow = 0;
+    return true;
+}
+
+FCamera2ChangeDetector::FStats FCamera2ChangeDetector::GetStats() const
+{
+    FStats Stats;
+    Stats.FramesEvaluated = FramesEvaluated.load();
+    Stats.FramesSkipped = FramesSkipped.load();
+    Stats.FramesForced = FramesForced.load();
+    return Stats;
+}
@@ -0,0 +1,374 @@
+#include "Camera2CharacteristicsTable.h"
+
+int32 FCamera2CharacteristicsTable::GetTypeWidth(ECamera2CharacteristicType Type)
+{
+    switch (Type)
+    {
+    case ECamera2CharacteristicType::Rational:
+    case ECamera2CharacteristicType::Size:
+    case ECamera2CharacteristicType::SizeF:
+    case ECamera2CharacteristicType::IntRange:
+    case ECamera2CharacteristicType::FloatRange:
+        return 2;
+    case ECamera2CharacteristicType::Rect:
+        return 4;
+    default:
+        return 1;
+    }
+}
+
+bool FCamera2CharacteristicsTable::IsFloatType(ECamera2CharacteristicType Type)
+{
+    return Type == ECamera2CharacteristicType::Float || Type == ECamera2CharacteristicType::SizeF
+        || Type == ECamera2CharacteristicType::FloatRange;
+}
+
+int32 FCamera2CharacteristicsTable::Build(const TArray<FString>& Keys, TConstArrayView<int32> RawEntries, TArray<int64>&& InInts,
+    TArray<float>&& InFloats, TArray<FString>&& InStrings)
+{
+    constexpr int32 EntryFields = 4;
+
+    Ints = MoveTemp(InInts);
+    Floats = MoveTemp(InFloats);
+    Strings = MoveTemp(InStrings);
+    Names.Reset(Keys.Num());
+    Entries.Reset(Keys.Num());
+    KeyToEntry.Reset();
+    KeyToEntry.Reserve(Keys.Num());
+
+    const int32 NumKeys = FMath::Min(Keys.Num(), RawEntries.Num() / EntryFields);
+    for (int32 Index = 0; Index < NumKeys; ++Index)
+    {
+        const int32* Raw = RawEntries.GetData() + Index * EntryFields;
+        if (Raw[0] < 0 || Raw[0] >= static_cast<int32>(ECamera2CharacteristicType::Count) || Raw[2] < 0 || Raw[3] < 0)
+        {
+            continue;
+        }
+
+        FEntry Entry;
+        Entry.Type = static_cast<ECamera2CharacteristicType>(Raw[0]);
+        Entry.bArray = Raw[1] != 0;
+        Entry.Offset = Raw[2];
+        Entry.Count = Raw[3];
+
+        // A scalar is exactly one element (GetTypeWidth arena values); ToJson reads it without looking at
+        // Count, so an empty scalar would read past its arena
+        if (!Entry.bArray && Entry.Count != 1)
+        {
+            continue;
+        }
+
+        // Every value of the entry must lie inside its arena
+        const int64 End = Entry.Offset + static_cast<int64>(Entry.Count) * GetTypeWidth(Entry.Type);
+        const int32 ArenaSize = Entry.Type == ECamera2CharacteristicType::String ? Strings.Num()
+            : IsFloatType(Entry.Type) ? Floats.Num() : Ints.Num();
+        const FName Name(*Keys[Index]);
+        if (End > ArenaSize || KeyToEntry.Contains(Name))
+        {
+            continue;
+        }
+
+        KeyToEntry.Add(Name, Entries.Num());
+        Names.Add(Name);
+        Entries.Add(Entry);
+    }
+    return Entries.Num();
+}
+
+const FCamera2CharacteristicsTable::FEntry* FCamera2CharacteristicsTable::Find(FName Key) const
+{
+    const int32* Index = KeyToEntry.Find(Key);
+    return Index ? &Entries[*Index] : nullptr;
+}
+
+TArray<FName> FCamera2CharacteristicsTable::GetKeys() const
+{
+    return Names;
+}
+
+TConstArrayView<int64> FCamera2CharacteristicsTable::GetInts(FName Key) const
+{
+    const FEntry* Entry = Find(Key);
+    if (!Entry || Entry->Type == ECamera2CharacteristicType::String || IsFloatType(Entry->Type))
+    {
+        return {};
+    }
+    return TConstArrayView<int64>(Ints.GetData() + Entry->Offset, Entry->Count * GetTypeWidth(Entry->Type));
+}
+
+TConstArrayView<float> FCamera2CharacteristicsTable::GetFloats(FName Key) const
+{
+    const FEntry* Entry = Find(Key);
+    if (!Entry || !IsFloatType(Entry->Type))
+    {
+        return {};
+    }
+    return TConstArrayView<float>(Floats.GetData() + Entry->Offset, Entry->Count * GetTypeWidth(Entry->Type));
+}
+
+bool FCamera2CharacteristicsTable::GetInt(FName Key, int64& OutValue) const
+{
+    const FEntry* Entry = Find(Key);
+    if (!Entry || Entry->Count < 1
+        || (Entry->Type != ECamera2CharacteristicType::Int && Entry->Type != ECamera2CharacteristicType::Bool))
+    {
+        return false;
+    }
+    OutValue = Ints[Entry->Offset];
+    return true;
+}
+
+bool FCamera2CharacteristicsTable::GetFloat(FName Key, float& OutValue) const
+{
+    const FEntry* Entry = Find(Key);
+    if (!Entry || Entry->Count < 1)
+    {
+        return false;
+    }
+
+    switch (Entry->Type)
+    {
+    case ECamera2CharacteristicType::Float:
+        OutValue = Floats[Entry->Offset];
+        return true;
+    case ECamera2CharacteristicType::Int:
+    case ECamera2CharacteristicType::Bool:
+        OutValue = static_cast<float>(Ints[Entry->Offset]);
+        return true;
+    case ECamera2CharacteristicType::Rational:
+        OutValue = Ints[Entry->Offset + 1] != 0 ? static_cast<float>(static_cast<double>(Ints[Entry->Offset]) / Ints[Entry->Offset + 1]) : 0.0f;
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool FCamera2CharacteristicsTable::GetRational(FName Key, int64& OutNumerator, int64& OutDenominator) const
+{
+    const FEntry* Entry = Find(Key);
+    if (!Entry || Entry->Count < 1 || Entry->Type != ECamera2CharacteristicType::Rational)
+    {
+        return false;
+    }
+    OutNumerator = Ints[Entry->Offset];
+    OutDenominator = Ints[Entry->Offset + 1];
+    return true;
+}
+
+bool FCamera2CharacteristicsTable::GetSize(FName Key, FIntPoint& OutSize) const
+{
+    const FEntry* Entry = Find(Key);
+    if (!Entry || Entry->Count < 1 || Entry->Type != ECamera2CharacteristicType::Size)
+    {
+        return false;
+    }
+    OutSize = FIntPoint(static_cast<int32>(Ints[Entry->Offset]), static_cast<int32>(Ints[Entry->Offset + 1]));
+    return true;
+}
+
+bool FCamera2CharacteristicsTable::GetRect(FName Key, FIntRect& OutRect) const
+{
+    const FEntry* Entry = Find(Key);
+    if (!Entry || Entry->Count < 1 || Entry->Type != ECamera2CharacteristicType::Rect)
+    {
+        return false;
+    }
+    const int64* Value = Ints.GetData() + Entry->Offset;
+    OutRect = FIntRect(static_cast<int32>(Value[0]), static_cast<int32>(Value[1]), static_cast<int32>(Value[2]), static_cast<int32>(Value[3]));
+    return true;
+}
+
+bool FCamera2CharacteristicsTable::GetIntRange(FName Key, int64& OutLower, int64& OutUpper) const
+{
+    const FEntry* Entry = Find(Key);
+    if (!Entry || Entry->Count < 1 || Entry->Type != ECamera2CharacteristicType::IntRange)
+    {
+        return false;
+    }
+    OutLower = Ints[Entry->Offset];
+    OutUpper = Ints[Entry->Offset + 1];
+    return true;
+}
+
+bool FCamera2CharacteristicsTable::GetString(FName Key, FString& OutValue) const
+{
+    const FEntry* Entry = Find(Key);
+    if (!Entry || Entry->Count < 1 || Entry->Type != ECamera2CharacteristicType::String)
+    {
+        return false;
+    }
+    OutValue = Strings[Entry->Offset];
+    return true;
+}
+
+bool FCamera2CharacteristicsTable::GetFloatArray(FName Key, TArray<float>& OutValues) const
+{
+    OutValues.Reset();
+    const FEntry* Entry = Find(Key);
+    if (!Entry || Entry->Type == ECamera2CharacteristicType::String)
+    {
+        return false;
+    }
+
+    if (IsFloatType(Entry->Type))
+    {
+        const TConstArrayView<float> Values = GetFloats(Key);
+        OutValues.Append(Values.GetData(), Values.Num());
+    }
+    else if (Entry->Type == ECamera2CharacteristicType::Rational)
+    {
+        OutValues.Reserve(Entry->Count);
+        for (int32 Element = 0; Element < Entry->Count; ++Element)
+        {
+            const int64* Value = Ints.GetData() + Entry->Offset + Element * 2;
+            OutValues.Add(Value[1] != 0 ? static_cast<float>(static_cast<double>(Value[0]) / Value[1]) : 0.0f);
+        }
+    }
+    else
+    {
+        for (const int64 Value : GetInts(Key))
+        {
+            OutValues.Add(static_cast<float>(Value));
+        }
+    }
+    return true;
+}
+
+// =============================================================================
+// EXPORT
+// =============================================================================
+
+static void AppendJsonString(FString& Out, const FString& Value)
+{
+    Out.AppendChar(TEXT('"'));
+    for (const TCHAR Char : Value)
+    {
+        switch (Char)
+        {
+        case TEXT('"'): Out.Append(TEXT("\\\"")); break;
+        case TEXT('\\'): Out.Append(TEXT("\\\\")); break;
+        case TEXT('\n'): Out.Append(TEXT("\\n")); break;
+        case TEXT('\r'): Out.Append(TEXT("\\r")); break;
+        case TEXT('\t'): Out.Append(TEXT("\\t")); break;
+        default:
+            if (Char < 0x20)
+            {
+                Out.Appendf(TEXT("\\u%04x"), static_cast<uint32>(Char));
+            }
+            else
+            {
+                Out.AppendChar(Char);
+            }
+            break;
+        }
+    }
+    Out.AppendChar(TEXT('"'));
+}
+
+static void AppendJsonFloat(FString& Out, float Value)
+{
+    if (FMath::IsFinite(Value))
+    {
+        Out.Appendf(TEXT("%.9g"), Value);
+    }
+    else
+    {
+        Out.Append(TEXT("null"));
+    }
+}
+
+void FCamera2CharacteristicsTable::AppendJsonValue(FString& Out, const FEntry& Entry, int32 Element) const
+{
+    const int32 Offset = Entry.Offset + Element * GetTypeWidth(Entry.Type);
+    switch (Entry.Type)
+    {
+    case ECamera2CharacteristicType::Bool:
+        Out.Append(Ints[Offset] != 0 ? TEXT("true") : TEXT("false"));
+        break;
+    case ECamera2CharacteristicType::Int:
+        Out.Appendf(TEXT("%lld"), Ints[Offset]);
+        break;
+    case ECamera2CharacteristicType::Float:
+        AppendJsonFloat(Out, Floats[Offset]);
+        break;
+    case ECamera2CharacteristicType::Rational:
+        AppendJsonString(Out, FString::Printf(TEXT("%lld/%lld"), Ints[Offset], Ints[Offset + 1]));
+        break;
+    case ECamera2CharacteristicType::Size:
+        Out.Appendf(TEXT("{\"width\":%lld,\"height\":%lld}"), Ints[Offset], Ints[Offset + 1]);
+        break;
+    case ECamera2CharacteristicType::SizeF:
+        Out.Append(TEXT("{\"width\":"));
+        AppendJsonFloat(Out, Floats[Offset]);
+        Out.Append(TEXT(",\"height\":"));
+        AppendJsonFloat(Out, Floats[Offset + 1]);
+        Out.AppendChar(TEXT('}'));
+        break;
+    case ECamera2CharacteristicType::Rect:
+        Out.Appendf(TEXT("{\"left\":%lld,\"top\":%lld,\"right\":%lld,\"bottom\":%lld}"),
+            Ints[Offset], Ints[Offset + 1], Ints[Offset + 2], Ints[Offset + 3]);
+        break;
+    case ECamera2CharacteristicType::IntRange:
+        Out.Appendf(TEXT("{\"lower\":%lld,\"upper\":%lld}"), Ints[Offset], Ints[Offset + 1]);
+        break;
+    case ECamera2CharacteristicType::FloatRange:
+        Out.Append(TEXT("{\"lower\":"));
+        AppendJsonFloat(Out, Floats[Offset]);
+        Out.Append(TEXT(",\"upper\":"));
+        AppendJsonFloat(Out, Floats[Offset + 1]);
+        Out.AppendChar(TEXT('}'));
+        break;
+    default:
+        AppendJsonString(Out, Strings[Offset]);
+        break;
+    }
+}
+
+FString FCamera2CharacteristicsTable::ToJson() const
+{
+    FString Out;
+    Out.Reserve(Entries.Num() * 64 + Strings.Num() * 128);
+    Out.Append(TEXT("{\"cameraId\":"));
+    AppendJsonString(Out, CameraId);
+    Out.Appendf(TEXT(",\"sdk\":%d,\"values\":{"), SdkVersion);
+
+    for (int32 Index = 0; Index < Entries.Num(); ++Index)
+    {
+        const FEntry& Entry = Entries[Index];
+        if (Index > 0)
+        {
+            Out.AppendChar(TEXT(','));
+        }
+        AppendJsonString(Out, Names[Index].ToString());
+        Out.AppendChar(TEXT(':'));
+
+        if (!Entry.bArray)
+        {
+            AppendJsonValue(Out, Entry, 0);
+            continue;
+        }
+        Out.AppendChar(TEXT('['));
+        for (int32 Element = 0; Element < Entry.Count; ++Element)
+        {
+            if (Element > 0)
+            {
+                Out.AppendChar(TEXT(','));
+            }
+            AppendJsonValue(Out, Entry, Element);
+        }
+        Out.AppendChar(TEXT(']'));
+    }
+    Out.Append(TEXT("}}"));
+    return Out;
+}
+
+SIZE_T FCamera2CharacteristicsTable::GetAllocatedSize() const
+{
+    SIZE_T Size = Names.GetAllocatedSize() + Entries.GetAllocatedSize() + KeyToEntry.GetAllocatedSize()
+        + Ints.GetAllocatedSize() + Floats.GetAllocatedSize() + Strings.GetAllocatedSize() + CameraId.GetAllocatedSize();
+    for (const FString& String : Strings)
+    {
+        Size += String.GetAllocatedSize();
+    }
+    return Size;
+}
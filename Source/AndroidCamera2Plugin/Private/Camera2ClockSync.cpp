@@ -0,0 +1,344 @@
+#include "Camera2ClockSync.h"
+#include "SimpleCamera2Test.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+namespace Camera2ClockSyncConstants
+{
+    // Pairs needed before the mapping is reported as valid
+    constexpr int32 MinPairsForFit = 8;
+
+    // Rate is only estimated once the window spans enough sensor time; before that it is fixed at 1
+    constexpr int32 MinPairsForRate = 32;
+    constexpr double MinRateVarianceSeconds2 = 0.05;
+
+    // Real oscillators stay well inside this; anything larger means a bad fit
+    constexpr double MaxDriftPpm = 2000.0;
+
+    // Positive residuals (late pairs) beyond max(GateScale * scale, MinGate) are rejected
+    constexpr double GateScale = 4.0;
+    constexpr double MinGateSeconds = 0.0002;
+
+    // Negative residuals beyond this are not delay but a clock step
+    constexpr double MaxEarlySeconds = 0.05;
+
+    // Consecutive rejects that indicate a clock step rather than noise
+    constexpr int32 MaxConsecutiveRejects = 64;
+
+    constexpr double ResidualSmoothing = 0.05;
+
+    // Weight of a rejected pair in the scale, so a clock step still runs into MaxConsecutiveRejects
+    // (64 rejects widen the gate ~2.6x) while steady jitter settles with a few percent rejected
+    constexpr double RejectedResidualSmoothing = 0.005;
+}
+
+FCamera2ClockSync::FCamera2ClockSync(int32 InWindowSize)
+    : WindowSize(FMath::Max(InWindowSize, Camera2ClockSyncConstants::MinPairsForRate))
+{
+    Window.SetNumZeroed(WindowSize);
+}
+
+bool FCamera2ClockSync::AddObservation(int64 SensorNs, double EngineSeconds)
+{
+    using namespace Camera2ClockSyncConstants;
+
+    FScopeLock ScopeLock(&Lock);
+
+    if (Count == 0)
+    {
+        SensorRefNs = SensorNs;
+        EngineRef = EngineSeconds;
+    }
+
+    if (bHasFit)
+    {
+        const double X = static_cast<double>(SensorNs - SensorRefNs) * 1e-9;
+        const double Residual = (EngineSeconds - EngineRef) - (Intercept + Rate * X);
+        const double Gate = FMath::Max(GateScale * ResidualScale, MinGateSeconds);
+
+        if ((bGateArmed && Residual > Gate) || Residual < -MaxEarlySeconds)
+        {
+            ++Rejected;
+            if (bGateArmed)
+            {
+                ResidualScale += RejectedResidualSmoothing * (Gate - ResidualScale);
+            }
+            if (++ConsecutiveRejects > MaxConsecutiveRejects)
+            {
+                // The clocks stepped (suspend/resume, time source change); start over from this pair
+                ResetLocked();
+                ++Resets;
+                SensorRefNs = SensorNs;
+                EngineRef = EngineSeconds;
+            }
+            else
+            {
+                return false;
+            }
+        }
+        else if (bGateArmed)
+        {
+            ResidualScale += ResidualSmoothing * (FMath::Abs(Residual) - ResidualScale);
+        }
+    }
+
+    ConsecutiveRejects = 0;
+    ++Accepted;
+
+    if (Count == WindowSize)
+    {
+        // Evict the oldest pair, which lives where the next one goes
+        AddToSums(Window[Head], -1.0);
+    }
+    else
+    {
+        ++Count;
+    }
+
+    const FPair Pair{ SensorNs, EngineSeconds };
+    Window[Head] = Pair;
+    Head = (Head + 1) % WindowSize;
+    AddToSums(Pair, 1.0);
+
+    // Re-centre on recent data once per window so the sums never lose precision
+    if (++InsertsSinceRebase >= WindowSize)
+    {
+        Rebase();
+    }
+
+    Solve();
+
+    if (!bGateArmed && Count == WindowSize)
+    {
+        ArmGate();
+    }
+    return true;
+}
+
+void FCamera2ClockSync::ArmGate()
+{
+    using namespace Camera2ClockSyncConstants;
+
+    // Oldest first: the window is full, so the oldest pair is the one the next insert evicts
+    TArray<FPair> Pairs;
+    Pairs.Reserve(Count);
+    double SumAbsResidual = 0.0;
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        const FPair& Pair = Window[(Head + Index) % WindowSize];
+        const double X = static_cast<double>(Pair.SensorNs - SensorRefNs) * 1e-9;
+        SumAbsResidual += FMath::Abs((Pair.EngineSeconds - EngineRef) - (Intercept + Rate * X));
+        Pairs.Add(Pair);
+    }
+    ResidualScale = SumAbsResidual / Count;
+    bGateArmed = true;
+
+    // The warm-up fit runs through the middle of the jitter; drop the late pairs so it moves to the lower envelope
+    const double Gate = FMath::Max(GateScale * ResidualScale, MinGateSeconds);
+    Head = 0;
+    Count = 0;
+    for (const FPair& Pair : Pairs)
+    {
+        const double X = static_cast<double>(Pair.SensorNs - SensorRefNs) * 1e-9;
+        if ((Pair.EngineSeconds - EngineRef) - (Intercept + Rate * X) <= Gate)
+        {
+            Window[Count++] = Pair;
+        }
+    }
+    Head = Count % WindowSize;
+
+    // Count stays >= MinPairsForFit: at most a quarter of the pairs can lie past 4x their mean absolute residual
+    Rebase();
+    Solve();
+}
+
+void FCamera2ClockSync::AddToSums(const FPair& Pair, double Sign)
+{
+    const double X = static_cast<double>(Pair.SensorNs - SensorRefNs) * 1e-9;
+    const double Y = Pair.EngineSeconds - EngineRef;
+    SumX += Sign * X;
+    SumY += Sign * Y;
+    SumXX += Sign * X * X;
+    SumXY += Sign * X * Y;
+}
+
+void FCamera2ClockSync::Rebase()
+{
+    InsertsSinceRebase = 0;
+
+    const FPair& Newest = Window[(Head + WindowSize - 1) % WindowSize];
+    SensorRefNs = Newest.SensorNs;
+    EngineRef = Newest.EngineSeconds;
+
+    SumX = SumY = SumXX = SumXY = 0.0;
+    for (int32 Index = 0; Index < Count; ++Index)
+    {
+        AddToSums(Window[(Head + WindowSize - 1 - Index) % WindowSize], 1.0);
+    }
+}
+
+void FCamera2ClockSync::Solve()
+{
+    using namespace Camera2ClockSyncConstants;
+
+    const double N = static_cast<double>(Count);
+    const double MeanX = SumX / N;
+    const double MeanY = SumY / N;
+    const double VarX = SumXX / N - MeanX * MeanX;
+    const double CovXY = SumXY / N - MeanX * MeanY;
+
+    Rate = 1.0;
+    if (Count >= MinPairsForRate && VarX >= MinRateVarianceSeconds2)
+    {
+        const double Estimated = CovXY / VarX;
+        if (FMath::Abs(Estimated - 1.0) * 1e6 <= MaxDriftPpm)
+        {
+            Rate = Estimated;
+        }
+    }
+
+    Intercept = MeanY - Rate * MeanX;
+    bHasFit = Count >= MinPairsForFit;
+}
+
+bool FCamera2ClockSync::SensorToEngine(int64 SensorNs, double& OutEngineSeconds) const
+{
+    FScopeLock ScopeLock(&Lock);
+    if (!bHasFit)
+    {
+        return false;
+    }
+
+    const double X = static_cast<double>(SensorNs - SensorRefNs) * 1e-9;
+    OutEngineSeconds = EngineRef + Intercept + Rate * X;
+    return true;
+}
+
+bool FCamera2ClockSync::EngineToSensor(double EngineSeconds, int64& OutSensorNs) const
+{
+    FScopeLock ScopeLock(&Lock);
+    if (!bHasFit)
+    {
+        return false;
+    }
+
+    const double X = ((EngineSeconds - EngineRef) - Intercept) / Rate;
+    OutSensorNs = SensorRefNs + static_cast<int64>(FMath::RoundToDouble(X * 1e9));
+    return true;
+}
+
+bool FCamera2ClockSync::IsValid() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return bHasFit;
+}
+
+FCamera2ClockSync::FStats FCamera2ClockSync::GetStats() const
+{
+    FScopeLock ScopeLock(&Lock);
+
+    FStats Stats;
+    // Engine time at sensor time zero: EngineRef + Intercept + Rate * (0 - SensorRef)
+    Stats.OffsetSeconds = EngineRef + Intercept - Rate * static_cast<double>(SensorRefNs) * 1e-9;
+    Stats.DriftPpm = (Rate - 1.0) * 1e6;
+    Stats.ResidualSeconds = ResidualScale;
+    Stats.WindowCount = Count;
+    Stats.Accepted = Accepted;
+    Stats.Rejected = Rejected;
+    Stats.Resets = Resets;
+    return Stats;
+}
+
+void FCamera2ClockSync::Reset()
+{
+    FScopeLock ScopeLock(&Lock);
+    ResetLocked();
+    Accepted = 0;
+    Rejected = 0;
+    Resets = 0;
+}
+
+void FCamera2ClockSync::ResetLocked()
+{
+    Head = 0;
+    Count = 0;
+    InsertsSinceRebase = 0;
+    SumX = SumY = SumXX = SumXY = 0.0;
+    Intercept = 0.0;
+    Rate = 1.0;
+    bHasFit = false;
+    ResidualScale = 0.0;
+    bGateArmed = false;
+    ConsecutiveRejects = 0;
+}
+
+// =============================================================================
+// SELF TEST (synthetic clocks, no device needed)
+// =============================================================================
+
+static void RunClockSyncTest(int32 NumPairs, double DriftPpm)
+{
+    FCamera2ClockSync ClockSync;
+    FRandomStream Random(1234);
+
+    // Engine clock as a function of the sensor clock, before and after the sensor clock steps ahead
+    // (CLOCK_BOOTTIME keeps counting through a suspend that CLOCK_MONOTONIC skips)
+    const double OffsetSeconds = 1234.5;
+    const double Rate = 1.0 + DriftPpm * 1e-6;
+    const int64 StepNs = 2000000000;
+    int64 SensorNs = 1000000000000;
+    int64 SteppedNs = 0;
+
+    // Convergence allowance after the start and after the step (the fit restarts on the step)
+    const int32 SettlePairs = 900;
+    double MaxErrorSeconds[2] = { 0.0, 0.0 };
+    uint32 ResetsBeforeStep = 0;
+
+    for (int32 Index = 0; Index < 2 * NumPairs; ++Index)
+    {
+        const int32 Phase = Index < NumPairs ? 0 : 1;
+        if (Index == NumPairs)
+        {
+            ResetsBeforeStep = ClockSync.GetStats().Resets;
+            SteppedNs = StepNs;
+        }
+
+        // ~30 fps with frame-to-frame variation
+        SensorNs += static_cast<int64>(1e9 / 30.0 * Random.FRandRange(0.95f, 1.05f));
+        const double TrueEngine = OffsetSeconds + Rate * static_cast<double>(SensorNs - SteppedNs) * 1e-9;
+
+        // One-sided delay between the two clock reads: a floor, an exponential tail and occasional ms-level preemption
+        double Delay = 0.00005 - 0.0003 * FMath::Loge(1.0 - static_cast<double>(Random.GetFraction()) * 0.999999);
+        if (Random.GetFraction() < 0.05f)
+        {
+            Delay += Random.FRandRange(0.001f, 0.02f);
+        }
+        ClockSync.AddObservation(SensorNs, TrueEngine + Delay);
+
+        double Mapped = 0.0;
+        if (Index - Phase * NumPairs >= SettlePairs && ClockSync.SensorToEngine(SensorNs, Mapped))
+        {
+            MaxErrorSeconds[Phase] = FMath::Max(MaxErrorSeconds[Phase], FMath::Abs(Mapped - TrueEngine));
+        }
+    }
+
+    const FCamera2ClockSync::FStats Stats = ClockSync.GetStats();
+    const bool bAccurate = MaxErrorSeconds[0] < 0.001 && MaxErrorSeconds[1] < 0.001;
+    const bool bResetOnStep = ResetsBeforeStep == 0 && Stats.Resets == 1;
+    const bool bPassed = bAccurate && bResetOnStep;
+    UE_LOG(LogSimpleCamera2, Display,
+        TEXT("Clock sync test %s: %d pairs per phase, max error %.3f ms before / %.3f ms after the clock step, ")
+        TEXT("drift %.1f ppm (true %.1f), %llu accepted, %llu rejected, resets %u before the step, %u in total"),
+        bPassed ? TEXT("PASSED") : TEXT("FAILED"), NumPairs, MaxErrorSeconds[0] * 1000.0, MaxErrorSeconds[1] * 1000.0,
+        Stats.DriftPpm, DriftPpm, Stats.Accepted, Stats.Rejected, ResetsBeforeStep, Stats.Resets);
+}
+
+static FAutoConsoleCommand GCamera2ClockSyncTestCommand(
+    TEXT("Camera2.Clock.SyncTest"),
+    TEXT("Fit jittered synthetic clock pairs with drift and a clock step; checks sub-millisecond mapping error and one reset at the step. Args: [Pairs=3000] [DriftPpm=40]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const int32 NumPairs = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 3000;
+        const double DriftPpm = Args.Num() > 1 ? FCString::Atod(*Args[1]) : 40.0;
+        RunClockSyncTest(FMath::Max(NumPairs, 1200), FMath::Clamp(DriftPpm, -1000.0, 1000.0));
+    }));
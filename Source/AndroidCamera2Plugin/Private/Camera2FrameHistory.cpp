@@ -0,0 +1,230 @@
+#include "Camera2FrameHistory.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Count.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarCamera2HistoryMaxFrames(
+    TEXT("Camera2.History.MaxFrames"),
+    30,
+    TEXT("Frames kept in a stream's frame history."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCamera2HistoryBudgetMB(
+    TEXT("Camera2.History.BudgetMB"),
+    64,
+    TEXT("Pixel memory a stream's frame history may hold, in megabytes."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCamera2HistoryFormat(
+    TEXT("Camera2.History.Format"),
+    0,
+    TEXT("Format of frames recorded in the frame history: 0 = 8-bit luma, 1 = BGRA."),
+    ECVF_Default);
+
+FCamera2HistoryFrame::EFormat FCamera2FrameHistory::GetFormat()
+{
+    return CVarCamera2HistoryFormat.GetValueOnAnyThread() == 1 ? FCamera2HistoryFrame::EFormat::Bgra : FCamera2HistoryFrame::EFormat::Luma;
+}
+
+FCamera2HistoryFrame* FCamera2FrameHistory::BeginRecord(FCamera2HistoryFrame::EFormat Format, int32 Width, int32 Height,
+    const FCamera2FrameMetadata& Metadata)
+{
+    check(!Recording.IsValid());
+
+    const int32 BytesPerPixel = Format == FCamera2HistoryFrame::EFormat::Bgra ? 4 : 1;
+    const int64 Bytes = static_cast<int64>(Width) * Height * BytesPerPixel;
+    const int32 MaxFrames = CVarCamera2HistoryMaxFrames.GetValueOnAnyThread();
+    const int64 Budget = static_cast<int64>(FMath::Max(CVarCamera2HistoryBudgetMB.GetValueOnAnyThread(), 0)) * 1024 * 1024;
+
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (Bytes <= 0 || Bytes > Budget || MaxFrames < 1)
+        {
+            ++Counters.FramesRejected;
+            return nullptr;
+        }
+
+        // Evict oldest first; a frame only the history references is not pinned. Readers only copy
+        // pointers under the lock, so an unpinned frame cannot become pinned while we hold it.
+        while (Frames.Num() >= MaxFrames || BytesInUse + Bytes > Budget)
+        {
+            const int32 Index = Frames.IndexOfByPredicate([](const FMutableFramePtr& Frame)
+                {
+                    return Frame.GetSharedReferenceCount() == 1;
+                });
+            if (Index == INDEX_NONE)
+            {
+                Recording.Reset();
+                ++Counters.FramesRejected;
+                return nullptr;
+            }
+
+            BytesInUse -= Frames[Index]->GetSizeBytes();
+            if (!Recording.IsValid())
+            {
+                Recording = MoveTemp(Frames[Index]);
+            }
+            Frames.RemoveAt(Index, 1, EAllowShrinking::No);
+            ++Counters.FramesEvicted;
+        }
+        BytesInUse += Bytes;
+        Counters.BuffersReused += Recording.IsValid() ? 1 : 0;
+    }
+
+    // Filled outside the lock; nobody else can see this frame yet
+    if (!Recording.IsValid())
+    {
+        Recording = MakeShared<FCamera2HistoryFrame, ESPMode::ThreadSafe>();
+    }
+    Recording->Metadata = Metadata;
+    Recording->Format = Format;
+    Recording->Width = Width;
+    Recording->Height = Height;
+    Recording->Pixels.SetNumUninitialized(Bytes, EAllowShrinking::No);
+    return Recording.Get();
+}
+
+void FCamera2FrameHistory::EndRecord()
+{
+    FScopeLock ScopeLock(&Lock);
+    Frames.Add(MoveTemp(Recording));
+    ++Counters.FramesRecorded;
+}
+
+bool FCamera2FrameHistory::RecordLuma(const uint8* Luma, int32 Width, int32 Height, int32 RowStride, int32 PixelStride,
+    const FCamera2FrameMetadata& Metadata)
+{
+    FCamera2HistoryFrame* Frame = Luma ? BeginRecord(FCamera2HistoryFrame::EFormat::Luma, Width, Height, Metadata) : nullptr;
+    if (!Frame)
+    {
+        return false;
+    }
+
+    uint8* Dst = Frame->Pixels.GetData();
+    for (int32 Row = 0; Row < Height; ++Row, Dst += Width)
+    {
+        const uint8* Src = Luma + static_cast<int64>(Row) * RowStride;
+        if (PixelStride == 1)
+        {
+            FMemory::Memcpy(Dst, Src, Width);
+            continue;
+        }
+        for (int32 X = 0; X < Width; ++X)
+        {
+            Dst[X] = Src[X * PixelStride];
+        }
+    }
+    EndRecord();
+    return true;
+}
+
+bool FCamera2FrameHistory::RecordBgra(const uint8* Bgra, int32 Width, int32 Height, const FCamera2FrameMetadata& Metadata)
+{
+    FCamera2HistoryFrame* Frame = Bgra ? BeginRecord(FCamera2HistoryFrame::EFormat::Bgra, Width, Height, Metadata) : nullptr;
+    if (!Frame)
+    {
+        return false;
+    }
+
+    FMemory::Memcpy(Frame->Pixels.GetData(), Bgra, Frame->Pixels.Num());
+    EndRecord();
+    return true;
+}
+
+bool FCamera2FrameHistory::RecordYuv(const FCamera2YuvPlanes& Planes, const FCamera2FrameMetadata& Metadata)
+{
+    FCamera2HistoryFrame* Frame = BeginRecord(FCamera2HistoryFrame::EFormat::Bgra, Planes.Width, Planes.Height, Metadata);
+    if (!Frame)
+    {
+        return false;
+    }
+
+    Camera2ImageConversion::ConvertYuvToBgra(Planes, Frame->Pixels.GetData(), Planes.Width * 4);
+    EndRecord();
+    return true;
+}
+
+// =============================================================================
+// LOOKUP
+// =============================================================================
+
+FCamera2FrameHistory::FFramePtr FCamera2FrameHistory::FindBySequence(int64 FrameSequence) const
+{
+    FScopeLock ScopeLock(&Lock);
+    const int32 Index = Algo::BinarySearchBy(Frames, FrameSequence, [](const FMutableFramePtr& Frame)
+        {
+            return Frame->Metadata.FrameSequence;
+        });
+    return Index != INDEX_NONE ? FFramePtr(Frames[Index]) : nullptr;
+}
+
+template <typename KeyType, typename ProjectionType>
+FCamera2FrameHistory::FFramePtr FCamera2FrameHistory::FindNearest(KeyType Key, KeyType MaxDelta, ProjectionType Projection) const
+{
+    if (Frames.Num() == 0)
+    {
+        return nullptr;
+    }
+
+    // First frame at or after Key; the nearest is it or the one before
+    const int32 After = Algo::LowerBoundBy(Frames, Key, Projection);
+    int32 Best = FMath::Min(After, Frames.Num() - 1);
+    if (After > 0 && (After == Frames.Num() || Key - Projection(Frames[After - 1]) <= Projection(Frames[After]) - Key))
+    {
+        Best = After - 1;
+    }
+
+    if (MaxDelta > KeyType(0) && FMath::Abs(Projection(Frames[Best]) - Key) > MaxDelta)
+    {
+        return nullptr;
+    }
+    return Frames[Best];
+}
+
+FCamera2FrameHistory::FFramePtr FCamera2FrameHistory::FindNearestSensorTime(int64 SensorTimestampNs, int64 MaxDeltaNs) const
+{
+    FScopeLock ScopeLock(&Lock);
+    return FindNearest(SensorTimestampNs, MaxDeltaNs, [](const FMutableFramePtr& Frame)
+        {
+            return Frame->Metadata.SensorTimestampNs;
+        });
+}
+
+FCamera2FrameHistory::FFramePtr FCamera2FrameHistory::FindNearestEngineTime(double EngineTime, double MaxDeltaSeconds) const
+{
+    FScopeLock ScopeLock(&Lock);
+    return FindNearest(EngineTime, MaxDeltaSeconds, [](const FMutableFramePtr& Frame)
+        {
+            return Frame->Metadata.EngineTimestamp;
+        });
+}
+
+FCamera2FrameHistory::FFramePtr FCamera2FrameHistory::GetLatest() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Frames.Num() > 0 ? FFramePtr(Frames.Last()) : nullptr;
+}
+
+void FCamera2FrameHistory::Reset()
+{
+    FScopeLock ScopeLock(&Lock);
+    for (const FMutableFramePtr& Frame : Frames)
+    {
+        BytesInUse -= Frame->GetSizeBytes();
+    }
+    Frames.Reset();
+}
+
+FCamera2FrameHistory::FStats FCamera2FrameHistory::GetStats() const
+{
+    FScopeLock ScopeLock(&Lock);
+    FStats Stats = Counters;
+    Stats.NumFrames = Frames.Num();
+    Stats.NumPinned = Algo::CountIf(Frames, [](const FMutableFramePtr& Frame)
+        {
+            return Frame.GetSharedReferenceCount() > 1;
+        });
+    Stats.BytesInUse = BytesInUse;
+    Stats.ByteBudget = static_cast<int64>(FMath::Max(CVarCamera2HistoryBudgetMB.GetValueOnAnyThread(), 0)) * 1024 * 1024;
+    return Stats;
+}
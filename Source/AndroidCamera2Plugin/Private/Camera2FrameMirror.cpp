@@ -0,0 +1,220 @@
+#include "Camera2FrameMirror.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<int32> CVarCamera2MirrorDownsample(
+    TEXT("Camera2.Mirror.Downsample"),
+    2,
+    TEXT("Integer downsample factor of the CPU frame mirror used by Blueprint pixel queries (1 = full resolution)."),
+    ECVF_Default);
+
+// Luma sums of up to 4096 x 4096 mirror pixels fit in uint32
+static constexpr int32 MaxMirrorPixels = 4096 * 4096;
+
+// Row prefix sums, then the row above added four lanes at a time
+static void BuildSummedAreaTable(const uint8* Luma, int32 Width, int32 Height, TArray<uint32>& OutTable)
+{
+    const int32 Stride = Width + 1;
+    OutTable.SetNumUninitialized(Stride * (Height + 1));
+    FMemory::Memzero(OutTable.GetData(), Stride * sizeof(uint32));
+
+    for (int32 Y = 0; Y < Height; ++Y)
+    {
+        const uint32* Above = OutTable.GetData() + static_cast<int64>(Y) * Stride;
+        uint32* Row = OutTable.GetData() + static_cast<int64>(Y + 1) * Stride;
+        const uint8* Src = Luma + static_cast<int64>(Y) * Width;
+
+        uint32 Running = 0;
+        Row[0] = 0;
+        for (int32 X = 0; X < Width; ++X)
+        {
+            Running += Src[X];
+            Row[X + 1] = Running;
+        }
+
+        int32 X = 1;
+        for (; X + 4 <= Stride; X += 4)
+        {
+            VectorIntStore(VectorIntAdd(VectorIntLoad(Row + X), VectorIntLoad(Above + X)), Row + X);
+        }
+        for (; X < Stride; ++X)
+        {
+            Row[X] += Above[X];
+        }
+    }
+}
+
+// =============================================================================
+// MIRROR FRAME
+// =============================================================================
+
+bool FCamera2MirrorFrame::ToMirrorRect(const FIntRect& StreamRect, FIntRect& OutRect) const
+{
+    if (StreamRect.Max.X <= FMath::Max(StreamRect.Min.X, 0) || StreamRect.Max.Y <= FMath::Max(StreamRect.Min.Y, 0)
+        || StreamRect.Min.X >= Width * Downsample || StreamRect.Min.Y >= Height * Downsample)
+    {
+        return false;
+    }
+
+    // A mirror pixel counts if its block starts inside the rectangle; tiny rectangles keep one pixel
+    const int32 MinX = FMath::Clamp(FMath::DivideAndRoundUp(StreamRect.Min.X, Downsample), 0, Width);
+    const int32 MinY = FMath::Clamp(FMath::DivideAndRoundUp(StreamRect.Min.Y, Downsample), 0, Height);
+    const int32 MaxX = FMath::Clamp(FMath::DivideAndRoundUp(StreamRect.Max.X, Downsample), 0, Width);
+    const int32 MaxY = FMath::Clamp(FMath::DivideAndRoundUp(StreamRect.Max.Y, Downsample), 0, Height);
+    OutRect = FIntRect(FMath::Min(MinX, FMath::Max(MaxX - 1, 0)), FMath::Min(MinY, FMath::Max(MaxY - 1, 0)), MaxX, MaxY);
+    return OutRect.Area() > 0;
+}
+
+bool FCamera2MirrorFrame::GetPixelAt(FIntPoint StreamPixel, FColor& OutColor) const
+{
+    const int32 X = StreamPixel.X / Downsample;
+    const int32 Y = StreamPixel.Y / Downsample;
+    if (StreamPixel.X < 0 || StreamPixel.Y < 0 || X >= Width || Y >= Height)
+    {
+        return false;
+    }
+    OutColor = Pixels[Y * Width + X];
+    return true;
+}
+
+bool FCamera2MirrorFrame::GetMeanLuminance(const FIntRect& StreamRect, float& OutMean) const
+{
+    FIntRect Rect;
+    if (!ToMirrorRect(StreamRect, Rect))
+    {
+        return false;
+    }
+
+    const int32 Stride = Width + 1;
+    const uint32 Sum = LumaSAT[Rect.Max.Y * Stride + Rect.Max.X] - LumaSAT[Rect.Min.Y * Stride + Rect.Max.X]
+        - LumaSAT[Rect.Max.Y * Stride + Rect.Min.X] + LumaSAT[Rect.Min.Y * Stride + Rect.Min.X];
+    OutMean = static_cast<float>(Sum) / static_cast<float>(Rect.Area());
+    return true;
+}
+
+bool FCamera2MirrorFrame::GetHistogram(const FIntRect& StreamRect, int32 NumBins, TArray<int32>& OutBins) const
+{
+    NumBins = FMath::Clamp(NumBins, 1, 256);
+    FIntRect Rect;
+    if (!ToMirrorRect(StreamRect, Rect))
+    {
+        OutBins.Reset();
+        return false;
+    }
+
+    int32 Counts[256] = {};
+    for (int32 Y = Rect.Min.Y; Y < Rect.Max.Y; ++Y)
+    {
+        const uint8* Row = Luma.GetData() + Y * Width;
+        for (int32 X = Rect.Min.X; X < Rect.Max.X; ++X)
+        {
+            ++Counts[Row[X]];
+        }
+    }
+
+    OutBins.SetNumZeroed(NumBins);
+    for (int32 Value = 0; Value < 256; ++Value)
+    {
+        OutBins[Value * NumBins / 256] += Counts[Value];
+    }
+    return true;
+}
+
+// =============================================================================
+// MIRROR
+// =============================================================================
+
+int32 FCamera2FrameMirror::GetDownsample()
+{
+    return FMath::Max(CVarCamera2MirrorDownsample.GetValueOnAnyThread(), 1);
+}
+
+FCamera2MirrorFrame& FCamera2FrameMirror::BeginUpdate(int32 SourceWidth, int32 SourceHeight, const FCamera2FrameMetadata& Metadata)
+{
+    // A reader may still hold the frame published two updates ago
+    if (!Back.IsValid() || Back.GetSharedReferenceCount() > 1)
+    {
+        Back = MakeShared<FCamera2MirrorFrame, ESPMode::ThreadSafe>();
+    }
+
+    int32 Downsample = GetDownsample();
+    while (static_cast<int64>(SourceWidth / Downsample) * (SourceHeight / Downsample) > MaxMirrorPixels)
+    {
+        ++Downsample;
+    }
+
+    FCamera2MirrorFrame& Frame = *Back;
+    Frame.Metadata = Metadata;
+    Frame.SourceSize = FIntPoint(SourceWidth, SourceHeight);
+    Frame.Downsample = Downsample;
+    Frame.Width = SourceWidth / Downsample;
+    Frame.Height = SourceHeight / Downsample;
+    Frame.Pixels.SetNumUninitialized(Frame.Width * Frame.Height);
+    Frame.Luma.SetNumUninitialized(Frame.Width * Frame.Height);
+    return Frame;
+}
+
+void FCamera2FrameMirror::Publish()
+{
+    BuildSummedAreaTable(Back->Luma.GetData(), Back->Width, Back->Height, Back->LumaSAT);
+
+    FScopeLock ScopeLock(&Lock);
+    Swap(Front, Back);
+}
+
+void FCamera2FrameMirror::UpdateFromYuv(const FCamera2YuvPlanes& Planes, const FCamera2FrameMetadata& Metadata)
+{
+    FCamera2MirrorFrame& Frame = BeginUpdate(Planes.Width, Planes.Height, Metadata);
+    Camera2ImageConversion::DownsampleYuv(Planes, Frame.Downsample,
+        reinterpret_cast<uint8*>(Frame.Pixels.GetData()), Frame.Luma.GetData());
+    Publish();
+}
+
+void FCamera2FrameMirror::UpdateFromBgra(const uint8* Bgra, int32 InWidth, int32 InHeight, const FCamera2FrameMetadata& Metadata)
+{
+    FCamera2MirrorFrame& Frame = BeginUpdate(InWidth, InHeight, Metadata);
+    const int32 Factor = Frame.Downsample;
+    const int32 BlockArea = Factor * Factor;
+
+    Camera2ImageConversion::ParallelForRowTiles(Frame.Height, Frame.Width, Frame.Width * 4, [&](int32 RowBegin, int32 RowEnd)
+        {
+            for (int32 Row = RowBegin; Row < RowEnd; ++Row)
+            {
+                for (int32 Col = 0; Col < Frame.Width; ++Col)
+                {
+                    int32 Sum[3] = {};
+                    for (int32 DY = 0; DY < Factor; ++DY)
+                    {
+                        const uint8* Src = Bgra + (static_cast<int64>(Row * Factor + DY) * InWidth + Col * Factor) * 4;
+                        for (int32 DX = 0; DX < Factor; ++DX, Src += 4)
+                        {
+                            Sum[0] += Src[0];
+                            Sum[1] += Src[1];
+                            Sum[2] += Src[2];
+                        }
+                    }
+
+                    const int32 Index = Row * Frame.Width + Col;
+                    const FColor Color(
+                        static_cast<uint8>((Sum[2] + BlockArea / 2) / BlockArea),
+                        static_cast<uint8>((Sum[1] + BlockArea / 2) / BlockArea),
+                        static_cast<uint8>((Sum[0] + BlockArea / 2) / BlockArea));
+                    Frame.Pixels[Index] = Color;
+                    // BT.601 luma
+                    Frame.Luma[Index] = static_cast<uint8>((77 * Color.R + 150 * Color.G + 29 * Color.B + 128) >> 8);
+                }
+            }
+        });
+    Publish();
+}
+
+FCamera2FrameMirror::FFramePtr FCamera2FrameMirror::GetLatest() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Front;
+}
+
+void FCamera2FrameMirror::Reset()
+{
+    FScopeLock ScopeLock(&Lock);
+    Front.Reset();
+}
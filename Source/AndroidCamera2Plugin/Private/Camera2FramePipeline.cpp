@@ -0,0 +1,649 @@
+#include "Camera2FramePipeline.h"
+#include "Camera2ImageConversion.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+static TAutoConsoleVariable<float> CVarCamera2StatsMinSharpness(
+    TEXT("Camera2.Stats.MinSharpness"),
+    0.0f,
+    TEXT("Frames with a lower Laplacian-variance sharpness are skipped by stages gated on IsFrameUsable (0 = no limit)."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarCamera2StatsMinMeanLuma(
+    TEXT("Camera2.Stats.MinMeanLuma"),
+    0.0f,
+    TEXT("Frames darker than this mean luma (0-255) are skipped by stages gated on IsFrameUsable."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarCamera2StatsMaxMeanLuma(
+    TEXT("Camera2.Stats.MaxMeanLuma"),
+    255.0f,
+    TEXT("Frames brighter than this mean luma (0-255) are skipped by stages gated on IsFrameUsable."),
+    ECVF_Default);
+
+static void AtomicMax(std::atomic<int64>& Target, int64 Value)
+{
+    int64 Current = Target.load(std::memory_order_relaxed);
+    while (Value > Current && !Target.compare_exchange_weak(Current, Value, std::memory_order_relaxed))
+    {
+    }
+}
+
+static int64 SecondsToNs(double Seconds)
+{
+    return static_cast<int64>(Seconds * 1e9);
+}
+
+// =============================================================================
+// PIPELINE
+// =============================================================================
+
+FCamera2FramePipeline::FCamera2FramePipeline(int32 InMaxInFlight)
+    : MaxInFlight(FMath::Max(InMaxInFlight, 1))
+{
+    FrameFreedEvent = FPlatformProcess::GetSynchEventFromPool(false);
+}
+
+FCamera2FramePipeline::~FCamera2FramePipeline()
+{
+    Flush();
+    FPlatformProcess::ReturnSynchEventToPool(FrameFreedEvent);
+    FrameFreedEvent = nullptr;
+}
+
+void FCamera2FramePipeline::AddStage(FCamera2PipelineStageDesc Stage)
+{
+    check(!bFinalized);
+    TUniquePtr<FStage> NewStage = MakeUnique<FStage>();
+    NewStage->Desc = MoveTemp(Stage);
+    Stages.Add(MoveTemp(NewStage));
+}
+
+int32 FCamera2FramePipeline::FindOrAddSlot(FName Name)
+{
+    int32 Index = SlotNames.IndexOfByKey(Name);
+    if (Index == INDEX_NONE)
+    {
+        Index = SlotNames.Add(Name);
+        SlotProducer.Add(INDEX_NONE);
+    }
+    return Index;
+}
+
+bool FCamera2FramePipeline::Finalize()
+{
+    check(!bFinalized);
+
+    // Outputs first so an input can tell a later producer (ordering error) from a source slot
+    for (int32 StageIndex = 0; StageIndex < Stages.Num(); ++StageIndex)
+    {
+        FStage& Stage = *Stages[StageIndex];
+        for (const FName& Output : Stage.Desc.Outputs)
+        {
+            const int32 Slot = FindOrAddSlot(Output);
+            if (SlotProducer[Slot] != INDEX_NONE)
+            {
+                UE_LOG(LogSimpleCamera2, Error, TEXT("Pipeline: '%s' is produced by both '%s' and '%s'"),
+                    *Output.ToString(), *Stages[SlotProducer[Slot]]->Desc.Name.ToString(), *Stage.Desc.Name.ToString());
+                return false;
+            }
+            SlotProducer[Slot] = StageIndex;
+            Stage.OutputSlots.Add(Slot);
+        }
+    }
+
+    for (int32 StageIndex = 0; StageIndex < Stages.Num(); ++StageIndex)
+    {
+        FStage& Stage = *Stages[StageIndex];
+        for (const FName& Input : Stage.Desc.Inputs)
+        {
+            const int32 Slot = FindOrAddSlot(Input);
+            const int32 Producer = SlotProducer[Slot];
+            if (Producer == StageIndex || Producer > StageIndex)
+            {
+                UE_LOG(LogSimpleCamera2, Error, TEXT("Pipeline: stage '%s' reads '%s' before it is produced"),
+                    *Stage.Desc.Name.ToString(), *Input.ToString());
+                return false;
+            }
+            if (Producer == INDEX_NONE)
+            {
+                if (!SourceSlots.Contains(Slot))
+                {
+                    SourceSlots.Add(Slot);
+                    SourceSlotNames.Add(Input);
+                }
+            }
+            else
+            {
+                Stage.Producers.AddUnique(Producer);
+            }
+            Stage.InputSlots.Add(Slot);
+        }
+    }
+
+    FramePool.Reserve(MaxInFlight);
+    for (int32 Index = 0; Index < MaxInFlight; ++Index)
+    {
+        TUniquePtr<FFrameState> Frame = MakeUnique<FFrameState>();
+        Frame->Slots.SetNum(SlotNames.Num());
+        Frame->StageTasks.SetNum(Stages.Num());
+        FreeFrames.Add(Frame.Get());
+        FramePool.Add(MoveTemp(Frame));
+    }
+    LastStageTasks.SetNum(Stages.Num());
+
+    bFinalized = true;
+    UE_LOG(LogSimpleCamera2, Log, TEXT("Pipeline finalized: %d stages, %d slots (%d source), %d frames in flight"),
+        Stages.Num(), SlotNames.Num(), SourceSlots.Num(), MaxInFlight);
+    return true;
+}
+
+bool FCamera2FramePipeline::Submit(TFunctionRef<void(FCamera2FrameMetadata&, TArrayView<FCamera2PipelineBuffer*>)> Fill,
+    bool bWaitForSlot)
+{
+    check(bFinalized);
+    FScopeLock SubmitScope(&SubmitLock);
+
+    FFrameState* Frame = nullptr;
+    while (!Frame)
+    {
+        {
+            FScopeLock FreeScope(&FreeFramesLock);
+            if (FreeFrames.Num() > 0)
+            {
+                Frame = FreeFrames.Pop(EAllowShrinking::No);
+                break;
+            }
+        }
+        if (!bWaitForSlot)
+        {
+            ++Dropped;
+            return false;
+        }
+        FrameFreedEvent->Wait();
+    }
+
+    Frame->FrameIndex = NextFrameIndex++;
+    Frame->SubmitTime = FPlatformTime::Seconds();
+    Frame->bAbandoned = false;
+    Frame->bAnySkipped = false;
+    for (FCamera2PipelineBuffer& Slot : Frame->Slots)
+    {
+        Slot.bValid = false;
+    }
+
+    TArray<FCamera2PipelineBuffer*, TInlineAllocator<4>> Sources;
+    for (const int32 Slot : SourceSlots)
+    {
+        Sources.Add(&Frame->Slots[Slot]);
+    }
+    Frame->Metadata = FCamera2FrameMetadata();
+    Fill(Frame->Metadata, Sources);
+    for (FCamera2PipelineBuffer* Source : Sources)
+    {
+        Source->bValid = Source->Data.Num() > 0;
+    }
+
+    ++InFlight;
+    ++Submitted;
+    LatestSubmittedIndex.store(Frame->FrameIndex);
+
+    // Stages are declared producers-first, so every producer task exists by the time a consumer launches
+    for (int32 StageIndex = 0; StageIndex < Stages.Num(); ++StageIndex)
+    {
+        TArray<UE::Tasks::FTask, TInlineAllocator<4>> Prerequisites;
+        for (const int32 Producer : Stages[StageIndex]->Producers)
+        {
+            Prerequisites.Add(Frame->StageTasks[Producer]);
+        }
+        if (LastStageTasks[StageIndex].IsValid())
+        {
+            Prerequisites.Add(LastStageTasks[StageIndex]);
+        }
+
+        Frame->StageTasks[StageIndex] = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+            [this, StageIndex, Frame]() { RunStage(StageIndex, *Frame); },
+            Prerequisites);
+        LastStageTasks[StageIndex] = Frame->StageTasks[StageIndex];
+    }
+
+    UE::Tasks::FTask Done = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+        [this, Frame]() { CompleteFrame(*Frame); },
+        Frame->StageTasks);
+
+    FrameDoneTasks.RemoveAllSwap([](const UE::Tasks::FTask& Task) { return Task.IsCompleted(); });
+    FrameDoneTasks.Add(MoveTemp(Done));
+    return true;
+}
+
+void FCamera2FramePipeline::RunStage(int32 StageIndex, FFrameState& Frame)
+{
+    FStage& Stage = *Stages[StageIndex];
+
+    bool bInputsValid = !Frame.bAbandoned.load();
+    for (const int32 Slot : Stage.InputSlots)
+    {
+        bInputsValid &= Frame.Slots[Slot].bValid;
+    }
+
+    // A newer frame is already queued behind this one: let it have the stage instead
+    const bool bBehind = Stage.Desc.bSkipWhenBehind && LatestSubmittedIndex.load() > Frame.FrameIndex;
+    const bool bRejected = Stage.Desc.ShouldRun && !Stage.Desc.ShouldRun(Frame.Metadata);
+    const bool bShed = Stage.Desc.bOptional && bSkipOptionalStages.load();
+
+    if (!bInputsValid || bBehind || bRejected || bShed)
+    {
+        ++Stage.Skipped;
+        Frame.bAnySkipped = true;
+        return;
+    }
+
+    FCamera2StageContext Context;
+    Context.FrameIndex = Frame.FrameIndex;
+    Context.Metadata = &Frame.Metadata;
+    for (const int32 Slot : Stage.InputSlots)
+    {
+        Context.Inputs.Add(&Frame.Slots[Slot]);
+    }
+    for (const int32 Slot : Stage.OutputSlots)
+    {
+        Context.Outputs.Add(&Frame.Slots[Slot]);
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    const bool bSucceeded = Stage.Desc.Work(Context);
+    const int64 ElapsedNs = SecondsToNs(FPlatformTime::Seconds() - StartTime);
+
+    ++Stage.Runs;
+    Stage.TotalNs += ElapsedNs;
+    AtomicMax(Stage.MaxNs, ElapsedNs);
+
+    if (bSucceeded)
+    {
+        for (FCamera2PipelineBuffer* Output : Context.Outputs)
+        {
+            Output->bValid = true;
+        }
+    }
+    else
+    {
+        Frame.bAbandoned = true;
+    }
+}
+
+void FCamera2FramePipeline::CompleteFrame(FFrameState& Frame)
+{
+    const int64 LatencyNs = SecondsToNs(FPlatformTime::Seconds() - Frame.SubmitTime);
+    TotalLatencyNs += LatencyNs;
+    AtomicMax(MaxLatencyNs, LatencyNs);
+    ++Completed;
+
+    OnFrameCompleted.Broadcast(Frame.FrameIndex, !Frame.bAbandoned.load() && !Frame.bAnySkipped.load());
+
+    {
+        FScopeLock FreeScope(&FreeFramesLock);
+        FreeFrames.Add(&Frame);
+    }
+    --InFlight;
+    FrameFreedEvent->Trigger();
+}
+
+void FCamera2FramePipeline::Flush()
+{
+    TArray<UE::Tasks::FTask> Pending;
+    {
+        FScopeLock SubmitScope(&SubmitLock);
+        Pending = FrameDoneTasks;
+    }
+    UE::Tasks::Wait(Pending);
+}
+
+FCamera2FramePipeline::FStats FCamera2FramePipeline::GetStats() const
+{
+    FStats Stats;
+    Stats.Submitted = Submitted.load();
+    Stats.Completed = Completed.load();
+    Stats.Dropped = Dropped.load();
+    Stats.MeanLatencyMs = Stats.Completed > 0 ? TotalLatencyNs.load() * 1e-6 / Stats.Completed : 0.0;
+    Stats.MaxLatencyMs = MaxLatencyNs.load() * 1e-6;
+
+    for (const TUniquePtr<FStage>& Stage : Stages)
+    {
+        FStageStats& StageStats = Stats.Stages.AddDefaulted_GetRef();
+        StageStats.Name = Stage->Desc.Name;
+        StageStats.Runs = Stage->Runs.load();
+        StageStats.Skipped = Stage->Skipped.load();
+        StageStats.MeanMs = StageStats.Runs > 0 ? Stage->TotalNs.load() * 1e-6 / StageStats.Runs : 0.0;
+        StageStats.MaxMs = Stage->MaxNs.load() * 1e-6;
+    }
+    return Stats;
+}
+
+void FCamera2FramePipeline::ResetStats()
+{
+    Submitted = 0;
+    Completed = 0;
+    Dropped = 0;
+    TotalLatencyNs = 0;
+    MaxLatencyNs = 0;
+    for (const TUniquePtr<FStage>& Stage : Stages)
+    {
+        Stage->Runs = 0;
+        Stage->Skipped = 0;
+        Stage->TotalNs = 0;
+        Stage->MaxNs = 0;
+    }
+}
+
+// =============================================================================
+// REPLAY SOURCE
+// =============================================================================
+
+FCamera2ReplaySource::FCamera2ReplaySource(int32 InWidth, int32 InHeight)
+    : Width(InWidth)
+    , Height(InHeight)
+{
+}
+
+int32 FCamera2ReplaySource::LoadDirectory(const FString& Directory)
+{
+    TArray<FString> Files;
+    IFileManager::Get().FindFiles(Files, *FPaths::Combine(Directory, TEXT("*")), true, false);
+    Files.Sort();
+
+    const int64 FrameBytes = static_cast<int64>(Width) * Height * 4;
+    for (const FString& File : Files)
+    {
+        TArray<uint8> Bytes;
+        if (!FFileHelper::LoadFileToArray(Bytes, *FPaths::Combine(Directory, File)))
+        {
+            continue;
+        }
+        if (Bytes.Num() != FrameBytes)
+        {
+            UE_LOG(LogSimpleCamera2, Warning, TEXT("Replay: skipping %s (%d bytes, expected %lld for %dx%d BGRA)"),
+                *File, Bytes.Num(), FrameBytes, Width, Height);
+            continue;
+        }
+        Frames.Add(MoveTemp(Bytes));
+    }
+
+    UE_LOG(LogSimpleCamera2, Log, TEXT("Replay: loaded %d frames from %s"), Frames.Num(), *Directory);
+    return Frames.Num();
+}
+
+void FCamera2ReplaySource::GeneratePattern(uint8* Dest) const
+{
+    // Checkerboard scrolling 4 px per frame over a gradient: gives the detector stable corners
+    const int32 Offset = static_cast<int32>(FrameCounter * 4);
+    for (int32 Y = 0; Y < Height; ++Y)
+    {
+        uint8* Row = Dest + static_cast<int64>(Y) * Width * 4;
+        for (int32 X = 0; X < Width; ++X)
+        {
+            const bool bCheck = (((X + Offset) / 40) ^ (Y / 40)) & 1;
+            const uint8 Base = static_cast<uint8>((X * 255) / FMath::Max(Width - 1, 1));
+            const uint8 Value = bCheck ? static_cast<uint8>(Base / 4) : static_cast<uint8>(192 + Base / 4);
+            Row[X * 4 + 0] = Value;
+            Row[X * 4 + 1] = Value;
+            Row[X * 4 + 2] = Value;
+            Row[X * 4 + 3] = 255;
+        }
+    }
+}
+
+void FCamera2ReplaySource::NextFrame(FCamera2PipelineBuffer& OutBGRA, FCamera2FrameMetadata& OutMetadata)
+{
+    OutBGRA.Allocate(Width, Height, 4);
+    if (Frames.Num() > 0)
+    {
+        FMemory::Memcpy(OutBGRA.Data.GetData(), Frames[FrameCounter % Frames.Num()].GetData(), OutBGRA.Data.Num());
+    }
+    else
+    {
+        GeneratePattern(OutBGRA.Data.GetData());
+    }
+
+    constexpr int64 FrameDurationNs = 33333333;
+    OutMetadata = FCamera2FrameMetadata();
+    OutMetadata.FrameNumber = FrameCounter;
+    OutMetadata.SensorTimestampNs = FrameCounter * FrameDurationNs;
+    OutMetadata.EngineTimestamp = FPlatformTime::Seconds();
+    OutMetadata.bHasCaptureResult = true;
+    OutMetadata.ExposureTimeNs = 8000000;
+    OutMetadata.FrameDurationNs = FrameDurationNs;
+    OutMetadata.RollingShutterSkewNs = 20000000;
+    OutMetadata.SensitivityIso = 400;
+    ++FrameCounter;
+}
+
+// =============================================================================
+// REFERENCE STAGES
+// =============================================================================
+
+namespace Camera2PipelineStages
+{
+    static bool ConvertToLuma(FCamera2StageContext& Context)
+    {
+        const FCamera2PipelineBuffer& Source = *Context.Inputs[0];
+        FCamera2PipelineBuffer& Luma = *Context.Outputs[0];
+        if (Source.BytesPerPixel != 4)
+        {
+            return false;
+        }
+
+        Luma.Allocate(Source.Width, Source.Height, 1);
+        const uint8* Src = Source.Data.GetData();
+        uint8* Dst = Luma.Data.GetData();
+        const int32 NumPixels = Source.Width * Source.Height;
+        for (int32 Index = 0; Index < NumPixels; ++Index)
+        {
+            // BT.601 weights in 8-bit fixed point, BGRA order
+            Dst[Index] = static_cast<uint8>((29 * Src[0] + 150 * Src[1] + 77 * Src[2]) >> 8);
+            Src += 4;
+        }
+        return true;
+    }
+
+    static bool BuildPyramid(FCamera2StageContext& Context)
+    {
+        const FCamera2PipelineBuffer& Luma = *Context.Inputs[0];
+        FCamera2PipelineBuffer& Pyramid = *Context.Outputs[0];
+
+        // Levels 1-3 stacked top to bottom, each at the level-1 row stride
+        const int32 W1 = Luma.Width / 2;
+        const int32 H1 = Luma.Height / 2;
+        Pyramid.Allocate(W1, H1 + H1 / 2 + H1 / 4, 1);
+
+        const uint8* Src = Luma.Data.GetData();
+        int32 SrcW = Luma.Width;
+        int32 SrcH = Luma.Height;
+        int32 SrcStride = Luma.Width;
+        int32 LevelW = W1;
+        int32 LevelH = H1;
+        uint8* Dst = Pyramid.Data.GetData();
+        for (int32 Level = 0; Level < 3; ++Level)
+        {
+            // Same 2x2 box filter as the texture mip chain
+            if (LevelW > 0 && LevelH > 0)
+            {
+                Camera2ImageConversion::Downsample2x2(Src, SrcW, SrcH, SrcStride, Dst, W1, 1);
+            }
+            Src = Dst;
+            SrcH = LevelH;
+            SrcW = LevelW;
+            SrcStride = W1;
+            Dst += static_cast<int64>(LevelH) * W1;
+            LevelW /= 2;
+            LevelH /= 2;
+        }
+        return SrcW > 0;
+    }
+
+    // Height of level 1 in a stacked pyramid of StackHeight rows (H + H/2 + H/4)
+    static int32 GetPyramidLevel1Height(int32 StackHeight)
+    {
+        int32 H1 = (StackHeight * 4) / 7;
+        while (H1 + H1 / 2 + H1 / 4 < StackHeight)
+        {
+            ++H1;
+        }
+        return H1;
+    }
+
+    static bool DetectCorners(FCamera2StageContext& Context)
+    {
+        const FCamera2PipelineBuffer& Pyramid = *Context.Inputs[0];
+        FCamera2PipelineBuffer& Corners = *Context.Outputs[0];
+
+        // Level 1, best min(|Ix|,|Iy|) response per 16x16 cell
+        const int32 W = Pyramid.Width;
+        const int32 H = GetPyramidLevel1Height(Pyramid.Height);
+        const uint8* Img = Pyramid.Data.GetData();
+        constexpr int32 CellSize = 16;
+        constexpr int32 MinResponse = 24;
+
+        TArray<int16, TInlineAllocator<2048>> Points;
+        for (int32 CellY = 1; CellY + CellSize < H; CellY += CellSize)
+        {
+            for (int32 CellX = 1; CellX + CellSize < W; CellX += CellSize)
+            {
+                int32 BestResponse = MinResponse;
+                int32 BestX = -1;
+                int32 BestY = -1;
+                for (int32 Y = CellY; Y < CellY + CellSize; ++Y)
+                {
+                    const uint8* Row = Img + static_cast<int64>(Y) * W;
+                    for (int32 X = CellX; X < CellX + CellSize; ++X)
+                    {
+                        const int32 Ix = FMath::Abs(Row[X + 1] - Row[X - 1]);
+                        const int32 Iy = FMath::Abs(Row[X + W] - Row[X - W]);
+                        const int32 Response = FMath::Min(Ix, Iy);
+                        if (Response > BestResponse)
+                        {
+                            BestResponse = Response;
+                            BestX = X;
+                            BestY = Y;
+                        }
+                    }
+                }
+                if (BestX >= 0)
+                {
+                    Points.Add(static_cast<int16>(BestX * 2));
+                    Points.Add(static_cast<int16>(BestY * 2));
+                }
+            }
+        }
+
+        Corners.Allocate(Points.Num() / 2, 1, 4);
+        FMemory::Memcpy(Corners.Data.GetData(), Points.GetData(), Points.Num() * sizeof(int16));
+        return true;
+    }
+
+    bool IsFrameUsable(const FCamera2FrameMetadata& Metadata)
+    {
+        if (!Metadata.bHasImageStats)
+        {
+            return true;
+        }
+        return Metadata.Sharpness >= CVarCamera2StatsMinSharpness.GetValueOnAnyThread()
+            && Metadata.MeanLuma >= CVarCamera2StatsMinMeanLuma.GetValueOnAnyThread()
+            && Metadata.MeanLuma <= CVarCamera2StatsMaxMeanLuma.GetValueOnAnyThread();
+    }
+
+    void AddReferenceStages(FCamera2FramePipeline& Pipeline)
+    {
+        FCamera2PipelineStageDesc Luma;
+        Luma.Name = TEXT("Luma");
+        Luma.Inputs = { TEXT("BGRA") };
+        Luma.Outputs = { TEXT("Luma") };
+        Luma.Work = &ConvertToLuma;
+        Pipeline.AddStage(MoveTemp(Luma));
+
+        FCamera2PipelineStageDesc Pyramid;
+        Pyramid.Name = TEXT("Pyramid");
+        Pyramid.Inputs = { TEXT("Luma") };
+        Pyramid.Outputs = { TEXT("Pyramid") };
+        Pyramid.Work = &BuildPyramid;
+        Pipeline.AddStage(MoveTemp(Pyramid));
+
+        FCamera2PipelineStageDesc Detect;
+        Detect.Name = TEXT("Detect");
+        Detect.Inputs = { TEXT("Pyramid") };
+        Detect.Outputs = { TEXT("Corners") };
+        Detect.Work = &DetectCorners;
+        Detect.bSkipWhenBehind = true;
+        Detect.ShouldRun = &IsFrameUsable;
+        Pipeline.AddStage(MoveTemp(Detect));
+    }
+
+    void RunBenchmark(int32 NumFrames, int32 MaxInFlight, float SubmitFps, const FString& ReplayDirectory)
+    {
+        FCamera2ReplaySource Source;
+        if (!ReplayDirectory.IsEmpty())
+        {
+            Source.LoadDirectory(ReplayDirectory);
+        }
+
+        FCamera2FramePipeline Pipeline(MaxInFlight);
+        AddReferenceStages(Pipeline);
+        if (!Pipeline.Finalize())
+        {
+            return;
+        }
+
+        // Unpaced runs wait for a free slot to measure sustained throughput; paced runs drop like the camera would
+        const bool bPaced = SubmitFps > 0.0f;
+        const double FrameInterval = bPaced ? 1.0 / SubmitFps : 0.0;
+        const double StartTime = FPlatformTime::Seconds();
+        for (int32 Index = 0; Index < NumFrames; ++Index)
+        {
+            if (bPaced)
+            {
+                const double Due = StartTime + Index * FrameInterval;
+                const double Now = FPlatformTime::Seconds();
+                if (Due > Now)
+                {
+                    FPlatformProcess::Sleep(static_cast<float>(Due - Now));
+                }
+            }
+            Pipeline.Submit([&Source](FCamera2FrameMetadata& Metadata, TArrayView<FCamera2PipelineBuffer*> Sources)
+                {
+                    Source.NextFrame(*Sources[0], Metadata);
+                }, !bPaced);
+        }
+        Pipeline.Flush();
+        const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+        const FCamera2FramePipeline::FStats Stats = Pipeline.GetStats();
+        const FString Mode = bPaced ? FString::Printf(TEXT("paced %.0f fps"), SubmitFps) : FString(TEXT("unpaced"));
+        UE_LOG(LogSimpleCamera2, Display,
+            TEXT("Pipeline benchmark: %lld frames in %.2f s = %.1f fps (%s, %d in flight, %s source), dropped %lld, latency mean %.2f ms max %.2f ms"),
+            Stats.Completed, Elapsed, Elapsed > 0.0 ? Stats.Completed / Elapsed : 0.0,
+            *Mode, Pipeline.GetMaxInFlight(),
+            Source.GetNumRecordedFrames() > 0 ? TEXT("replay") : TEXT("synthetic"),
+            Stats.Dropped, Stats.MeanLatencyMs, Stats.MaxLatencyMs);
+        for (const FCamera2FramePipeline::FStageStats& Stage : Stats.Stages)
+        {
+            UE_LOG(LogSimpleCamera2, Display, TEXT("  %-10s runs %6lld  skipped %6lld  mean %6.2f ms  max %6.2f ms"),
+                *Stage.Name.ToString(), Stage.Runs, Stage.Skipped, Stage.MeanMs, Stage.MaxMs);
+        }
+    }
+}
+
+static FAutoConsoleCommand GCamera2PipelineBenchmarkCommand(
+    TEXT("Camera2.Pipeline.Benchmark"),
+    TEXT("Run the reference frame pipeline over replayed frames. Args: [NumFrames=600] [MaxInFlight=3] [SubmitFps=0 (unpaced)] [ReplayDir]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const int32 NumFrames = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 600;
+        const int32 MaxInFlight = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 3;
+        const float SubmitFps = Args.Num() > 2 ? FCString::Atof(*Args[2]) : 0.0f;
+        const FString ReplayDirectory = Args.Num() > 3 ? Args[3] : FString();
+        Camera2PipelineStages::RunBenchmark(FMath::Max(NumFrames, 1), MaxInFlight, SubmitFps, ReplayDirectory);
+    }));
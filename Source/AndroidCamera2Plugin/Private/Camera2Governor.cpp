@@ -0,0 +1,456 @@
+#include "Camera2Governor.h"
+#include "SimpleCamera2Test.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+
+static TAutoConsoleVariable<float> CVarCamera2GovernorInterval(
+    TEXT("Camera2.Governor.Interval"),
+    0.5f,
+    TEXT("Seconds between governor evaluations."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarCamera2GovernorLatencyBudgetMs(
+    TEXT("Camera2.Governor.LatencyBudgetMs"),
+    50.0f,
+    TEXT("Capture-to-result latency the governor holds by shedding work."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCamera2GovernorStepDownWindows(
+    TEXT("Camera2.Governor.StepDownWindows"),
+    2,
+    TEXT("Consecutive evaluations over budget before the default policy sheds one more step of work."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCamera2GovernorStepUpWindows(
+    TEXT("Camera2.Governor.StepUpWindows"),
+    4,
+    TEXT("Consecutive evaluations with headroom before the default policy restores one step of work."),
+    ECVF_Default);
+
+// Queued frames beyond this count as falling behind
+static constexpr int32 MaxHealthyQueueDepth = 2;
+
+// =============================================================================
+// LADDER POLICY
+// =============================================================================
+
+FCamera2LadderGovernorPolicy::FCamera2LadderGovernorPolicy()
+{
+    auto AddStep = [this](int32 Decimation, float OutputScale, bool bSkipOptionalStages)
+        {
+            FCamera2GovernorState& Step = Ladder.AddDefaulted_GetRef();
+            Step.Level = Ladder.Num() - 1;
+            Step.Decimation = Decimation;
+            Step.OutputScale = OutputScale;
+            Step.bSkipOptionalStages = bSkipOptionalStages;
+        };
+    AddStep(1, 1.0f, false);
+    AddStep(1, 1.0f, true);
+    AddStep(2, 1.0f, true);
+    AddStep(2, 0.5f, true);
+    AddStep(3, 0.5f, true);
+    AddStep(4, 0.5f, true);
+}
+
+FCamera2GovernorState FCamera2LadderGovernorPolicy::Evaluate(const FCamera2GovernorInputs& Inputs,
+    const FCamera2GovernorState& Current, double LatencyBudgetMs)
+{
+    int32 Index = FMath::Clamp(Current.Level, 0, Ladder.Num() - 1);
+
+    // Critical means the device is about to throttle hard or shut the app down
+    if (Inputs.Thermal == ETemperatureSeverity::Critical)
+    {
+        OverBudgetWindows = 0;
+        HeadroomWindows = 0;
+        return Ladder.Last();
+    }
+
+    const double LatencyMs = Inputs.GetLatencyMs();
+    const bool bOverBudget = LatencyMs > LatencyBudgetMs || Inputs.QueueDepth > MaxHealthyQueueDepth
+        || Inputs.PipelineDrops > 0 || Inputs.Thermal == ETemperatureSeverity::Serious;
+    const bool bHeadroom = LatencyMs < 0.6 * LatencyBudgetMs && Inputs.QueueDepth <= 1 && Inputs.PipelineDrops == 0
+        && (Inputs.Thermal == ETemperatureSeverity::Unknown || Inputs.Thermal == ETemperatureSeverity::Good);
+
+    if (bOverBudget)
+    {
+        HeadroomWindows = 0;
+        if (++OverBudgetWindows >= FMath::Max(CVarCamera2GovernorStepDownWindows.GetValueOnAnyThread(), 1))
+        {
+            Index = FMath::Min(Index + 1, Ladder.Num() - 1);
+            OverBudgetWindows = 0;
+        }
+    }
+    else if (bHeadroom)
+    {
+        OverBudgetWindows = 0;
+        if (++HeadroomWindows >= FMath::Max(CVarCamera2GovernorStepUpWindows.GetValueOnAnyThread(), 1))
+        {
+            Index = FMath::Max(Index - 1, 0);
+            HeadroomWindows = 0;
+        }
+    }
+    else
+    {
+        OverBudgetWindows = 0;
+        HeadroomWindows = 0;
+    }
+    return Ladder[Index];
+}
+
+// =============================================================================
+// GOVERNOR
+// =============================================================================
+
+FCamera2Governor::FCamera2Governor(TSharedPtr<ICamera2GovernorPolicy> InPolicy)
+{
+    SetPolicy(MoveTemp(InPolicy));
+    TemperatureHandle = FCoreDelegates::OnTemperatureChange.AddRaw(this, &FCamera2Governor::HandleTemperatureChange);
+}
+
+FCamera2Governor::~FCamera2Governor()
+{
+    FCoreDelegates::OnTemperatureChange.Remove(TemperatureHandle);
+}
+
+void FCamera2Governor::SetPolicy(TSharedPtr<ICamera2GovernorPolicy> InPolicy)
+{
+    Policy = InPolicy.IsValid() ? MoveTemp(InPolicy) : MakeShared<FCamera2LadderGovernorPolicy>();
+}
+
+double FCamera2Governor::GetLatencyBudgetMs() const
+{
+    return LatencyBudgetMs > 0.0 ? LatencyBudgetMs : CVarCamera2GovernorLatencyBudgetMs.GetValueOnAnyThread();
+}
+
+float FCamera2Governor::GetInterval()
+{
+    return FMath::Max(CVarCamera2GovernorInterval.GetValueOnAnyThread(), 0.05f);
+}
+
+void FCamera2Governor::HandleTemperatureChange(ETemperatureSeverity Severity)
+{
+    Thermal = Severity;
+}
+
+FCamera2GovernorState FCamera2Governor::Update(const FCamera2GovernorInputs& Inputs)
+{
+    const FCamera2GovernorState Next = Policy->Evaluate(Inputs, State, GetLatencyBudgetMs());
+    if (Next != State)
+    {
+        UE_LOG(LogSimpleCamera2, Log,
+            TEXT("Governor: level %d -> %d (every %d frame(s), output scale %.2f, optional stages %s) at latency %.1f ms, queue %d, thermal %d"),
+            State.Level, Next.Level, Next.Decimation, Next.OutputScale, Next.bSkipOptionalStages ? TEXT("off") : TEXT("on"),
+            Inputs.GetLatencyMs(), Inputs.QueueDepth, static_cast<int32>(Inputs.Thermal));
+    }
+    State = Next;
+    return State;
+}
+
+void FCamera2Governor::SampleInputs(const FCamera2FramePipeline& Pipeline, FCamera2GovernorInputs& InOutInputs)
+{
+    const FCamera2FramePipeline::FStats Stats = Pipeline.GetStats();
+    // Counters went backwards: the stats were reset (or this is another pipeline)
+    if (Stats.Submitted < LastPipelineStats.Submitted || Stats.Stages.Num() != LastPipelineStats.Stages.Num())
+    {
+        LastPipelineStats = FCamera2FramePipeline::FStats();
+        LastPipelineStats.Stages.SetNum(Stats.Stages.Num());
+    }
+
+    // Window means from the running means and counts
+    const int64 Completed = Stats.Completed - LastPipelineStats.Completed;
+    if (Completed > 0)
+    {
+        InOutInputs.PipelineLatencyMs = (Stats.MeanLatencyMs * Stats.Completed
+            - LastPipelineStats.MeanLatencyMs * LastPipelineStats.Completed) / Completed;
+    }
+    for (int32 Index = 0; Index < Stats.Stages.Num(); ++Index)
+    {
+        const FCamera2FramePipeline::FStageStats& Stage = Stats.Stages[Index];
+        const FCamera2FramePipeline::FStageStats& Last = LastPipelineStats.Stages[Index];
+        const int64 Runs = Stage.Runs - Last.Runs;
+        if (Runs > 0)
+        {
+            const double MeanMs = (Stage.MeanMs * Stage.Runs - Last.MeanMs * Last.Runs) / Runs;
+            InOutInputs.SlowestStageMs = FMath::Max(InOutInputs.SlowestStageMs, MeanMs);
+        }
+    }
+    InOutInputs.PipelineDrops += Stats.Dropped - LastPipelineStats.Dropped;
+    InOutInputs.QueueDepth += Pipeline.GetNumInFlight();
+    LastPipelineStats = Stats;
+}
+
+// =============================================================================
+// SIMULATION
+// =============================================================================
+
+namespace Camera2Governor
+{
+    static int64 GetStageRuns(const FCamera2FramePipeline& Pipeline, FName Stage, int64* OutSkipped = nullptr)
+    {
+        for (const FCamera2FramePipeline::FStageStats& Stats : Pipeline.GetStats().Stages)
+        {
+            if (Stats.Name == Stage)
+            {
+                if (OutSkipped)
+                {
+                    *OutSkipped = Stats.Skipped;
+                }
+                return Stats.Runs;
+            }
+        }
+        return 0;
+    }
+
+    // Replayed frames through a real FCamera2FramePipeline: checks what SampleInputs reads from it (latency,
+    // slowest stage, frames in flight, drops per window) and that the optional-stage skipping the governor
+    // asks for reaches the stages, applied the way FCameraStream::TickGovernor does. Frames are held by a
+    // gate instead of timed, so the outcome does not depend on how fast the device runs them.
+    static bool RunPipelineCheck(double LatencyBudgetMs)
+    {
+        const FName RefineName(TEXT("Refine"));
+        FEvent* Gate = FPlatformProcess::GetSynchEventFromPool(true);
+        Gate->Trigger();
+
+        FCamera2ReplaySource Source;
+        FCamera2FramePipeline Pipeline(3);
+        Camera2PipelineStages::AddReferenceStages(Pipeline);
+
+        FCamera2PipelineStageDesc Load;
+        Load.Name = TEXT("Load");
+        Load.Inputs = { TEXT("Luma") };
+        Load.Outputs = { TEXT("LoadResult") };
+        Load.Work = [Gate](FCamera2StageContext& Context)
+            {
+                Gate->Wait();
+                Context.Outputs[0]->Allocate(1, 1, 1);
+                return true;
+            };
+        Pipeline.AddStage(MoveTemp(Load));
+
+        FCamera2PipelineStageDesc Refine;
+        Refine.Name = RefineName;
+        Refine.Inputs = { TEXT("LoadResult") };
+        Refine.Outputs = { TEXT("Refined") };
+        Refine.bOptional = true;
+        Refine.Work = [](FCamera2StageContext& Context)
+            {
+                Context.Outputs[0]->Allocate(1, 1, 1);
+                return true;
+            };
+        Pipeline.AddStage(MoveTemp(Refine));
+
+        if (!Pipeline.Finalize())
+        {
+            FPlatformProcess::ReturnSynchEventToPool(Gate);
+            return false;
+        }
+
+        auto SubmitFrames = [&Pipeline, &Source](int32 Count, bool bWaitForSlot)
+            {
+                for (int32 Index = 0; Index < Count; ++Index)
+                {
+                    Pipeline.Submit([&Source](FCamera2FrameMetadata& Metadata, TArrayView<FCamera2PipelineBuffer*> Sources)
+                        {
+                            Source.NextFrame(*Sources[0], Metadata);
+                        }, bWaitForSlot);
+                }
+            };
+
+        FCamera2Governor Governor;
+        Governor.SetLatencyBudgetMs(LatencyBudgetMs);
+        auto StepUntil = [&Governor, &Pipeline, LatencyBudgetMs](bool bSkip)
+            {
+                // Over budget until the ladder sheds the optional stages, headroom until it restores them
+                FCamera2GovernorInputs Inputs;
+                Inputs.Thermal = ETemperatureSeverity::Good;
+                Inputs.PipelineLatencyMs = bSkip ? LatencyBudgetMs * 2.0 : 0.0;
+                for (int32 Step = 0; Step < 64 && Governor.GetState().bSkipOptionalStages != bSkip; ++Step)
+                {
+                    Governor.Update(Inputs);
+                }
+                Pipeline.SetSkipOptionalStages(Governor.GetState().bSkipOptionalStages);
+                return Governor.GetState().bSkipOptionalStages == bSkip;
+            };
+
+        constexpr int32 FramesPerPhase = 8;
+        bool bPassed = true;
+        auto Expect = [&bPassed](bool bCondition, const TCHAR* What)
+            {
+                if (!bCondition)
+                {
+                    UE_LOG(LogSimpleCamera2, Warning, TEXT("Governor pipeline check: %s"), What);
+                    bPassed = false;
+                }
+            };
+
+        // Full quality: every frame completes, the optional stage runs for each
+        SubmitFrames(FramesPerPhase, true);
+        Pipeline.Flush();
+        FCamera2GovernorInputs Inputs;
+        Governor.SampleInputs(Pipeline, Inputs);
+        Expect(Inputs.PipelineLatencyMs > 0.0 && Inputs.SlowestStageMs > 0.0, TEXT("no latency or stage timing sampled"));
+        Expect(Inputs.QueueDepth == 0 && Inputs.PipelineDrops == 0, TEXT("idle pipeline sampled as busy"));
+        Expect(GetStageRuns(Pipeline, RefineName) == FramesPerPhase, TEXT("optional stage did not run at full quality"));
+
+        // Shed: the optional stage is skipped, everything else still runs
+        Expect(StepUntil(true), TEXT("governor never skipped optional stages"));
+        int64 SkippedBefore = 0;
+        const int64 RunsBefore = GetStageRuns(Pipeline, RefineName, &SkippedBefore);
+        SubmitFrames(FramesPerPhase, true);
+        Pipeline.Flush();
+        int64 SkippedAfter = 0;
+        const int64 RunsAfter = GetStageRuns(Pipeline, RefineName, &SkippedAfter);
+        Expect(RunsAfter == RunsBefore && SkippedAfter - SkippedBefore == FramesPerPhase, TEXT("optional stage ran while shed"));
+
+        // Backlog: with the gate closed the first MaxInFlight frames stay in the graph and the rest are dropped
+        Gate->Reset();
+        SubmitFrames(Pipeline.GetMaxInFlight() + FramesPerPhase, false);
+        Inputs = FCamera2GovernorInputs();
+        Governor.SampleInputs(Pipeline, Inputs);
+        Expect(Inputs.QueueDepth == Pipeline.GetMaxInFlight(), TEXT("frames in flight not sampled"));
+        Expect(Inputs.PipelineDrops == FramesPerPhase, TEXT("drops not sampled for the window"));
+        Gate->Trigger();
+        Pipeline.Flush();
+
+        // Restored: the optional stage runs again
+        Expect(StepUntil(false), TEXT("governor never restored optional stages"));
+        const int64 RunsRestored = GetStageRuns(Pipeline, RefineName);
+        SubmitFrames(FramesPerPhase, true);
+        Pipeline.Flush();
+        Expect(GetStageRuns(Pipeline, RefineName) - RunsRestored == FramesPerPhase, TEXT("optional stage did not resume"));
+
+        FPlatformProcess::ReturnSynchEventToPool(Gate);
+        UE_LOG(LogSimpleCamera2, Display, TEXT("Governor pipeline check %s"), bPassed ? TEXT("PASSED") : TEXT("FAILED"));
+        return bPassed;
+    }
+
+    bool RunSimulation(int32 NumFrames, double LatencyBudgetMs)
+    {
+        constexpr double FrameRate = 30.0;
+        // Modeled stage costs at full scale: the reference stages, a synthetic consumer whose cost follows
+        // the output area (like the undistorted slots), and an optional refinement stage
+        constexpr double ReferenceMs = 3.0;
+        constexpr double LoadMs = 10.0;
+        constexpr double RefineMs = 8.0;
+        // How much slower work runs while the script says the device is throttled
+        constexpr double ThrottledSlowdown = 3.0;
+        // Frames the modeled pipeline holds before it drops, as FCamera2FramePipeline(3)
+        constexpr int32 MaxInFlight = 3;
+
+        FCamera2Governor Governor;
+        Governor.SetLatencyBudgetMs(LatencyBudgetMs);
+        const int32 FramesPerWindow = FMath::Max(FMath::RoundToInt32(FCamera2Governor::GetInterval() * FrameRate), 1);
+
+        // Thermal script: cool, throttled, cool again
+        const int32 ThrottleBegin = NumFrames / 5;
+        const int32 ThrottleEnd = NumFrames / 2;
+
+        UE_LOG(LogSimpleCamera2, Display,
+            TEXT("Governor simulation: %d frames at %.0f fps, budget %.0f ms, throttled (x%.1f, thermal Bad) for frames %d-%d"),
+            NumFrames, FrameRate, LatencyBudgetMs, ThrottledSlowdown, ThrottleBegin, ThrottleEnd);
+
+        // The throttle script runs on a virtual clock against a model of the pipeline, so the outcome is the same
+        // on every machine and takes no wall time: one worker runs the frames in submit order; a frame's latency
+        // is its submit-to-completion time. RunPipelineCheck covers what a real pipeline reports to the governor
+        struct FModeledFrame
+        {
+            double SubmitMs;
+            double CompleteMs;
+        };
+        TArray<FModeledFrame> InFlight;
+        double WorkerFreeMs = 0.0;
+
+        double WindowLatencyMs = 0.0;
+        double WindowSlowestStageMs = 0.0;
+        int32 WindowCompleted = 0;
+        int32 WindowRuns = 0;
+        int64 WindowDrops = 0;
+
+        int32 MaxLevelThrottled = 0;
+        double LastThrottledLatencyMs = 0.0;
+        int32 WindowsOverBudget = 0;
+        int32 Windows = 0;
+        for (int32 Index = 0; Index < NumFrames; ++Index)
+        {
+            const double NowMs = Index * 1000.0 / FrameRate;
+            for (int32 Frame = InFlight.Num() - 1; Frame >= 0; --Frame)
+            {
+                if (InFlight[Frame].CompleteMs <= NowMs)
+                {
+                    WindowLatencyMs += InFlight[Frame].CompleteMs - InFlight[Frame].SubmitMs;
+                    ++WindowCompleted;
+                    InFlight.RemoveAtSwap(Frame);
+                }
+            }
+
+            const bool bThrottled = Index >= ThrottleBegin && Index < ThrottleEnd;
+            const double Slowdown = bThrottled ? ThrottledSlowdown : 1.0;
+
+            const FCamera2GovernorState State = Governor.GetState();
+            if (Index % State.Decimation == 0)
+            {
+                if (InFlight.Num() >= MaxInFlight)
+                {
+                    ++WindowDrops;
+                }
+                else
+                {
+                    const double StageLoadMs = LoadMs * Slowdown * FMath::Square(State.OutputScale);
+                    const double StageRefineMs = State.bSkipOptionalStages ? 0.0 : RefineMs * Slowdown;
+                    const double StartMs = FMath::Max(NowMs, WorkerFreeMs);
+                    WorkerFreeMs = StartMs + ReferenceMs * Slowdown + StageLoadMs + StageRefineMs;
+                    InFlight.Add({ NowMs, WorkerFreeMs });
+                    WindowSlowestStageMs += FMath::Max(StageLoadMs, StageRefineMs);
+                    ++WindowRuns;
+                }
+            }
+
+            if ((Index + 1) % FramesPerWindow == 0)
+            {
+                // What SampleInputs reports for a real pipeline
+                FCamera2GovernorInputs Inputs;
+                Inputs.Thermal = bThrottled ? ETemperatureSeverity::Bad : ETemperatureSeverity::Good;
+                Inputs.PipelineLatencyMs = WindowCompleted > 0 ? WindowLatencyMs / WindowCompleted : 0.0;
+                Inputs.SlowestStageMs = WindowRuns > 0 ? WindowSlowestStageMs / WindowRuns : 0.0;
+                Inputs.PipelineDrops = WindowDrops;
+                Inputs.QueueDepth = InFlight.Num();
+                const FCamera2GovernorState Next = Governor.Update(Inputs);
+
+                WindowLatencyMs = 0.0;
+                WindowSlowestStageMs = 0.0;
+                WindowCompleted = 0;
+                WindowRuns = 0;
+                WindowDrops = 0;
+
+                ++Windows;
+                WindowsOverBudget += Inputs.GetLatencyMs() > LatencyBudgetMs ? 1 : 0;
+                if (bThrottled)
+                {
+                    MaxLevelThrottled = FMath::Max(MaxLevelThrottled, Next.Level);
+                    LastThrottledLatencyMs = Inputs.GetLatencyMs();
+                }
+            }
+        }
+
+        const int32 FinalLevel = Governor.GetState().Level;
+        const bool bShed = MaxLevelThrottled > 0;
+        const bool bHeldBudget = LastThrottledLatencyMs <= LatencyBudgetMs;
+        const bool bRecovered = FinalLevel == 0;
+        const bool bPipelineChecked = RunPipelineCheck(LatencyBudgetMs);
+        const bool bPassed = bShed && bHeldBudget && bRecovered && bPipelineChecked;
+        UE_LOG(LogSimpleCamera2, Display,
+            TEXT("Governor simulation %s: max level while throttled %d, latency at end of throttling %.1f ms, final level %d, %d of %d windows over budget"),
+            bPassed ? TEXT("PASSED") : TEXT("FAILED"), MaxLevelThrottled, LastThrottledLatencyMs, FinalLevel, WindowsOverBudget, Windows);
+        return bPassed;
+    }
+}
+
+static FAutoConsoleCommand GCamera2GovernorSimulateCommand(
+    TEXT("Camera2.Governor.Simulate"),
+    TEXT("Model frames on a virtual clock under a simulated thermal throttle and check the governor sheds and restores work, then check it against replayed frames in a real pipeline. Args: [NumFrames=900] [LatencyBudgetMs=50]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const int32 NumFrames = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 900;
+        const double BudgetMs = Args.Num() > 1 ? FCString::Atod(*Args[1]) : 50.0;
+        Camera2Governor::RunSimulation(FMath::Max(NumFrames, 60), BudgetMs > 0.0 ? BudgetMs : 50.0);
+    }));
@@ -0,0 +1,191 @@
+#include "Camera2HmdPoseSampler.h"
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "IXRTrackingSystem.h"
+#include "Misc/CoreDelegates.h"
+#include "RenderingThread.h"
+#include "SceneViewExtension.h"
+
+static TAutoConsoleVariable<float> CVarCamera2PoseGameLeadFrames(
+    TEXT("Camera2.Pose.GameLeadFrames"),
+    2.0f,
+    TEXT("Frames between reading the HMD pose on the game tick and the display time it is predicted for."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarCamera2PoseLateUpdateLeadFrames(
+    TEXT("Camera2.Pose.LateUpdateLeadFrames"),
+    1.0f,
+    TEXT("Frames between reading the HMD pose after the render thread's late update and the display time it is predicted for."),
+    ECVF_Default);
+
+// One history per source, 512 samples each (~4s at 72-120 Hz)
+static FCamera2PoseHistory GHmdPoseHistories[static_cast<int32>(ECamera2PoseSource::Count)];
+
+// Smoothed frame time for the prediction leads, updated by the tick
+static std::atomic<double> GHmdPoseFrameSeconds{ 1.0 / 72.0 };
+
+// Read time of the last late-update sample; lookups switch to the tick history once it goes stale
+static std::atomic<double> GLastLateUpdateSampleTime{ -1.0 };
+static constexpr double LateUpdateStaleSeconds = 0.25;
+
+static FTSTicker::FDelegateHandle GHmdPoseTickerHandle;
+static FDelegateHandle GHmdPosePostEngineInitHandle;
+
+// Tracking-to-world captured on the game thread for the frame the render thread is working on
+static FTransform GRenderThreadTrackingToWorld = FTransform::Identity;
+
+/**
+ * Samples the HMD pose on the render thread once the XR system has applied its late update.
+ * Runs after the HMD's own extension (lower priority runs later).
+ */
+class FCamera2PoseViewExtension : public FSceneViewExtensionBase
+{
+public:
+    FCamera2PoseViewExtension(const FAutoRegister& AutoRegister)
+        : FSceneViewExtensionBase(AutoRegister)
+    {
+    }
+
+    virtual void SetupViewFamily(FSceneViewFamily& InViewFamily) override {}
+    virtual void SetupView(FSceneViewFamily& InViewFamily, FSceneView& InView) override {}
+
+    virtual void BeginRenderViewFamily(FSceneViewFamily& InViewFamily) override
+    {
+        if (!GEngine || !GEngine->XRSystem.IsValid())
+        {
+            return;
+        }
+
+        const FTransform TrackingToWorld = GEngine->XRSystem->GetTrackingToWorldTransform();
+        ENQUEUE_RENDER_COMMAND(Camera2PoseTrackingToWorld)(
+            [TrackingToWorld](FRHICommandListImmediate& RHICmdList)
+            {
+                GRenderThreadTrackingToWorld = TrackingToWorld;
+            });
+    }
+
+    virtual void PreRenderViewFamily_RenderThread(FRDGBuilder& GraphBuilder, FSceneViewFamily& InViewFamily) override
+    {
+        FCamera2HmdPoseSampler::SampleNow();
+    }
+
+    virtual int32 GetPriority() const override { return -100; }
+};
+
+static TSharedPtr<FCamera2PoseViewExtension, ESPMode::ThreadSafe> GPoseViewExtension;
+
+static void RegisterPoseViewExtension()
+{
+    if (!GPoseViewExtension.IsValid() && GEngine)
+    {
+        GPoseViewExtension = FSceneViewExtensions::NewExtension<FCamera2PoseViewExtension>();
+    }
+}
+
+void FCamera2HmdPoseSampler::Startup()
+{
+    if (!GHmdPoseTickerHandle.IsValid())
+    {
+        GHmdPoseTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda(
+            [](float DeltaTime)
+            {
+                if (DeltaTime > 0.0f && DeltaTime < 0.25f)
+                {
+                    const double Smoothed = GHmdPoseFrameSeconds.load(std::memory_order_relaxed);
+                    GHmdPoseFrameSeconds.store(Smoothed + (DeltaTime - Smoothed) * 0.1, std::memory_order_relaxed);
+                }
+                SampleNow();
+                return true;
+            }));
+    }
+
+    // View extensions need GEngine; defer until the engine is up when loaded early
+    if (GEngine && GEngine->IsInitialized())
+    {
+        RegisterPoseViewExtension();
+    }
+    else if (!GHmdPosePostEngineInitHandle.IsValid())
+    {
+        GHmdPosePostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddStatic(&RegisterPoseViewExtension);
+    }
+}
+
+void FCamera2HmdPoseSampler::Shutdown()
+{
+    if (GHmdPoseTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(GHmdPoseTickerHandle);
+        GHmdPoseTickerHandle.Reset();
+    }
+
+    if (GHmdPosePostEngineInitHandle.IsValid())
+    {
+        FCoreDelegates::OnPostEngineInit.Remove(GHmdPosePostEngineInitHandle);
+        GHmdPosePostEngineInitHandle.Reset();
+    }
+
+    GPoseViewExtension.Reset();
+}
+
+FCamera2PoseHistory& FCamera2HmdPoseSampler::GetHistory()
+{
+    return GetHistory(GetActiveSource());
+}
+
+FCamera2PoseHistory& FCamera2HmdPoseSampler::GetHistory(ECamera2PoseSource Source)
+{
+    return GHmdPoseHistories[static_cast<int32>(Source)];
+}
+
+ECamera2PoseSource FCamera2HmdPoseSampler::GetActiveSource()
+{
+    const double LastLateUpdate = GLastLateUpdateSampleTime.load(std::memory_order_relaxed);
+    return LastLateUpdate >= 0.0 && FPlatformTime::Seconds() - LastLateUpdate < LateUpdateStaleSeconds
+        ? ECamera2PoseSource::LateUpdate
+        : ECamera2PoseSource::GameTick;
+}
+
+void FCamera2HmdPoseSampler::SampleNow()
+{
+    if (!GEngine || !GEngine->XRSystem.IsValid())
+    {
+        return;
+    }
+
+    FQuat Orientation;
+    FVector Position;
+    if (!GEngine->XRSystem->GetCurrentPose(IXRTrackingSystem::HMDDeviceId, Orientation, Position))
+    {
+        return;
+    }
+
+    const bool bLateUpdate = IsInRenderingThread();
+    const FTransform TrackingToWorld = bLateUpdate
+        ? GRenderThreadTrackingToWorld
+        : GEngine->XRSystem->GetTrackingToWorldTransform();
+
+    // Stamp with the time the pose is predicted for, not the time it was read
+    const double Now = FPlatformTime::Seconds();
+    const float LeadFrames = bLateUpdate
+        ? CVarCamera2PoseLateUpdateLeadFrames.GetValueOnAnyThread()
+        : CVarCamera2PoseGameLeadFrames.GetValueOnAnyThread();
+    const double PredictedTime = Now + FMath::Max(LeadFrames, 0.0f) * GHmdPoseFrameSeconds.load(std::memory_order_relaxed);
+
+    const ECamera2PoseSource Source = bLateUpdate ? ECamera2PoseSource::LateUpdate : ECamera2PoseSource::GameTick;
+    GetHistory(Source).Push(PredictedTime, FTransform(Orientation, Position) * TrackingToWorld);
+    if (bLateUpdate)
+    {
+        GLastLateUpdateSampleTime.store(Now, std::memory_order_relaxed);
+    }
+}
+
+bool FCamera2HmdPoseSampler::GetHmdPoseAtTime(double EngineTimeSeconds, FTransform& OutHmdToWorld)
+{
+    return GetHistory().Sample(EngineTimeSeconds, OutHmdToWorld);
+}
+
+bool FCamera2HmdPoseSampler::GetWorldFromCameraAtTime(double EngineTimeSeconds, const FTransform& CamInHmd, FTransform& OutWorldFromCamera)
+{
+    return GetHistory().SampleComposed(EngineTimeSeconds, CamInHmd, OutWorldFromCamera);
+}
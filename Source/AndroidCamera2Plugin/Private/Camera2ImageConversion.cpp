@@ -0,0 +1,1122 @@
+#include "Camera2ImageConversion.h"
+#include "SimpleCamera2Test.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/IConsoleManager.h"
+#include <atomic>
+
+static TAutoConsoleVariable<int32> CVarCamera2ConvertTileKB(
+    TEXT("Camera2.Convert.TileKB"),
+    64,
+    TEXT("Output bytes per row tile claimed by one worker during frame conversion (KB)."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCamera2ConvertMaxWorkers(
+    TEXT("Camera2.Convert.MaxWorkers"),
+    0,
+    TEXT("Threads used for frame conversion, including the calling thread (0 = all task-graph workers)."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCamera2ConvertParallelMinPixels(
+    TEXT("Camera2.Convert.ParallelMinPixels"),
+    256 * 1024,
+    TEXT("Images with fewer pixels are converted on the calling thread."),
+    ECVF_Default);
+
+FCamera2YuvPlanes FCamera2YuvPlanes::Crop(const FIntRect& Rect) const
+{
+    checkSlow((Rect.Min.X & 1) == 0 && (Rect.Min.Y & 1) == 0);
+
+    FCamera2YuvPlanes Cropped = *this;
+    const int64 ChromaOffset = static_cast<int64>(Rect.Min.Y / 2) * UVRowStride + static_cast<int64>(Rect.Min.X / 2) * UVPixelStride;
+    Cropped.Y = Y + static_cast<int64>(Rect.Min.Y) * YRowStride + Rect.Min.X;
+    Cropped.U = U + ChromaOffset;
+    Cropped.V = V + ChromaOffset;
+    Cropped.Width = Rect.Width();
+    Cropped.Height = Rect.Height();
+    return Cropped;
+}
+
+int64 FCamera2YuvPlanes::GetRequiredYBytes() const
+{
+    return Height > 0 ? static_cast<int64>(Height - 1) * YRowStride + Width : 0;
+}
+
+int64 FCamera2YuvPlanes::GetRequiredUVBytes() const
+{
+    const int32 ChromaWidth = (Width + 1) / 2;
+    const int32 ChromaHeight = (Height + 1) / 2;
+    return ChromaHeight > 0
+        ? static_cast<int64>(ChromaHeight - 1) * UVRowStride + static_cast<int64>(ChromaWidth - 1) * UVPixelStride + 1
+        : 0;
+}
+
+float FCamera2RemapLUT::ClampScale(float InScale)
+{
+    return FMath::Clamp(InScale, 1.0f / 16.0f, 2.0f);
+}
+
+void FCamera2RemapLUT::Build(const FCamera2LensModel& InLens, float InScale)
+{
+    Lens = InLens;
+    Scale = ClampScale(InScale);
+
+    if (!Lens.IsValid() || Lens.Width < 2 || Lens.Height < 2 || Lens.Width > MAX_uint16 || Lens.Height > MAX_uint16)
+    {
+        OutputWidth = 0;
+        OutputHeight = 0;
+        Entries.Reset();
+        return;
+    }
+
+    OutputWidth = FMath::Max(FMath::RoundToInt32(Lens.Width * Scale), 1);
+    OutputHeight = FMath::Max(FMath::RoundToInt32(Lens.Height * Scale), 1);
+    Entries.SetNumUninitialized(OutputWidth * OutputHeight);
+
+    const FCamera2LensModel OutLens = GetOutputLens();
+    const float MaxU = static_cast<float>(Lens.Width - 1);
+    const float MaxV = static_cast<float>(Lens.Height - 1);
+
+    Camera2ImageConversion::ParallelForRowTiles(OutputHeight, OutputWidth, OutputWidth * sizeof(FEntry),
+        [&](int32 RowBegin, int32 RowEnd)
+        {
+            for (int32 Row = RowBegin; Row < RowEnd; ++Row)
+            {
+                const float NormY = (Row - OutLens.Cy) / OutLens.Fy;
+                FEntry* Out = Entries.GetData() + static_cast<int64>(Row) * OutputWidth;
+
+                for (int32 Col = 0; Col < OutputWidth; ++Col)
+                {
+                    FEntry Entry;
+                    const FVector2f Undistorted((Col - OutLens.Cx) / OutLens.Fx, NormY);
+                    if (Lens.MaxRadius2 <= 0.0f || Undistorted.SizeSquared() <= Lens.MaxRadius2)
+                    {
+                        const FVector2f Distorted = Lens.Distort(Undistorted);
+                        const float U = Distorted.X * Lens.Fx + Lens.Cx;
+                        const float V = Distorted.Y * Lens.Fy + Lens.Cy;
+                        if (U >= 0.0f && U <= MaxU && V >= 0.0f && V <= MaxV)
+                        {
+                            // Keep the 2x2 footprint inside the image; the last column/row gets weight ~1 on X0+1
+                            const int32 X0 = FMath::Min(FMath::FloorToInt32(U), Lens.Width - 2);
+                            const int32 Y0 = FMath::Min(FMath::FloorToInt32(V), Lens.Height - 2);
+                            Entry.X = static_cast<uint16>(X0);
+                            Entry.Y = static_cast<uint16>(Y0);
+                            Entry.FracX = static_cast<uint8>(FMath::Min(FMath::RoundToInt32((U - X0) * 256.0f), 255));
+                            Entry.FracY = static_cast<uint8>(FMath::Min(FMath::RoundToInt32((V - Y0) * 256.0f), 255));
+                            Entry.bValid = 1;
+                        }
+                    }
+                    Out[Col] = Entry;
+                }
+            }
+        });
+}
+
+bool FCamera2RemapLUT::IsBuiltFor(const FCamera2LensModel& InLens, float InScale) const
+{
+    return Entries.Num() > 0 && Scale == ClampScale(InScale) && Lens == InLens;
+}
+
+FCamera2LensModel FCamera2RemapLUT::GetOutputLens() const
+{
+    // Pixel centers stay aligned under the rescale
+    return FCamera2LensModel::Make(Lens.Fx * Scale, Lens.Fy * Scale,
+        (Lens.Cx + 0.5f) * Scale - 0.5f, (Lens.Cy + 0.5f) * Scale - 0.5f,
+        OutputWidth, OutputHeight, TArray<float>());
+}
+
+namespace Camera2ImageConversion
+{
+    // Full-range BT.601, 16-bit fixed point (same coefficients as the former Java conversion)
+    constexpr int32 CoeffRV = 91881;  // 1.402
+    constexpr int32 CoeffGU = 22544;  // 0.344
+    constexpr int32 CoeffGV = 46793;  // 0.714
+    constexpr int32 CoeffBU = 116130; // 1.772
+
+    FORCEINLINE uint32 PackBgra(int32 Y, int32 RV, int32 GUV, int32 BU)
+    {
+        const int32 YScaled = Y << 16;
+        const uint32 R = static_cast<uint32>(FMath::Clamp((YScaled + RV) >> 16, 0, 255));
+        const uint32 G = static_cast<uint32>(FMath::Clamp((YScaled - GUV) >> 16, 0, 255));
+        const uint32 B = static_cast<uint32>(FMath::Clamp((YScaled + BU) >> 16, 0, 255));
+        return B | (G << 8) | (R << 16) | 0xFF000000u;
+    }
+
+    static void ConvertBgraRows(const FCamera2YuvPlanes& Planes, uint8* Dst, int32 DstStride, int32 RowBegin, int32 RowEnd)
+    {
+        const int32 Width = Planes.Width;
+        const int32 UVStep = Planes.UVPixelStride;
+
+        for (int32 Row = RowBegin; Row < RowEnd; ++Row)
+        {
+            const uint8* YRow = Planes.Y + static_cast<int64>(Row) * Planes.YRowStride;
+            const uint8* URow = Planes.U + static_cast<int64>(Row >> 1) * Planes.UVRowStride;
+            const uint8* VRow = Planes.V + static_cast<int64>(Row >> 1) * Planes.UVRowStride;
+            uint32* Out = reinterpret_cast<uint32*>(Dst + static_cast<int64>(Row) * DstStride);
+
+            // One chroma sample covers two pixels
+            int32 Col = 0;
+            for (; Col + 1 < Width; Col += 2)
+            {
+                const int32 U = URow[(Col >> 1) * UVStep] - 128;
+                const int32 V = VRow[(Col >> 1) * UVStep] - 128;
+                const int32 RV = CoeffRV * V;
+                const int32 GUV = CoeffGU * U + CoeffGV * V;
+                const int32 BU = CoeffBU * U;
+                Out[Col] = PackBgra(YRow[Col], RV, GUV, BU);
+                Out[Col + 1] = PackBgra(YRow[Col + 1], RV, GUV, BU);
+            }
+            if (Col < Width)
+            {
+                const int32 U = URow[(Col >> 1) * UVStep] - 128;
+                const int32 V = VRow[(Col >> 1) * UVStep] - 128;
+                Out[Col] = PackBgra(YRow[Col], CoeffRV * V, CoeffGU * U + CoeffGV * V, CoeffBU * U);
+            }
+        }
+    }
+
+    static void ConvertLumaRows(const FCamera2YuvPlanes& Planes, uint8* Dst, int32 DstStride, int32 RowBegin, int32 RowEnd)
+    {
+        for (int32 Row = RowBegin; Row < RowEnd; ++Row)
+        {
+            FMemory::Memcpy(Dst + static_cast<int64>(Row) * DstStride,
+                Planes.Y + static_cast<int64>(Row) * Planes.YRowStride, Planes.Width);
+        }
+    }
+
+    static void DownsampleRows(const FCamera2YuvPlanes& Planes, int32 Factor, uint8* BgraDst, uint8* LumaDst,
+        int32 RowBegin, int32 RowEnd)
+    {
+        const int32 OutWidth = Planes.Width / Factor;
+        const int32 BlockArea = Factor * Factor;
+
+        for (int32 Row = RowBegin; Row < RowEnd; ++Row)
+        {
+            const int32 Y0 = Row * Factor;
+            const int32 ChromaY0 = Y0 >> 1;
+            const int32 ChromaY1 = (Y0 + Factor - 1) >> 1;
+            uint32* OutBgra = BgraDst ? reinterpret_cast<uint32*>(BgraDst + static_cast<int64>(Row) * OutWidth * 4) : nullptr;
+            uint8* OutLuma = LumaDst ? LumaDst + static_cast<int64>(Row) * OutWidth : nullptr;
+
+            for (int32 Col = 0; Col < OutWidth; ++Col)
+            {
+                const int32 X0 = Col * Factor;
+                int32 LumaSum = 0;
+                for (int32 DY = 0; DY < Factor; ++DY)
+                {
+                    const uint8* YRow = Planes.Y + static_cast<int64>(Y0 + DY) * Planes.YRowStride + X0;
+                    for (int32 DX = 0; DX < Factor; ++DX)
+                    {
+                        LumaSum += YRow[DX];
+                    }
+                }
+                const int32 Luma = (LumaSum + BlockArea / 2) / BlockArea;
+                if (OutLuma)
+                {
+                    OutLuma[Col] = static_cast<uint8>(Luma);
+                }
+                if (!OutBgra)
+                {
+                    continue;
+                }
+
+                // Chroma samples overlapping the block
+                int32 USum = 0;
+                int32 VSum = 0;
+                int32 Count = 0;
+                for (int32 ChromaY = ChromaY0; ChromaY <= ChromaY1; ++ChromaY)
+                {
+                    for (int32 ChromaX = X0 >> 1; ChromaX <= (X0 + Factor - 1) >> 1; ++ChromaX)
+                    {
+                        const int64 Offset = static_cast<int64>(ChromaY) * Planes.UVRowStride + ChromaX * Planes.UVPixelStride;
+                        USum += Planes.U[Offset];
+                        VSum += Planes.V[Offset];
+                        ++Count;
+                    }
+                }
+                const int32 U = (USum + Count / 2) / Count - 128;
+                const int32 V = (VSum + Count / 2) / Count - 128;
+                OutBgra[Col] = PackBgra(Luma, CoeffRV * V, CoeffGU * U + CoeffGV * V, CoeffBU * U);
+            }
+        }
+    }
+
+    static void ComputeLumaStatsTiled(const uint8* Luma, int32 Width, int32 Height, int32 RowStride, int32 PixelStride,
+        int32 Step, FCamera2LumaStats& OutStats, int32 MaxWorkersOverride)
+    {
+        OutStats = FCamera2LumaStats();
+        Step = FMath::Max(Step, 1);
+        if (!Luma || Width < 3 || Height < 3)
+        {
+            return;
+        }
+
+        const int32 NumRows = (Height - 2 + Step - 1) / Step;
+        const int32 SamplesPerRow = (Width - 2 + Step - 1) / Step;
+        uint64 Sum = 0;
+        uint64 SumSq = 0;
+        int64 LaplacianSum = 0;
+        uint64 LaplacianSumSq = 0;
+        FCriticalSection MergeLock;
+
+        ParallelForRowTiles(NumRows, SamplesPerRow, RowStride * Step, [&](int32 RowBegin, int32 RowEnd)
+            {
+                // Four interleaved sub-histograms, so runs of equal values do not serialize on one counter
+                uint32 SubHistograms[4][256] = {};
+                uint64 TileSum = 0;
+                uint64 TileSumSq = 0;
+                int64 TileLaplacianSum = 0;
+                uint64 TileLaplacianSumSq = 0;
+
+                for (int32 Sample = RowBegin; Sample < RowEnd; ++Sample)
+                {
+                    const uint8* Row = Luma + static_cast<int64>(1 + Sample * Step) * RowStride;
+                    const uint8* Up = Row - RowStride;
+                    const uint8* Down = Row + RowStride;
+                    int32 Lane = 0;
+                    for (int32 X = 1; X < Width - 1; X += Step, Lane = (Lane + 1) & 3)
+                    {
+                        const int32 Offset = X * PixelStride;
+                        const int32 Value = Row[Offset];
+                        const int32 Laplacian = 4 * Value - Row[Offset - PixelStride] - Row[Offset + PixelStride] - Up[Offset] - Down[Offset];
+                        ++SubHistograms[Lane][Value];
+                        TileSum += Value;
+                        TileSumSq += Value * Value;
+                        TileLaplacianSum += Laplacian;
+                        TileLaplacianSumSq += Laplacian * Laplacian;
+                    }
+                }
+
+                FScopeLock ScopeLock(&MergeLock);
+                for (int32 Bin = 0; Bin < 256; ++Bin)
+                {
+                    OutStats.Histogram[Bin] += SubHistograms[0][Bin] + SubHistograms[1][Bin] + SubHistograms[2][Bin] + SubHistograms[3][Bin];
+                }
+                Sum += TileSum;
+                SumSq += TileSumSq;
+                LaplacianSum += TileLaplacianSum;
+                LaplacianSumSq += TileLaplacianSumSq;
+            }, MaxWorkersOverride);
+
+        const double Count = static_cast<double>(NumRows) * SamplesPerRow;
+        const double Mean = Sum / Count;
+        const double LaplacianMean = LaplacianSum / Count;
+        OutStats.SampleCount = static_cast<int64>(Count);
+        OutStats.Mean = static_cast<float>(Mean);
+        OutStats.Variance = static_cast<float>(FMath::Max(SumSq / Count - Mean * Mean, 0.0));
+        OutStats.Sharpness = static_cast<float>(FMath::Max(LaplacianSumSq / Count - LaplacianMean * LaplacianMean, 0.0));
+    }
+
+    FORCEINLINE int32 SampleLuma(const FCamera2YuvPlanes& Planes, const FCamera2RemapLUT::FEntry& Entry)
+    {
+        const uint8* Row0 = Planes.Y + static_cast<int64>(Entry.Y) * Planes.YRowStride + Entry.X;
+        const uint8* Row1 = Row0 + Planes.YRowStride;
+        const int32 FracX = Entry.FracX;
+        const int32 FracY = Entry.FracY;
+        const int32 Top = Row0[0] * (256 - FracX) + Row0[1] * FracX;
+        const int32 Bottom = Row1[0] * (256 - FracX) + Row1[1] * FracX;
+        return (Top * (256 - FracY) + Bottom * FracY + 32768) >> 16;
+    }
+
+    static void RemapBgraRows(const FCamera2YuvPlanes& Planes, const FCamera2RemapLUT& Lut, uint8* Dst, int32 DstStride,
+        int32 RowBegin, int32 RowEnd)
+    {
+        const int32 Width = Lut.GetOutputWidth();
+        for (int32 Row = RowBegin; Row < RowEnd; ++Row)
+        {
+            const FCamera2RemapLUT::FEntry* Src = Lut.GetRow(Row);
+            uint32* Out = reinterpret_cast<uint32*>(Dst + static_cast<int64>(Row) * DstStride);
+
+            for (int32 Col = 0; Col < Width; ++Col)
+            {
+                const FCamera2RemapLUT::FEntry& Entry = Src[Col];
+                if (!Entry.bValid)
+                {
+                    Out[Col] = 0xFF000000u;
+                    continue;
+                }
+
+                // Chroma from the sample covering the nearer luma tap
+                const int32 ChromaX = (Entry.X + (Entry.FracX >> 7)) >> 1;
+                const int32 ChromaY = (Entry.Y + (Entry.FracY >> 7)) >> 1;
+                const int64 ChromaOffset = static_cast<int64>(ChromaY) * Planes.UVRowStride + ChromaX * Planes.UVPixelStride;
+                const int32 U = Planes.U[ChromaOffset] - 128;
+                const int32 V = Planes.V[ChromaOffset] - 128;
+                Out[Col] = PackBgra(SampleLuma(Planes, Entry), CoeffRV * V, CoeffGU * U + CoeffGV * V, CoeffBU * U);
+            }
+        }
+    }
+
+    static void RemapLumaRows(const FCamera2YuvPlanes& Planes, const FCamera2RemapLUT& Lut, uint8* Dst, int32 DstStride,
+        int32 RowBegin, int32 RowEnd)
+    {
+        const int32 Width = Lut.GetOutputWidth();
+        for (int32 Row = RowBegin; Row < RowEnd; ++Row)
+        {
+            const FCamera2RemapLUT::FEntry* Src = Lut.GetRow(Row);
+            uint8* Out = Dst + static_cast<int64>(Row) * DstStride;
+
+            for (int32 Col = 0; Col < Width; ++Col)
+            {
+                Out[Col] = Src[Col].bValid ? static_cast<uint8>(SampleLuma(Planes, Src[Col])) : 0;
+            }
+        }
+    }
+
+    // Rounded mean of each 2x2 block from output column ColBegin on; the reference the vector path must match
+    template <int32 Channels>
+    static void Downsample2x2RowScalar(const uint8* Row0, const uint8* Row1, int32 SrcWidth, uint8* Out, int32 DstWidth, int32 ColBegin)
+    {
+        for (int32 X = ColBegin; X < DstWidth; ++X)
+        {
+            const int32 X0 = 2 * X * Channels;
+            const int32 X1 = FMath::Min(2 * X + 1, SrcWidth - 1) * Channels;
+            for (int32 Channel = 0; Channel < Channels; ++Channel)
+            {
+                Out[X * Channels + Channel] = static_cast<uint8>(
+                    (Row0[X0 + Channel] + Row0[X1 + Channel] + Row1[X0 + Channel] + Row1[X1 + Channel] + 2) >> 2);
+            }
+        }
+    }
+
+#if PLATFORM_CPU_X86_FAMILY && PLATFORM_ENABLE_VECTORINTRINSICS
+    // Sums of horizontally adjacent pixels of 16 source bytes, one 16-bit lane per output channel (8 lanes)
+    template <int32 Channels>
+    FORCEINLINE __m128i SumPixelPairs(__m128i Bytes)
+    {
+        if constexpr (Channels == 1)
+        {
+            return _mm_add_epi16(_mm_and_si128(Bytes, _mm_set1_epi16(0x00FF)), _mm_srli_epi16(Bytes, 8));
+        }
+        else
+        {
+            const __m128i Lo = _mm_unpacklo_epi8(Bytes, _mm_setzero_si128());
+            const __m128i Hi = _mm_unpackhi_epi8(Bytes, _mm_setzero_si128());
+            return _mm_unpacklo_epi64(_mm_add_epi16(Lo, _mm_srli_si128(Lo, 8)), _mm_add_epi16(Hi, _mm_srli_si128(Hi, 8)));
+        }
+    }
+#endif
+
+    // Vector part of one output row: 16 output bytes from 32 bytes of each source row per step.
+    // Returns the output pixels written; the caller finishes the row with the scalar kernel.
+    template <int32 Channels>
+    static int32 Downsample2x2RowVector(const uint8* Row0, const uint8* Row1, uint8* Out, int32 DstWidth)
+    {
+        constexpr int32 Step = 16 / Channels;
+        int32 X = 0;
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+        for (; X + Step <= DstWidth; X += Step)
+        {
+            // De-interleave even and odd pixels, then widen, add and narrow with rounding
+            uint8x16_t A0, A1, B0, B1;
+            if constexpr (Channels == 1)
+            {
+                const uint8x16x2_t A = vld2q_u8(Row0 + 2 * X);
+                const uint8x16x2_t B = vld2q_u8(Row1 + 2 * X);
+                A0 = A.val[0]; A1 = A.val[1]; B0 = B.val[0]; B1 = B.val[1];
+            }
+            else
+            {
+                const uint32x4x2_t A = vld2q_u32(reinterpret_cast<const uint32*>(Row0 + 2 * X * Channels));
+                const uint32x4x2_t B = vld2q_u32(reinterpret_cast<const uint32*>(Row1 + 2 * X * Channels));
+                A0 = vreinterpretq_u8_u32(A.val[0]); A1 = vreinterpretq_u8_u32(A.val[1]);
+                B0 = vreinterpretq_u8_u32(B.val[0]); B1 = vreinterpretq_u8_u32(B.val[1]);
+            }
+            const uint16x8_t Lo = vaddq_u16(vaddl_u8(vget_low_u8(A0), vget_low_u8(A1)), vaddl_u8(vget_low_u8(B0), vget_low_u8(B1)));
+            const uint16x8_t Hi = vaddq_u16(vaddl_u8(vget_high_u8(A0), vget_high_u8(A1)), vaddl_u8(vget_high_u8(B0), vget_high_u8(B1)));
+            vst1q_u8(Out + X * Channels, vcombine_u8(vrshrn_n_u16(Lo, 2), vrshrn_n_u16(Hi, 2)));
+        }
+#elif PLATFORM_CPU_X86_FAMILY && PLATFORM_ENABLE_VECTORINTRINSICS
+        const __m128i Two = _mm_set1_epi16(2);
+        for (; X + Step <= DstWidth; X += Step)
+        {
+            const uint8* A = Row0 + 2 * X * Channels;
+            const uint8* B = Row1 + 2 * X * Channels;
+            const __m128i First = _mm_add_epi16(
+                SumPixelPairs<Channels>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(A))),
+                SumPixelPairs<Channels>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(B))));
+            const __m128i Second = _mm_add_epi16(
+                SumPixelPairs<Channels>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(A + 16))),
+                SumPixelPairs<Channels>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(B + 16))));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(Out + X * Channels), _mm_packus_epi16(
+                _mm_srli_epi16(_mm_add_epi16(First, Two), 2), _mm_srli_epi16(_mm_add_epi16(Second, Two), 2)));
+        }
+#endif
+        return X;
+    }
+
+    template <int32 Channels, bool bVector>
+    static void Downsample2x2Rows(const uint8* Src, int32 SrcWidth, int32 SrcHeight, int32 SrcStride, uint8* Dst, int32 DstStride,
+        int32 RowBegin, int32 RowEnd)
+    {
+        const int32 DstWidth = FMath::Max(SrcWidth >> 1, 1);
+        for (int32 Row = RowBegin; Row < RowEnd; ++Row)
+        {
+            const uint8* Row0 = Src + static_cast<int64>(2 * Row) * SrcStride;
+            const uint8* Row1 = Src + static_cast<int64>(FMath::Min(2 * Row + 1, SrcHeight - 1)) * SrcStride;
+            uint8* Out = Dst + static_cast<int64>(Row) * DstStride;
+
+            // A 1-pixel-wide source has no pair to vectorize over
+            const int32 ColBegin = bVector && SrcWidth >= 2 ? Downsample2x2RowVector<Channels>(Row0, Row1, Out, DstWidth) : 0;
+            Downsample2x2RowScalar<Channels>(Row0, Row1, SrcWidth, Out, DstWidth, ColBegin);
+        }
+    }
+
+    template <bool bVector>
+    static void Downsample2x2RowsAnyChannels(const uint8* Src, int32 SrcWidth, int32 SrcHeight, int32 SrcStride, uint8* Dst,
+        int32 DstStride, int32 Channels, int32 RowBegin, int32 RowEnd)
+    {
+        if (Channels == 4)
+        {
+            Downsample2x2Rows<4, bVector>(Src, SrcWidth, SrcHeight, SrcStride, Dst, DstStride, RowBegin, RowEnd);
+        }
+        else
+        {
+            check(Channels == 1);
+            Downsample2x2Rows<1, bVector>(Src, SrcWidth, SrcHeight, SrcStride, Dst, DstStride, RowBegin, RowEnd);
+        }
+    }
+
+    static bool PlanesMatchLut(const FCamera2YuvPlanes& Planes, const FCamera2RemapLUT& Lut)
+    {
+        return Lut.GetOutputWidth() > 0
+            && Planes.Width == Lut.GetSourceLens().Width && Planes.Height == Lut.GetSourceLens().Height;
+    }
+
+    void ParallelForRowTiles(int32 NumRows, int32 Width, int32 BytesPerRow,
+        TFunctionRef<void(int32 RowBegin, int32 RowEnd)> Body, int32 MaxWorkersOverride)
+    {
+        if (NumRows <= 0)
+        {
+            return;
+        }
+
+        const int32 AvailableThreads = FTaskGraphInterface::IsRunning()
+            ? FTaskGraphInterface::Get().GetNumWorkerThreads() + 1
+            : 1;
+        const int32 MaxWorkers = MaxWorkersOverride > 0 ? MaxWorkersOverride : CVarCamera2ConvertMaxWorkers.GetValueOnAnyThread();
+        const int32 NumWorkers = MaxWorkers > 0 ? FMath::Min(MaxWorkers, AvailableThreads) : AvailableThreads;
+
+        const int64 NumPixels = static_cast<int64>(NumRows) * Width;
+        if (NumWorkers <= 1 || NumPixels < CVarCamera2ConvertParallelMinPixels.GetValueOnAnyThread())
+        {
+            Body(0, NumRows);
+            return;
+        }
+
+        const int32 TileBytes = FMath::Max(CVarCamera2ConvertTileKB.GetValueOnAnyThread(), 1) * 1024;
+        const int32 RowsPerTile = FMath::Max(TileBytes / FMath::Max(BytesPerRow, 1), 1);
+        const int32 NumTiles = FMath::DivideAndRoundUp(NumRows, RowsPerTile);
+
+        // One task per worker pulling tiles off a shared counter: the worker cap holds and a late
+        // worker just finds fewer tiles left
+        std::atomic<int32> NextTile{ 0 };
+        ParallelFor(FMath::Min(NumWorkers, NumTiles), [&](int32 /*WorkerIndex*/)
+            {
+                for (int32 Tile = NextTile++; Tile < NumTiles; Tile = NextTile++)
+                {
+                    const int32 RowBegin = Tile * RowsPerTile;
+                    Body(RowBegin, FMath::Min(RowBegin + RowsPerTile, NumRows));
+                }
+            });
+    }
+
+    void ConvertYuvToBgra(const FCamera2YuvPlanes& Planes, uint8* Dst, int32 DstStride)
+    {
+        ParallelForRowTiles(Planes.Height, Planes.Width, Planes.Width * 4, [&](int32 RowBegin, int32 RowEnd)
+            {
+                ConvertBgraRows(Planes, Dst, DstStride, RowBegin, RowEnd);
+            });
+    }
+
+    void ConvertYuvToNv12(const FCamera2YuvPlanes& Planes, uint8* Dst, int32 DstStride)
+    {
+        const int32 ChromaWidth = (Planes.Width + 1) / 2;
+        const int32 ChromaHeight = (Planes.Height + 1) / 2;
+        check(DstStride >= ChromaWidth * 2);
+        uint8* UVDst = Dst + static_cast<int64>(Planes.Height) * DstStride;
+        // U,V already interleaved in memory (the usual YUV_420_888 layout on Quest) needs no shuffling
+        const bool bSemiPlanarUV = Planes.UVPixelStride == 2 && Planes.V == Planes.U + 1;
+
+        // One chroma row and its two luma rows per step
+        ParallelForRowTiles(ChromaHeight, Planes.Width, Planes.Width * 3, [&](int32 RowBegin, int32 RowEnd)
+            {
+                for (int32 Row = RowBegin; Row < RowEnd; ++Row)
+                {
+                    for (int32 LumaRow = 2 * Row; LumaRow < FMath::Min(2 * Row + 2, Planes.Height); ++LumaRow)
+                    {
+                        FMemory::Memcpy(Dst + static_cast<int64>(LumaRow) * DstStride,
+                            Planes.Y + static_cast<int64>(LumaRow) * Planes.YRowStride, Planes.Width);
+                    }
+
+                    const int64 SrcOffset = static_cast<int64>(Row) * Planes.UVRowStride;
+                    uint8* Out = UVDst + static_cast<int64>(Row) * DstStride;
+                    if (bSemiPlanarUV)
+                    {
+                        FMemory::Memcpy(Out, Planes.U + SrcOffset, ChromaWidth * 2);
+                        continue;
+                    }
+                    for (int32 X = 0; X < ChromaWidth; ++X)
+                    {
+                        Out[2 * X] = Planes.U[SrcOffset + X * Planes.UVPixelStride];
+                        Out[2 * X + 1] = Planes.V[SrcOffset + X * Planes.UVPixelStride];
+                    }
+                }
+            });
+    }
+
+    void ConvertYuvToLuma(const FCamera2YuvPlanes& Planes, uint8* Dst, int32 DstStride)
+    {
+        ParallelForRowTiles(Planes.Height, Planes.Width, Planes.Width, [&](int32 RowBegin, int32 RowEnd)
+            {
+                ConvertLumaRows(Planes, Dst, DstStride, RowBegin, RowEnd);
+            });
+    }
+
+    void DownsampleYuv(const FCamera2YuvPlanes& Planes, int32 Factor, uint8* BgraDst, uint8* LumaDst)
+    {
+        Factor = FMath::Max(Factor, 1);
+        const int32 OutWidth = Planes.Width / Factor;
+        const int32 OutHeight = Planes.Height / Factor;
+        ParallelForRowTiles(OutHeight, OutWidth, OutWidth * (BgraDst ? 4 : 1), [&](int32 RowBegin, int32 RowEnd)
+            {
+                DownsampleRows(Planes, Factor, BgraDst, LumaDst, RowBegin, RowEnd);
+            });
+    }
+
+    void Downsample2x2(const uint8* Src, int32 SrcWidth, int32 SrcHeight, int32 SrcStride, uint8* Dst, int32 DstStride, int32 Channels)
+    {
+        if (SrcWidth < 1 || SrcHeight < 1)
+        {
+            return;
+        }
+        Downsample2x2RowsAnyChannels<true>(Src, SrcWidth, SrcHeight, SrcStride, Dst, DstStride, Channels,
+            0, FMath::Max(SrcHeight >> 1, 1));
+    }
+
+    int32 GetNumMips(int32 Width, int32 Height)
+    {
+        return Width > 0 && Height > 0 ? FMath::FloorLog2(static_cast<uint32>(FMath::Max(Width, Height))) + 1 : 0;
+    }
+
+    int64 GetMipChainBytes(int32 Width, int32 Height, int32 BytesPerPixel, int32 NumMips)
+    {
+        int64 Bytes = 0;
+        for (int32 Mip = 0; Mip < NumMips; ++Mip)
+        {
+            Bytes += static_cast<int64>(FMath::Max(Width >> Mip, 1)) * FMath::Max(Height >> Mip, 1) * BytesPerPixel;
+        }
+        return Bytes;
+    }
+
+    // Builds with the vector or the scalar kernel, so the benchmark can compare the two
+    template <bool bVector>
+    static void BuildMipChainWith(uint8* Data, int32 Width, int32 Height, int32 BytesPerPixel, int32 NumMips, int32 MaxWorkersOverride = 0)
+    {
+        uint8* Src = Data;
+        int32 SrcWidth = Width;
+        int32 SrcHeight = Height;
+        for (int32 Mip = 1; Mip < NumMips; ++Mip)
+        {
+            uint8* Dst = Src + static_cast<int64>(SrcWidth) * SrcHeight * BytesPerPixel;
+            const int32 DstWidth = FMath::Max(SrcWidth >> 1, 1);
+            const int32 DstHeight = FMath::Max(SrcHeight >> 1, 1);
+            ParallelForRowTiles(DstHeight, DstWidth, DstWidth * BytesPerPixel, [&](int32 RowBegin, int32 RowEnd)
+                {
+                    Downsample2x2RowsAnyChannels<bVector>(Src, SrcWidth, SrcHeight, SrcWidth * BytesPerPixel,
+                        Dst, DstWidth * BytesPerPixel, BytesPerPixel, RowBegin, RowEnd);
+                }, MaxWorkersOverride);
+            Src = Dst;
+            SrcWidth = DstWidth;
+            SrcHeight = DstHeight;
+        }
+    }
+
+    void BuildMipChain(uint8* Data, int32 Width, int32 Height, int32 BytesPerPixel, int32 NumMips)
+    {
+        BuildMipChainWith<true>(Data, Width, Height, BytesPerPixel, NumMips);
+    }
+
+    void ComputeLumaStats(const uint8* Luma, int32 Width, int32 Height, int32 RowStride, int32 PixelStride, int32 Step,
+        FCamera2LumaStats& OutStats)
+    {
+        ComputeLumaStatsTiled(Luma, Width, Height, RowStride, PixelStride, Step, OutStats, 0);
+    }
+
+    bool RemapYuvToBgra(const FCamera2YuvPlanes& Planes, const FCamera2RemapLUT& Lut, uint8* Dst, int32 DstStride)
+    {
+        if (!PlanesMatchLut(Planes, Lut))
+        {
+            return false;
+        }
+        ParallelForRowTiles(Lut.GetOutputHeight(), Lut.GetOutputWidth(), Lut.GetOutputWidth() * 4, [&](int32 RowBegin, int32 RowEnd)
+            {
+                RemapBgraRows(Planes, Lut, Dst, DstStride, RowBegin, RowEnd);
+            });
+        return true;
+    }
+
+    bool RemapYuvToLuma(const FCamera2YuvPlanes& Planes, const FCamera2RemapLUT& Lut, uint8* Dst, int32 DstStride)
+    {
+        if (!PlanesMatchLut(Planes, Lut))
+        {
+            return false;
+        }
+        ParallelForRowTiles(Lut.GetOutputHeight(), Lut.GetOutputWidth(), Lut.GetOutputWidth(), [&](int32 RowBegin, int32 RowEnd)
+            {
+                RemapLumaRows(Planes, Lut, Dst, DstStride, RowBegin, RowEnd);
+            });
+        return true;
+    }
+
+    bool RemapYuvMulti(TArrayView<const FCamera2RemapTarget> Targets)
+    {
+        int32 NumBands = MAX_int32;
+        int64 TotalPixels = 0;
+        int64 TotalBytes = 0;
+        for (const FCamera2RemapTarget& Target : Targets)
+        {
+            if (!Target.Lut || !Target.Dst || !PlanesMatchLut(Target.Planes, *Target.Lut))
+            {
+                return false;
+            }
+            const int64 Pixels = static_cast<int64>(Target.Lut->GetOutputWidth()) * Target.Lut->GetOutputHeight();
+            NumBands = FMath::Min(NumBands, Target.Lut->GetOutputHeight());
+            TotalPixels += Pixels;
+            TotalBytes += Pixels * (Target.bLuma ? 1 : 4);
+        }
+        if (Targets.Num() == 0)
+        {
+            return true;
+        }
+
+        // One band is at least one row of the smallest target
+        ParallelForRowTiles(NumBands, static_cast<int32>(TotalPixels / NumBands), static_cast<int32>(TotalBytes / NumBands),
+            [&](int32 BandBegin, int32 BandEnd)
+            {
+                for (const FCamera2RemapTarget& Target : Targets)
+                {
+                    const int64 Height = Target.Lut->GetOutputHeight();
+                    const int32 RowBegin = static_cast<int32>(BandBegin * Height / NumBands);
+                    const int32 RowEnd = static_cast<int32>(BandEnd * Height / NumBands);
+                    if (Target.bLuma)
+                    {
+                        RemapLumaRows(Target.Planes, *Target.Lut, Target.Dst, Target.DstStride, RowBegin, RowEnd);
+                    }
+                    else
+                    {
+                        RemapBgraRows(Target.Planes, *Target.Lut, Target.Dst, Target.DstStride, RowBegin, RowEnd);
+                    }
+                }
+            });
+        return true;
+    }
+
+    // =============================================================================
+    // BENCHMARKS
+    // =============================================================================
+
+    static double MeasureMs(int32 Iterations, TFunctionRef<void()> Run)
+    {
+        Run(); // warm caches and wake workers
+        const double Start = FPlatformTime::Seconds();
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            Run();
+        }
+        return (FPlatformTime::Seconds() - Start) * 1000.0 / FMath::Max(Iterations, 1);
+    }
+
+    static FCamera2YuvPlanes MakeSyntheticFrame(int32 Width, int32 Height, TArray<uint8>& YPlane, TArray<uint8>& UVPlane)
+    {
+        // NV12-style interleaved chroma with padded rows, like the Quest camera HAL hands out
+        const int32 YRowStride = Align(Width, 64);
+        const int32 UVRowStride = YRowStride;
+        YPlane.SetNumUninitialized(YRowStride * Height);
+        UVPlane.SetNumUninitialized(UVRowStride * ((Height + 1) / 2));
+        for (int32 Index = 0; Index < YPlane.Num(); ++Index)
+        {
+            YPlane[Index] = static_cast<uint8>(Index * 7);
+        }
+        for (int32 Index = 0; Index < UVPlane.Num(); ++Index)
+        {
+            UVPlane[Index] = static_cast<uint8>(96 + (Index * 13) % 64);
+        }
+
+        FCamera2YuvPlanes Planes;
+        Planes.Y = YPlane.GetData();
+        Planes.U = UVPlane.GetData();
+        Planes.V = UVPlane.GetData() + 1;
+        Planes.Width = Width;
+        Planes.Height = Height;
+        Planes.YRowStride = YRowStride;
+        Planes.UVRowStride = UVRowStride;
+        Planes.UVPixelStride = 2;
+        return Planes;
+    }
+
+    // Unfused reference steps: undistort an already converted image, then resize it
+    template<int32 Channels>
+    static void RemapPackedRows(const uint8* Src, int32 SrcStride, const FCamera2RemapLUT& Lut, uint8* Dst, int32 DstStride,
+        int32 RowBegin, int32 RowEnd)
+    {
+        for (int32 Row = RowBegin; Row < RowEnd; ++Row)
+        {
+            const FCamera2RemapLUT::FEntry* Entries = Lut.GetRow(Row);
+            uint8* Out = Dst + static_cast<int64>(Row) * DstStride;
+            for (int32 Col = 0; Col < Lut.GetOutputWidth(); ++Col, Out += Channels)
+            {
+                const FCamera2RemapLUT::FEntry& Entry = Entries[Col];
+                const uint8* Row0 = Src + static_cast<int64>(Entry.Y) * SrcStride + Entry.X * Channels;
+                const uint8* Row1 = Row0 + SrcStride;
+                for (int32 Channel = 0; Channel < Channels; ++Channel)
+                {
+                    const int32 Top = Row0[Channel] * (256 - Entry.FracX) + Row0[Channel + Channels] * Entry.FracX;
+                    const int32 Bottom = Row1[Channel] * (256 - Entry.FracX) + Row1[Channel + Channels] * Entry.FracX;
+                    Out[Channel] = Entry.bValid ? static_cast<uint8>((Top * (256 - Entry.FracY) + Bottom * Entry.FracY + 32768) >> 16) : 0;
+                }
+            }
+        }
+    }
+
+    template<int32 Channels>
+    static void ResizeBilinearRows(const uint8* Src, int32 SrcWidth, int32 SrcHeight, int32 SrcStride,
+        uint8* Dst, int32 DstWidth, int32 DstHeight, int32 DstStride, int32 RowBegin, int32 RowEnd)
+    {
+        const float StepX = static_cast<float>(SrcWidth) / DstWidth;
+        const float StepY = static_cast<float>(SrcHeight) / DstHeight;
+        for (int32 Row = RowBegin; Row < RowEnd; ++Row)
+        {
+            const float SrcY = FMath::Clamp((Row + 0.5f) * StepY - 0.5f, 0.0f, static_cast<float>(SrcHeight - 1));
+            const int32 Y0 = FMath::Min(static_cast<int32>(SrcY), SrcHeight - 2);
+            const int32 FracY = FMath::Min(FMath::RoundToInt32((SrcY - Y0) * 256.0f), 256);
+            const uint8* Row0 = Src + static_cast<int64>(Y0) * SrcStride;
+            const uint8* Row1 = Row0 + SrcStride;
+            uint8* Out = Dst + static_cast<int64>(Row) * DstStride;
+
+            for (int32 Col = 0; Col < DstWidth; ++Col, Out += Channels)
+            {
+                const float SrcX = FMath::Clamp((Col + 0.5f) * StepX - 0.5f, 0.0f, static_cast<float>(SrcWidth - 1));
+                const int32 X0 = FMath::Min(static_cast<int32>(SrcX), SrcWidth - 2);
+                const int32 FracX = FMath::Min(FMath::RoundToInt32((SrcX - X0) * 256.0f), 256);
+                for (int32 Channel = 0; Channel < Channels; ++Channel)
+                {
+                    const int32 Index = X0 * Channels + Channel;
+                    const int32 Top = Row0[Index] * (256 - FracX) + Row0[Index + Channels] * FracX;
+                    const int32 Bottom = Row1[Index] * (256 - FracX) + Row1[Index + Channels] * FracX;
+                    Out[Channel] = static_cast<uint8>((Top * (256 - FracY) + Bottom * FracY + 32768) >> 16);
+                }
+            }
+        }
+    }
+
+    void RunBenchmark(int32 Iterations, int32 Width, int32 Height)
+    {
+        TArray<uint8> YPlane;
+        TArray<uint8> UVPlane;
+        const FCamera2YuvPlanes Planes = MakeSyntheticFrame(Width, Height, YPlane, UVPlane);
+
+        TArray<uint8> Bgra;
+        TArray<uint8> Luma;
+        Bgra.SetNumUninitialized(Width * Height * 4);
+        Luma.SetNumUninitialized(Width * Height);
+
+        const int32 MaxThreads = FTaskGraphInterface::IsRunning() ? FTaskGraphInterface::Get().GetNumWorkerThreads() + 1 : 1;
+        UE_LOG(LogSimpleCamera2, Display, TEXT("Conversion benchmark: %dx%d, %d iterations, tile %d KB, up to %d threads"),
+            Width, Height, Iterations, CVarCamera2ConvertTileKB.GetValueOnAnyThread(), MaxThreads);
+
+        double BgraSingleMs = 0.0;
+        double LumaSingleMs = 0.0;
+        FCamera2LumaStats Stats;
+        TArray<int32> ThreadCounts;
+        for (int32 Workers = 1; Workers < MaxThreads; Workers *= 2)
+        {
+            ThreadCounts.Add(Workers);
+        }
+        ThreadCounts.Add(MaxThreads);
+
+        for (const int32 Workers : ThreadCounts)
+        {
+            const double BgraMs = MeasureMs(Iterations, [&]()
+                {
+                    ParallelForRowTiles(Height, Width, Width * 4, [&](int32 RowBegin, int32 RowEnd)
+                        {
+                            ConvertBgraRows(Planes, Bgra.GetData(), Width * 4, RowBegin, RowEnd);
+                        }, Workers);
+                });
+            const double LumaMs = MeasureMs(Iterations, [&]()
+                {
+                    ParallelForRowTiles(Height, Width, Width, [&](int32 RowBegin, int32 RowEnd)
+                        {
+                            ConvertLumaRows(Planes, Luma.GetData(), Width, RowBegin, RowEnd);
+                        }, Workers);
+                });
+
+            const double StatsMs = MeasureMs(Iterations, [&]()
+                {
+                    ComputeLumaStatsTiled(Planes.Y, Width, Height, Planes.YRowStride, 1, 1, Stats, Workers);
+                });
+            const double SampledStatsMs = MeasureMs(Iterations, [&]()
+                {
+                    ComputeLumaStatsTiled(Planes.Y, Width, Height, Planes.YRowStride, 1, 2, Stats, Workers);
+                });
+
+            if (Workers == 1)
+            {
+                BgraSingleMs = BgraMs;
+                LumaSingleMs = LumaMs;
+            }
+            UE_LOG(LogSimpleCamera2, Display, TEXT("  %2d threads: BGRA %6.3f ms (x%.2f)  luma %6.3f ms (x%.2f)  stats %6.3f ms (%.0f%% of BGRA), step 2 %6.3f ms (%.0f%%)"),
+                Workers, BgraMs, BgraSingleMs / FMath::Max(BgraMs, 1e-6), LumaMs, LumaSingleMs / FMath::Max(LumaMs, 1e-6),
+                StatsMs, 100.0 * StatsMs / FMath::Max(BgraMs, 1e-6), SampledStatsMs, 100.0 * SampledStatsMs / FMath::Max(BgraMs, 1e-6));
+        }
+    }
+
+    void RunRemapBenchmark(int32 Iterations, int32 Width, int32 Height, float Scale)
+    {
+        TArray<uint8> YPlane;
+        TArray<uint8> UVPlane;
+        const FCamera2YuvPlanes Planes = MakeSyntheticFrame(Width, Height, YPlane, UVPlane);
+
+        // Wide-angle barrel lens in the range of the Quest 3 passthrough cameras
+        const FCamera2LensModel Lens = FCamera2LensModel::Make(0.68f * Width, 0.68f * Width,
+            (Width - 1) * 0.5f, (Height - 1) * 0.5f, Width, Height, { -0.1f, 0.02f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f });
+
+        const double BuildStart = FPlatformTime::Seconds();
+        FCamera2RemapLUT Lut;
+        Lut.Build(Lens, Scale);
+        const double BuildMs = (FPlatformTime::Seconds() - BuildStart) * 1000.0;
+        FCamera2RemapLUT FullLut;
+        FullLut.Build(Lens, 1.0f);
+
+        const int32 OutWidth = Lut.GetOutputWidth();
+        const int32 OutHeight = Lut.GetOutputHeight();
+        if (OutWidth < 1 || OutHeight < 1)
+        {
+            UE_LOG(LogSimpleCamera2, Error, TEXT("Remap benchmark: could not build a LUT for %dx%d at scale %.2f"), Width, Height, Scale);
+            return;
+        }
+
+        UE_LOG(LogSimpleCamera2, Display, TEXT("Remap benchmark: %dx%d -> %dx%d (scale %.2f), %d iterations, LUT built in %.1f ms"),
+            Width, Height, OutWidth, OutHeight, Lut.GetScale(), Iterations, BuildMs);
+
+        const int64 SourcePixels = static_cast<int64>(Width) * Height;
+        const int64 OutPixels = static_cast<int64>(OutWidth) * OutHeight;
+        const int64 EntryBytes = sizeof(FCamera2RemapLUT::FEntry);
+
+        const auto RunFormat = [&](const TCHAR* Label, int32 Channels, int64 PlaneBytes,
+            TFunctionRef<void(uint8*)> Fused, TFunctionRef<void(uint8*)> Convert)
+        {
+            TArray<uint8> Converted;
+            TArray<uint8> Undistorted;
+            TArray<uint8> Output;
+            Converted.SetNumUninitialized(SourcePixels * Channels);
+            Undistorted.SetNumUninitialized(SourcePixels * Channels);
+            Output.SetNumUninitialized(OutPixels * Channels);
+
+            const double FusedMs = MeasureMs(Iterations, [&]() { Fused(Output.GetData()); });
+            const double ConvertMs = MeasureMs(Iterations, [&]() { Convert(Converted.GetData()); });
+            const double UndistortMs = MeasureMs(Iterations, [&]()
+                {
+                    ParallelForRowTiles(Height, Width, Width * Channels, [&](int32 RowBegin, int32 RowEnd)
+                        {
+                            if (Channels == 4)
+                            {
+                                RemapPackedRows<4>(Converted.GetData(), Width * 4, FullLut, Undistorted.GetData(), Width * 4, RowBegin, RowEnd);
+                            }
+                            else
+                            {
+                                RemapPackedRows<1>(Converted.GetData(), Width, FullLut, Undistorted.GetData(), Width, RowBegin, RowEnd);
+                            }
+                        });
+                });
+            const double ResizeMs = MeasureMs(Iterations, [&]()
+                {
+                    ParallelForRowTiles(OutHeight, OutWidth, OutWidth * Channels, [&](int32 RowBegin, int32 RowEnd)
+                        {
+                            if (Channels == 4)
+                            {
+                                ResizeBilinearRows<4>(Undistorted.GetData(), Width, Height, Width * 4,
+                                    Output.GetData(), OutWidth, OutHeight, OutWidth * 4, RowBegin, RowEnd);
+                            }
+                            else
+                            {
+                                ResizeBilinearRows<1>(Undistorted.GetData(), Width, Height, Width,
+                                    Output.GetData(), OutWidth, OutHeight, OutWidth, RowBegin, RowEnd);
+                            }
+                        });
+                });
+            const double ChainMs = ConvertMs + UndistortMs + ResizeMs;
+
+            // Main-memory traffic per frame, assuming nothing survives in cache between passes
+            const double FusedMB = (PlaneBytes + OutPixels * (EntryBytes + Channels)) / (1024.0 * 1024.0);
+            const double ChainMB = (PlaneBytes + SourcePixels * Channels                // convert
+                + SourcePixels * (EntryBytes + 2 * Channels)                            // undistort
+                + SourcePixels * Channels + OutPixels * Channels) / (1024.0 * 1024.0);  // resize
+
+            UE_LOG(LogSimpleCamera2, Display,
+                TEXT("  %s: fused %6.3f ms (~%.1f MB)  unfused %6.3f ms (~%.1f MB: convert %.3f + undistort %.3f + resize %.3f)  x%.2f"),
+                Label, FusedMs, FusedMB, ChainMs, ChainMB, ConvertMs, UndistortMs, ResizeMs, ChainMs / FMath::Max(FusedMs, 1e-6));
+        };
+
+        RunFormat(TEXT("BGRA"), 4, SourcePixels * 3 / 2,
+            [&](uint8* Dst) { RemapYuvToBgra(Planes, Lut, Dst, OutWidth * 4); },
+            [&](uint8* Dst) { ConvertYuvToBgra(Planes, Dst, Width * 4); });
+        RunFormat(TEXT("luma"), 1, SourcePixels,
+            [&](uint8* Dst) { RemapYuvToLuma(Planes, Lut, Dst, OutWidth); },
+            [&](uint8* Dst) { ConvertYuvToLuma(Planes, Dst, Width); });
+    }
+
+    void RunFanOutBenchmark(int32 Iterations, int32 Width, int32 Height)
+    {
+        TArray<uint8> YPlane;
+        TArray<uint8> UVPlane;
+        const FCamera2YuvPlanes Planes = MakeSyntheticFrame(Width, Height, YPlane, UVPlane);
+
+        // The outputs of the fan-out example: full-resolution BGRA, quarter-resolution BGRA thumbnail, undistorted luma
+        const FCamera2LensModel Lens = FCamera2LensModel::Make(0.68f * Width, 0.68f * Width,
+            (Width - 1) * 0.5f, (Height - 1) * 0.5f, Width, Height, { -0.1f, 0.02f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f });
+        FCamera2LensModel PlainLens = Lens;
+        PlainLens.K1 = PlainLens.K2 = 0.0f;
+        PlainLens.MaxRadius2 = 0.0f;
+
+        FCamera2RemapLUT Luts[3];
+        Luts[0].Build(PlainLens, 1.0f);
+        Luts[1].Build(PlainLens, 0.25f);
+        Luts[2].Build(Lens, 0.5f);
+        const bool bLuma[3] = { false, false, true };
+
+        TArray<uint8> Outputs[3];
+        TArray<FCamera2RemapTarget, TInlineAllocator<3>> Targets;
+        for (int32 Index = 0; Index < 3; ++Index)
+        {
+            const int32 BytesPerPixel = bLuma[Index] ? 1 : 4;
+            Outputs[Index].SetNumUninitialized(Luts[Index].GetOutputWidth() * Luts[Index].GetOutputHeight() * BytesPerPixel);
+            FCamera2RemapTarget& Target = Targets.AddDefaulted_GetRef();
+            Target.Planes = Planes;
+            Target.Lut = &Luts[Index];
+            Target.Dst = Outputs[Index].GetData();
+            Target.DstStride = Luts[Index].GetOutputWidth() * BytesPerPixel;
+            Target.bLuma = bLuma[Index];
+        }
+
+        const double FusedMs = MeasureMs(Iterations, [&]() { RemapYuvMulti(Targets); });
+        const double SeparateMs = MeasureMs(Iterations, [&]()
+            {
+                for (const FCamera2RemapTarget& Target : Targets)
+                {
+                    if (Target.bLuma)
+                    {
+                        RemapYuvToLuma(Target.Planes, *Target.Lut, Target.Dst, Target.DstStride);
+                    }
+                    else
+                    {
+                        RemapYuvToBgra(Target.Planes, *Target.Lut, Target.Dst, Target.DstStride);
+                    }
+                }
+            });
+
+        UE_LOG(LogSimpleCamera2, Display,
+            TEXT("Fan-out benchmark: %dx%d -> %dx%d BGRA + %dx%d BGRA + %dx%d undistorted luma, %d iterations: one pass %.3f ms, per output %.3f ms, x%.2f"),
+            Width, Height, Luts[0].GetOutputWidth(), Luts[0].GetOutputHeight(), Luts[1].GetOutputWidth(), Luts[1].GetOutputHeight(),
+            Luts[2].GetOutputWidth(), Luts[2].GetOutputHeight(), Iterations, FusedMs, SeparateMs, SeparateMs / FMath::Max(FusedMs, 1e-6));
+    }
+
+    bool RunMipBenchmark(int32 Iterations, int32 Width, int32 Height)
+    {
+        // The vector kernel must match the scalar reference bit for bit, including odd and degenerate sizes
+        const FIntPoint Sizes[] = { FIntPoint(Width, Height), FIntPoint(Width + 3, Height + 1), FIntPoint(37, 5), FIntPoint(1, 9), FIntPoint(9, 1) };
+        FRandomStream Random(4321);
+        int32 Mismatches = 0;
+        for (const FIntPoint& Size : Sizes)
+        {
+            for (const int32 BytesPerPixel : { 4, 1 })
+            {
+                const int32 NumMips = GetNumMips(Size.X, Size.Y);
+                TArray<uint8> Vector;
+                TArray<uint8> Scalar;
+                Vector.SetNumUninitialized(GetMipChainBytes(Size.X, Size.Y, BytesPerPixel, NumMips));
+                for (uint8& Byte : Vector)
+                {
+                    Byte = static_cast<uint8>(Random.RandHelper(256));
+                }
+                Scalar = Vector;
+                BuildMipChainWith<true>(Vector.GetData(), Size.X, Size.Y, BytesPerPixel, NumMips);
+                BuildMipChainWith<false>(Scalar.GetData(), Size.X, Size.Y, BytesPerPixel, NumMips);
+                if (FMemory::Memcmp(Vector.GetData(), Scalar.GetData(), Vector.Num()) != 0)
+                {
+                    ++Mismatches;
+                    UE_LOG(LogSimpleCamera2, Error, TEXT("Mip benchmark: vector and scalar chains differ for %dx%d x%d"),
+                        Size.X, Size.Y, BytesPerPixel);
+                }
+            }
+        }
+
+        TArray<uint8> YPlane;
+        TArray<uint8> UVPlane;
+        const FCamera2YuvPlanes Planes = MakeSyntheticFrame(Width, Height, YPlane, UVPlane);
+        const int32 NumMips = GetNumMips(Width, Height);
+        TArray<uint8> Chain;
+        Chain.SetNumUninitialized(GetMipChainBytes(Width, Height, 4, NumMips));
+        ConvertYuvToBgra(Planes, Chain.GetData(), Width * 4);
+
+        const double ConvertMs = MeasureMs(Iterations, [&]() { ConvertYuvToBgra(Planes, Chain.GetData(), Width * 4); });
+        const double ScalarMs = MeasureMs(Iterations, [&]() { BuildMipChainWith<false>(Chain.GetData(), Width, Height, 4, NumMips, 1); });
+        const double VectorMs = MeasureMs(Iterations, [&]() { BuildMipChainWith<true>(Chain.GetData(), Width, Height, 4, NumMips, 1); });
+        const double ParallelMs = MeasureMs(Iterations, [&]() { BuildMipChain(Chain.GetData(), Width, Height, 4, NumMips); });
+
+        const bool bPassed = Mismatches == 0;
+        UE_LOG(LogSimpleCamera2, Display,
+            TEXT("Mip benchmark %s: %dx%d BGRA, %d levels (+%.0f%% upload bytes), %d iterations: convert %.3f ms, chain scalar %.3f ms, vector %.3f ms (x%.2f), vector parallel %.3f ms (%.0f%% of convert)"),
+            bPassed ? TEXT("PASSED") : TEXT("FAILED"), Width, Height, NumMips,
+            100.0 * (GetMipChainBytes(Width, Height, 4, NumMips) - static_cast<int64>(Width) * Height * 4) / (static_cast<double>(Width) * Height * 4),
+            Iterations, ConvertMs, ScalarMs, VectorMs, ScalarMs / FMath::Max(VectorMs, 1e-6), ParallelMs, 100.0 * ParallelMs / FMath::Max(ConvertMs, 1e-6));
+        return bPassed;
+    }
+}
+
+static FAutoConsoleCommand GCamera2ConvertBenchmarkCommand(
+    TEXT("Camera2.Convert.Benchmark"),
+    TEXT("Time YUV->BGRA/luma conversion with 1..N threads. Args: [Iterations=100] [Width=1280] [Height=1280]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const int32 Iterations = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100;
+        const int32 Width = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 1280;
+        const int32 Height = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 1280;
+        Camera2ImageConversion::RunBenchmark(FMath::Max(Iterations, 1), FMath::Max(Width, 2), FMath::Max(Height, 2));
+    }));
+
+static FAutoConsoleCommand GCamera2RemapBenchmarkCommand(
+    TEXT("Camera2.Convert.RemapBenchmark"),
+    TEXT("Time the fused convert+undistort+downscale kernel against the three-pass chain. Args: [Iterations=100] [Scale=0.5] [Width=1280] [Height=960]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const int32 Iterations = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100;
+        const float Scale = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 0.5f;
+        const int32 Width = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 1280;
+        const int32 Height = Args.Num() > 3 ? FCString::Atoi(*Args[3]) : 960;
+        Camera2ImageConversion::RunRemapBenchmark(FMath::Max(Iterations, 1), FMath::Max(Width, 2), FMath::Max(Height, 2),
+            Scale > 0.0f ? Scale : 0.5f);
+    }));
+
+static FAutoConsoleCommand GCamera2FanOutBenchmarkCommand(
+    TEXT("Camera2.Convert.FanOutBenchmark"),
+    TEXT("Time producing several stream outputs in one pass against one pass per output. Args: [Iterations=100] [Width=1280] [Height=960]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const int32 Iterations = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100;
+        const int32 Width = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 1280;
+        const int32 Height = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 960;
+        Camera2ImageConversion::RunFanOutBenchmark(FMath::Max(Iterations, 1), FMath::Max(Width, 16), FMath::Max(Height, 16));
+    }));
+
+static FAutoConsoleCommand GCamera2MipBenchmarkCommand(
+    TEXT("Camera2.Texture.MipBenchmark"),
+    TEXT("Validate the SIMD 2x2 mip kernel against the scalar one and time a BGRA mip chain. Args: [Iterations=100] [Width=1280] [Height=960]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const int32 Iterations = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100;
+        const int32 Width = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 1280;
+        const int32 Height = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 960;
+        Camera2ImageConversion::RunMipBenchmark(FMath::Max(Iterations, 1), FMath::Max(Width, 2), FMath::Max(Height, 2));
+    }));
@@ -0,0 +1,522 @@
+#include "Camera2MediaPlayer.h"
+#include "Camera2FramePipeline.h"
+#include "Camera2ImageConversion.h"
+#include "Camera2Stream.h"
+#include "Camera2Subsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "IMediaEventSink.h"
+#include "IMediaTextureSample.h"
+#include "MediaObjectPool.h"
+#include "MediaSamples.h"
+#include "MediaShaders.h"
+#include <atomic>
+
+#define LOCTEXT_NAMESPACE "Camera2MediaPlayer"
+
+static TAutoConsoleVariable<int32> CVarCamera2MediaMaxQueuedSamples(
+    TEXT("Camera2.Media.MaxQueuedSamples"),
+    3,
+    TEXT("Video samples a camera media player queues before it drops new frames."),
+    ECVF_Default);
+
+namespace Camera2Media
+{
+    static const TCHAR* UrlScheme = TEXT("camera2://");
+    static const FGuid PlayerPluginGUID(0x6b7c2f14, 0x3a9e4d21, 0x8f0b5c77, 0x1e2d9a63);
+    constexpr float ReplayFrameRate = 30.0f;
+}
+
+// =============================================================================
+// SAMPLES
+// =============================================================================
+
+/** CPU texture sample; the buffer is kept when the sample returns to the pool. */
+class FCamera2MediaTextureSample : public IMediaTextureSample, public IMediaPoolable
+{
+public:
+    /**
+     * Size the buffer for a frame and return where to write it (GetStride bytes per row). NV12 is Y rows
+     * then interleaved UV rows at one stride, rounded up to even so an odd width's last U,V pair fits.
+     */
+    uint8* Initialize(bool bInNv12, FIntPoint InOutputDim, FTimespan InTime, FTimespan InDuration)
+    {
+        bNv12 = bInNv12;
+        OutputDim = InOutputDim;
+        Dim = bNv12 ? FIntPoint(Align(OutputDim.X, 2), OutputDim.Y + (OutputDim.Y + 1) / 2) : OutputDim;
+        Stride = bNv12 ? Dim.X : OutputDim.X * 4;
+        Time = InTime;
+        Duration = InDuration;
+        Buffer.SetNumUninitialized(static_cast<int64>(Stride) * Dim.Y, EAllowShrinking::No);
+        return Buffer.GetData();
+    }
+
+    //~ IMediaTextureSample
+    virtual const void* GetBuffer() override { return Buffer.GetData(); }
+    virtual FIntPoint GetDim() const override { return Dim; }
+    virtual FTimespan GetDuration() const override { return Duration; }
+    virtual EMediaTextureSampleFormat GetFormat() const override
+    {
+        return bNv12 ? EMediaTextureSampleFormat::CharNV12 : EMediaTextureSampleFormat::CharBGRA;
+    }
+    virtual FIntPoint GetOutputDim() const override { return OutputDim; }
+    virtual uint32 GetStride() const override { return static_cast<uint32>(Stride); }
+    virtual FMediaTimeStamp GetTime() const override { return FMediaTimeStamp(Time); }
+    virtual bool IsCacheable() const override { return true; }
+    virtual bool IsOutputSrgb() const override { return true; }
+    // Camera YUV is full-range BT.601, like Camera2ImageConversion
+    virtual const FMatrix& GetYUVToRGBMatrix() const override { return MediaShaders::YuvToRgbRec601Unscaled; }
+
+private:
+    TArray<uint8> Buffer;
+    FIntPoint Dim = FIntPoint::ZeroValue;
+    FIntPoint OutputDim = FIntPoint::ZeroValue;
+    int32 Stride = 0;
+    bool bNv12 = false;
+    FTimespan Time;
+    FTimespan Duration;
+};
+
+/**
+ * Writes frames into pooled samples on the delivering thread. Shared with the stream as a frame
+ * sink, so it may outlive its player by one frame; the samples queue is shared for the same reason.
+ */
+class FCamera2MediaSampleWriter : public ICamera2FrameSink
+{
+public:
+    FCamera2MediaSampleWriter(const TSharedRef<FMediaSamples, ESPMode::ThreadSafe>& InSamples, bool bInNv12, double InClockOrigin)
+        : Samples(InSamples)
+        , bNv12(bInNv12)
+        , ClockOrigin(InClockOrigin)
+    {
+    }
+
+    virtual void ReceiveYuvFrame(const FCamera2YuvPlanes& Planes, const FCamera2FrameMetadata& Metadata) override
+    {
+        TSharedPtr<FCamera2MediaTextureSample, ESPMode::ThreadSafe> Sample = AcquireSample();
+        if (!Sample.IsValid())
+        {
+            return;
+        }
+
+        uint8* Dst = Sample->Initialize(bNv12, FIntPoint(Planes.Width, Planes.Height), GetSampleTime(Metadata), GetSampleDuration(Metadata));
+        if (bNv12)
+        {
+            Camera2ImageConversion::ConvertYuvToNv12(Planes, Dst, Sample->GetStride());
+        }
+        else
+        {
+            Camera2ImageConversion::ConvertYuvToBgra(Planes, Dst, Sample->GetStride());
+        }
+        Samples->AddVideo(Sample.ToSharedRef());
+        ++SamplesWritten;
+    }
+
+    virtual void ReceiveBgraFrame(const uint8* Bgra, int32 Width, int32 Height, const FCamera2FrameMetadata& Metadata) override
+    {
+        TSharedPtr<FCamera2MediaTextureSample, ESPMode::ThreadSafe> Sample = AcquireSample();
+        if (!Sample.IsValid())
+        {
+            return;
+        }
+
+        // No planes to repack, so these stay BGRA whatever the requested format
+        uint8* Dst = Sample->Initialize(false, FIntPoint(Width, Height), GetSampleTime(Metadata), GetSampleDuration(Metadata));
+        FMemory::Memcpy(Dst, Bgra, static_cast<int64>(Width) * Height * 4);
+        Samples->AddVideo(Sample.ToSharedRef());
+        ++SamplesWritten;
+    }
+
+    std::atomic<bool> bPlaying{ false };
+    std::atomic<int64> SamplesWritten{ 0 };
+    // Not queued because the media texture was not keeping up (or playback was paused)
+    std::atomic<int64> SamplesDropped{ 0 };
+
+private:
+    TSharedPtr<FCamera2MediaTextureSample, ESPMode::ThreadSafe> AcquireSample()
+    {
+        if (!bPlaying.load(std::memory_order_relaxed)
+            || Samples->NumVideoSamples() >= FMath::Max(CVarCamera2MediaMaxQueuedSamples.GetValueOnAnyThread(), 1))
+        {
+            ++SamplesDropped;
+            return nullptr;
+        }
+        return SamplePool.AcquireShared();
+    }
+
+    FTimespan GetSampleTime(const FCamera2FrameMetadata& Metadata) const
+    {
+        const double CaptureTime = Metadata.EngineTimestamp > 0.0 ? Metadata.EngineTimestamp : FPlatformTime::Seconds();
+        return FTimespan::FromSeconds(FMath::Max(CaptureTime - ClockOrigin, 0.0));
+    }
+
+    static FTimespan GetSampleDuration(const FCamera2FrameMetadata& Metadata)
+    {
+        return Metadata.FrameDurationNs > 0
+            ? FTimespan(Metadata.FrameDurationNs / ETimespan::NanosecondsPerTick)
+            : FTimespan::FromSeconds(1.0 / Camera2Media::ReplayFrameRate);
+    }
+
+    TSharedRef<FMediaSamples, ESPMode::ThreadSafe> Samples;
+    TMediaObjectPool<FCamera2MediaTextureSample> SamplePool;
+    const bool bNv12;
+    const double ClockOrigin;
+};
+
+// =============================================================================
+// PLAYER
+// =============================================================================
+
+FCamera2MediaPlayer::FCamera2MediaPlayer(IMediaEventSink& InEventSink)
+    : EventSink(InEventSink)
+    , Samples(MakeShared<FMediaSamples, ESPMode::ThreadSafe>())
+{
+}
+
+FCamera2MediaPlayer::~FCamera2MediaPlayer()
+{
+    Close();
+}
+
+bool FCamera2MediaPlayer::IsCameraUrl(const FString& InUrl)
+{
+    return InUrl.StartsWith(Camera2Media::UrlScheme, ESearchCase::IgnoreCase);
+}
+
+bool FCamera2MediaPlayer::Open(const FString& InUrl, const IMediaOptions* Options)
+{
+    check(IsInGameThread());
+    Close();
+
+    if (!IsCameraUrl(InUrl))
+    {
+        return false;
+    }
+
+    // camera2://<StreamId>[?format=nv12|bgra][&replay=<dir>]
+    FString Path = InUrl.RightChop(FCString::Strlen(Camera2Media::UrlScheme));
+    FString Query;
+    Path.Split(TEXT("?"), &Path, &Query);
+    FString ReplayDirectory;
+    bNv12 = true;
+    TArray<FString> Params;
+    Query.ParseIntoArray(Params, TEXT("&"));
+    for (const FString& Param : Params)
+    {
+        FString Key;
+        FString Value;
+        if (!Param.Split(TEXT("="), &Key, &Value))
+        {
+            continue;
+        }
+        if (Key.Equals(TEXT("format"), ESearchCase::IgnoreCase))
+        {
+            bNv12 = !Value.Equals(TEXT("bgra"), ESearchCase::IgnoreCase);
+        }
+        else if (Key.Equals(TEXT("replay"), ESearchCase::IgnoreCase))
+        {
+            ReplayDirectory = Value;
+        }
+    }
+    StreamId = Path.IsEmpty() ? UCamera2Subsystem::DefaultStreamId : FCString::Atoi(*Path);
+
+    UCamera2Subsystem* Subsystem = UCamera2Subsystem::Get();
+    TSharedPtr<FCameraStream, ESPMode::ThreadSafe> CameraStream;
+    if (Subsystem)
+    {
+        CameraStream = StreamId == UCamera2Subsystem::DefaultStreamId ? Subsystem->GetOrCreateDefaultStream() : Subsystem->FindStream(StreamId);
+    }
+    Resolution = CameraStream.IsValid() ? CameraStream->GetResolution() : FIntPoint(1280, 960);
+    ClockOrigin = FPlatformTime::Seconds();
+    PausedTime = FTimespan::Zero();
+
+#if PLATFORM_ANDROID
+    if (!CameraStream.IsValid())
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("Media player: no camera stream %d for %s"), StreamId, *InUrl);
+        return false;
+    }
+    if (!CameraStream->IsActive())
+    {
+        if (!CameraStream->Start())
+        {
+            UE_LOG(LogSimpleCamera2, Error, TEXT("Media player: failed to start camera stream %d"), StreamId);
+            return false;
+        }
+        bStartedStream = true;
+    }
+    Writer = MakeShared<FCamera2MediaSampleWriter, ESPMode::ThreadSafe>(Samples, bNv12, ClockOrigin);
+    CameraStream->AddFrameSink(Writer.ToSharedRef());
+    Stream = CameraStream;
+#else
+    // No camera: replay recorded or generated BGRA frames at the stream's resolution
+    bNv12 = false;
+    Replay = MakeUnique<FCamera2ReplaySource>(Resolution.X, Resolution.Y);
+    if (!ReplayDirectory.IsEmpty())
+    {
+        Replay->LoadDirectory(ReplayDirectory);
+    }
+    NextReplayTime = ClockOrigin;
+    Writer = MakeShared<FCamera2MediaSampleWriter, ESPMode::ThreadSafe>(Samples, false, ClockOrigin);
+#endif
+
+    Url = InUrl;
+    State = EMediaState::Stopped;
+    UE_LOG(LogSimpleCamera2, Log, TEXT("Media player: opened %s (%s %dx%d%s)"), *Url, bNv12 ? TEXT("NV12") : TEXT("BGRA"),
+        Resolution.X, Resolution.Y, Replay.IsValid() ? TEXT(", replay") : TEXT(""));
+
+    EventSink.ReceiveMediaEvent(EMediaEvent::TracksChanged);
+    EventSink.ReceiveMediaEvent(EMediaEvent::MediaOpened);
+    return true;
+}
+
+bool FCamera2MediaPlayer::Open(const TSharedRef<FArchive, ESPMode::ThreadSafe>& Archive, const FString& OriginalUrl,
+    const IMediaOptions* Options)
+{
+    // A live camera cannot be read from an archive
+    return false;
+}
+
+void FCamera2MediaPlayer::Close()
+{
+    if (State == EMediaState::Closed)
+    {
+        return;
+    }
+
+    if (Writer.IsValid())
+    {
+        Writer->bPlaying = false;
+        if (TSharedPtr<FCameraStream, ESPMode::ThreadSafe> CameraStream = Stream.Pin())
+        {
+            CameraStream->RemoveFrameSink(Writer.ToSharedRef());
+            if (bStartedStream)
+            {
+                CameraStream->Stop();
+            }
+        }
+    }
+    Writer.Reset();
+    Stream.Reset();
+    bStartedStream = false;
+    Replay.Reset();
+    Samples->FlushSamples();
+
+    Url.Empty();
+    State = EMediaState::Closed;
+    EventSink.ReceiveMediaEvent(EMediaEvent::TracksChanged);
+    EventSink.ReceiveMediaEvent(EMediaEvent::MediaClosed);
+}
+
+void FCamera2MediaPlayer::TickInput(FTimespan DeltaTime, FTimespan Timecode)
+{
+    if (!Replay.IsValid() || State != EMediaState::Playing)
+    {
+        return;
+    }
+
+    // One replayed frame per tick at most, on a 30 fps cadence; late ticks skip frames rather than burst
+    const double Now = FPlatformTime::Seconds();
+    if (Now < NextReplayTime)
+    {
+        return;
+    }
+    NextReplayTime = FMath::Max(NextReplayTime + 1.0 / Camera2Media::ReplayFrameRate, Now);
+
+    FCamera2PipelineBuffer Frame;
+    FCamera2FrameMetadata Metadata;
+    Replay->NextFrame(Frame, Metadata);
+    Writer->ReceiveBgraFrame(Frame.Data.GetData(), Frame.Width, Frame.Height, Metadata);
+}
+
+FString FCamera2MediaPlayer::GetInfo() const
+{
+    return FString::Printf(TEXT("Camera2 stream %d, %dx%d %s%s"), StreamId, Resolution.X, Resolution.Y,
+        bNv12 ? TEXT("NV12") : TEXT("BGRA"), Replay.IsValid() ? TEXT(" (replay)") : TEXT(""));
+}
+
+FGuid FCamera2MediaPlayer::GetPlayerPluginGUID() const
+{
+    return Camera2Media::PlayerPluginGUID;
+}
+
+IMediaSamples& FCamera2MediaPlayer::GetSamples()
+{
+    return *Samples;
+}
+
+FString FCamera2MediaPlayer::GetStats() const
+{
+    if (!Writer.IsValid())
+    {
+        return TEXT("closed");
+    }
+    return FString::Printf(TEXT("samples written %lld, dropped %lld, queued %d"),
+        Writer->SamplesWritten.load(), Writer->SamplesDropped.load(), Samples->NumVideoSamples());
+}
+
+// =============================================================================
+// CONTROLS
+// =============================================================================
+
+bool FCamera2MediaPlayer::CanControl(EMediaControl Control) const
+{
+    return State != EMediaState::Closed && (Control == EMediaControl::Pause || Control == EMediaControl::Resume);
+}
+
+float FCamera2MediaPlayer::GetRate() const
+{
+    return State == EMediaState::Playing ? 1.0f : 0.0f;
+}
+
+TRangeSet<float> FCamera2MediaPlayer::GetSupportedRates(EMediaRateThinning Thinning) const
+{
+    TRangeSet<float> Rates;
+    Rates.Add(TRange<float>(0.0f));
+    Rates.Add(TRange<float>(1.0f));
+    return Rates;
+}
+
+FTimespan FCamera2MediaPlayer::GetTime() const
+{
+    // Live clock: frames are stamped with their capture time and are due as soon as they arrive
+    return State == EMediaState::Playing ? FTimespan::FromSeconds(FPlatformTime::Seconds() - ClockOrigin) : PausedTime;
+}
+
+bool FCamera2MediaPlayer::SetRate(float Rate)
+{
+    if (State == EMediaState::Closed || (Rate != 0.0f && Rate != 1.0f))
+    {
+        return false;
+    }
+
+    const bool bPlay = Rate == 1.0f;
+    if (bPlay == (State == EMediaState::Playing))
+    {
+        return true;
+    }
+
+    if (!bPlay)
+    {
+        PausedTime = GetTime();
+    }
+    State = bPlay ? EMediaState::Playing : EMediaState::Paused;
+    Writer->bPlaying = bPlay;
+    EventSink.ReceiveMediaEvent(bPlay ? EMediaEvent::PlaybackResumed : EMediaEvent::PlaybackSuspended);
+    return true;
+}
+
+// =============================================================================
+// TRACKS
+// =============================================================================
+
+bool FCamera2MediaPlayer::IsVideoTrack(EMediaTrackType TrackType, int32 TrackIndex) const
+{
+    return State != EMediaState::Closed && TrackType == EMediaTrackType::Video && TrackIndex == 0;
+}
+
+int32 FCamera2MediaPlayer::GetNumTracks(EMediaTrackType TrackType) const
+{
+    return State != EMediaState::Closed && TrackType == EMediaTrackType::Video ? 1 : 0;
+}
+
+int32 FCamera2MediaPlayer::GetNumTrackFormats(EMediaTrackType TrackType, int32 TrackIndex) const
+{
+    return IsVideoTrack(TrackType, TrackIndex) ? 1 : 0;
+}
+
+int32 FCamera2MediaPlayer::GetSelectedTrack(EMediaTrackType TrackType) const
+{
+    return GetNumTracks(TrackType) > 0 ? 0 : INDEX_NONE;
+}
+
+FText FCamera2MediaPlayer::GetTrackDisplayName(EMediaTrackType TrackType, int32 TrackIndex) const
+{
+    return IsVideoTrack(TrackType, TrackIndex)
+        ? FText::Format(LOCTEXT("VideoTrackDisplayName", "Camera stream {0}"), FText::AsNumber(StreamId))
+        : FText::GetEmpty();
+}
+
+int32 FCamera2MediaPlayer::GetTrackFormat(EMediaTrackType TrackType, int32 TrackIndex) const
+{
+    return IsVideoTrack(TrackType, TrackIndex) ? 0 : INDEX_NONE;
+}
+
+FString FCamera2MediaPlayer::GetTrackName(EMediaTrackType TrackType, int32 TrackIndex) const
+{
+    return IsVideoTrack(TrackType, TrackIndex) ? FString::Printf(TEXT("Camera%d"), StreamId) : FString();
+}
+
+bool FCamera2MediaPlayer::GetVideoTrackFormat(int32 TrackIndex, int32 FormatIndex, FMediaVideoTrackFormat& OutFormat) const
+{
+    if (!IsVideoTrack(EMediaTrackType::Video, TrackIndex) || FormatIndex != 0)
+    {
+        return false;
+    }
+
+    OutFormat.Dim = Resolution;
+    OutFormat.FrameRate = Camera2Media::ReplayFrameRate;
+    OutFormat.FrameRates = TRange<float>(Camera2Media::ReplayFrameRate);
+    OutFormat.TypeName = bNv12 ? TEXT("NV12") : TEXT("BGRA");
+    return true;
+}
+
+bool FCamera2MediaPlayer::SelectTrack(EMediaTrackType TrackType, int32 TrackIndex)
+{
+    return IsVideoTrack(TrackType, TrackIndex);
+}
+
+bool FCamera2MediaPlayer::SetTrackFormat(EMediaTrackType TrackType, int32 TrackIndex, int32 FormatIndex)
+{
+    return IsVideoTrack(TrackType, TrackIndex) && FormatIndex == 0;
+}
+
+// =============================================================================
+// FACTORY
+// =============================================================================
+
+FCamera2MediaPlayerFactory::FCamera2MediaPlayerFactory()
+{
+    SupportedPlatforms = { TEXT("Android"), TEXT("Windows"), TEXT("Linux"), TEXT("Mac") };
+}
+
+bool FCamera2MediaPlayerFactory::CanPlayUrl(const FString& Url, const IMediaOptions* Options, TArray<FText>* OutWarnings,
+    TArray<FText>* OutErrors) const
+{
+    if (!FCamera2MediaPlayer::IsCameraUrl(Url))
+    {
+        if (OutErrors)
+        {
+            OutErrors->Add(LOCTEXT("UnsupportedScheme", "Only camera2:// URLs are supported"));
+        }
+        return false;
+    }
+    return true;
+}
+
+TSharedPtr<IMediaPlayer, ESPMode::ThreadSafe> FCamera2MediaPlayerFactory::CreatePlayer(IMediaEventSink& EventSink)
+{
+    return MakeShared<FCamera2MediaPlayer, ESPMode::ThreadSafe>(EventSink);
+}
+
+FText FCamera2MediaPlayerFactory::GetDisplayName() const
+{
+    return LOCTEXT("FactoryDisplayName", "Camera2 Stream");
+}
+
+FName FCamera2MediaPlayerFactory::GetPlayerName() const
+{
+    static const FName PlayerName(TEXT("Camera2Media"));
+    return PlayerName;
+}
+
+FGuid FCamera2MediaPlayerFactory::GetPlayerPluginGUID() const
+{
+    return Camera2Media::PlayerPluginGUID;
+}
+
+bool FCamera2MediaPlayerFactory::SupportsFeature(EMediaFeature Feature) const
+{
+    return Feature == EMediaFeature::VideoSamples || Feature == EMediaFeature::VideoTracks;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,290 @@
+#include "Camera2PoseHistory.h"
+#include "SimpleCamera2Test.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/ScopeLock.h"
+
+FCamera2PoseHistory::FCamera2PoseHistory(int32 InCapacity)
+{
+    Capacity = static_cast<int32>(FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(InCapacity, 4))));
+    IndexMask = static_cast<uint64>(Capacity - 1);
+    Slots = MakeUnique<FSlot[]>(Capacity);
+}
+
+bool FCamera2PoseHistory::Push(double TimeSeconds, const FTransform& Pose)
+{
+    FScopeLock Lock(&WriteLock);
+
+    if (TimeSeconds < LastPushedTime)
+    {
+        return false;
+    }
+    LastPushedTime = TimeSeconds;
+
+    const uint64 LogicalIndex = WriteCount.load(std::memory_order_relaxed);
+    FSlot& Slot = Slots[LogicalIndex & IndexMask];
+
+    // Mark the slot as in-flight before touching the payload
+    Slot.Sequence.store(2 * LogicalIndex + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const FQuat Rotation = Pose.GetRotation();
+    const FVector Translation = Pose.GetLocation();
+    Slot.Data[0].store(TimeSeconds, std::memory_order_relaxed);
+    Slot.Data[1].store(Rotation.X, std::memory_order_relaxed);
+    Slot.Data[2].store(Rotation.Y, std::memory_order_relaxed);
+    Slot.Data[3].store(Rotation.Z, std::memory_order_relaxed);
+    Slot.Data[4].store(Rotation.W, std::memory_order_relaxed);
+    Slot.Data[5].store(Translation.X, std::memory_order_relaxed);
+    Slot.Data[6].store(Translation.Y, std::memory_order_relaxed);
+    Slot.Data[7].store(Translation.Z, std::memory_order_relaxed);
+
+    Slot.Sequence.store(2 * (LogicalIndex + 1), std::memory_order_release);
+    WriteCount.store(LogicalIndex + 1, std::memory_order_release);
+    return true;
+}
+
+bool FCamera2PoseHistory::ReadSlot(uint64 LogicalIndex, FSampleData& Out) const
+{
+    const FSlot& Slot = Slots[LogicalIndex & IndexMask];
+    const uint64 Expected = 2 * (LogicalIndex + 1);
+
+    if (Slot.Sequence.load(std::memory_order_acquire) != Expected)
+    {
+        return false;
+    }
+
+    double Values[8];
+    for (int32 Index = 0; Index < 8; ++Index)
+    {
+        Values[Index] = Slot.Data[Index].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    // Overwritten while we were reading
+    if (Slot.Sequence.load(std::memory_order_relaxed) != Expected)
+    {
+        return false;
+    }
+
+    Out.Time = Values[0];
+    Out.Rotation = FQuat(Values[1], Values[2], Values[3], Values[4]);
+    Out.Translation = FVector(Values[5], Values[6], Values[7]);
+    return true;
+}
+
+bool FCamera2PoseHistory::GetTimeRange(double& OutOldest, double& OutNewest) const
+{
+    const uint64 Count = WriteCount.load(std::memory_order_acquire);
+    if (Count == 0)
+    {
+        return false;
+    }
+
+    FSampleData Newest;
+    if (!ReadSlot(Count - 1, Newest))
+    {
+        return false;
+    }
+
+    // Walk forward past slots that a concurrent writer may be recycling
+    const uint64 First = Count > static_cast<uint64>(Capacity) ? Count - Capacity : 0;
+    for (uint64 Index = First; Index < Count; ++Index)
+    {
+        FSampleData Oldest;
+        if (ReadSlot(Index, Oldest))
+        {
+            OutOldest = Oldest.Time;
+            OutNewest = Newest.Time;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FCamera2PoseHistory::Sample(double TimeSeconds, FTransform& OutPose, double MaxHoldSeconds) const
+{
+    const uint64 Count = WriteCount.load(std::memory_order_acquire);
+    if (Count == 0)
+    {
+        return false;
+    }
+
+    FSampleData Newest;
+    if (!ReadSlot(Count - 1, Newest))
+    {
+        return false;
+    }
+
+    if (TimeSeconds >= Newest.Time)
+    {
+        if (TimeSeconds - Newest.Time > MaxHoldSeconds)
+        {
+            return false;
+        }
+        OutPose = FTransform(Newest.Rotation, Newest.Translation);
+        return true;
+    }
+
+    // Binary search for the first sample newer than TimeSeconds. Slots that fail to read were
+    // recycled by the writer, which only happens at the old end, so treat them as too old.
+    const uint64 First = Count > static_cast<uint64>(Capacity) ? Count - Capacity : 0;
+    uint64 Low = First;
+    uint64 High = Count - 1;
+    while (Low < High)
+    {
+        const uint64 Mid = Low + (High - Low) / 2;
+        FSampleData MidSample;
+        if (!ReadSlot(Mid, MidSample) || MidSample.Time <= TimeSeconds)
+        {
+            Low = Mid + 1;
+        }
+        else
+        {
+            High = Mid;
+        }
+    }
+
+    FSampleData Before;
+    FSampleData After;
+    if (!ReadSlot(Low, After))
+    {
+        return false;
+    }
+    if (Low == First || !ReadSlot(Low - 1, Before))
+    {
+        // Older than every retained sample: After is the oldest one left
+        if (After.Time - TimeSeconds > MaxHoldSeconds)
+        {
+            return false;
+        }
+        OutPose = FTransform(After.Rotation, After.Translation);
+        return true;
+    }
+
+    const double Span = After.Time - Before.Time;
+    const double Alpha = Span > 0.0 ? FMath::Clamp((TimeSeconds - Before.Time) / Span, 0.0, 1.0) : 0.0;
+    OutPose = FTransform(
+        FQuat::Slerp(Before.Rotation, After.Rotation, Alpha),
+        FMath::Lerp(Before.Translation, After.Translation, Alpha));
+    return true;
+}
+
+void FCamera2PoseHistory::Reset()
+{
+    FScopeLock Lock(&WriteLock);
+    for (int32 Index = 0; Index < Capacity; ++Index)
+    {
+        Slots[Index].Sequence.store(0, std::memory_order_relaxed);
+    }
+    LastPushedTime = -DBL_MAX;
+    WriteCount.store(0, std::memory_order_release);
+}
+
+// =============================================================================
+// SELF TEST (no device or XR system needed)
+// =============================================================================
+
+// Synthetic head motion: constant velocity plus a constant-rate rotation about a fixed axis, on which
+// slerp and lerp between two samples are exact
+static FTransform GetSyntheticPose(double TimeSeconds)
+{
+    const FVector Velocity(100.0, -50.0, 20.0);
+    const FVector Axis = FVector(0.3, 0.4, 0.866).GetSafeNormal();
+    const double RadiansPerSecond = 1.5;
+    return FTransform(FQuat(Axis, RadiansPerSecond * TimeSeconds), FVector(10.0, 0.0, 160.0) + Velocity * TimeSeconds);
+}
+
+static void RunPoseHistoryTest(int32 NumSamples)
+{
+    FCamera2PoseHistory History(512);
+    FRandomStream Random(1234);
+    int32 Failures = 0;
+
+    auto Check = [&Failures](bool bCondition, const TCHAR* What, double TimeSeconds)
+    {
+        if (!bCondition)
+        {
+            ++Failures;
+            UE_LOG(LogSimpleCamera2, Warning, TEXT("Pose history test: %s at t=%.4f"), What, TimeSeconds);
+        }
+    };
+    auto Matches = [](const FTransform& A, const FTransform& B)
+    {
+        return A.GetLocation().Equals(B.GetLocation(), 1e-3) && A.GetRotation().AngularDistance(B.GetRotation()) < 1e-5;
+    };
+
+    // ~120 Hz with jitter, long enough to wrap the ring several times
+    TArray<double> Times;
+    Times.Reserve(NumSamples);
+    double Time = 1.0;
+    for (int32 Index = 0; Index < NumSamples; ++Index)
+    {
+        Time += (1.0 / 120.0) * Random.FRandRange(0.5f, 1.5f);
+        Times.Add(Time);
+        Check(History.Push(Time, GetSyntheticPose(Time)), TEXT("in-order push rejected"), Time);
+    }
+
+    // Older than the newest sample: dropped without touching the history
+    const double Newest = Times.Last();
+    Check(!History.Push(Newest - 0.001, GetSyntheticPose(0.0)), TEXT("out-of-order push accepted"), Newest - 0.001);
+    Check(History.GetTotalPushed() == static_cast<uint64>(NumSamples), TEXT("out-of-order push counted"), Newest);
+
+    const int32 Retained = FMath::Min(NumSamples, History.GetCapacity());
+    const double Oldest = Times[NumSamples - Retained];
+    double RangeOldest = 0.0;
+    double RangeNewest = 0.0;
+    Check(History.GetTimeRange(RangeOldest, RangeNewest) && RangeOldest == Oldest && RangeNewest == Newest,
+        TEXT("time range is not the last Capacity samples"), Newest);
+
+    // Between samples, including exactly on them
+    FTransform Pose;
+    int32 Interpolated = 0;
+    for (int32 Query = 0; Query < 1000; ++Query)
+    {
+        const double QueryTime = Query == 0 ? Oldest : FMath::Lerp(Oldest, Newest, static_cast<double>(Random.GetFraction()));
+        const bool bFound = History.Sample(QueryTime, Pose, 0.0);
+        Check(bFound && Matches(Pose, GetSyntheticPose(QueryTime)), TEXT("interpolated pose off the trajectory"), QueryTime);
+        Interpolated += bFound ? 1 : 0;
+    }
+
+    // Just outside either end: clamp to that end's sample within the hold window, fail past it
+    const double Hold = 0.05;
+    Check(History.Sample(Newest + 0.5 * Hold, Pose, Hold) && Matches(Pose, GetSyntheticPose(Newest)),
+        TEXT("no clamp to the newest sample"), Newest + 0.5 * Hold);
+    Check(!History.Sample(Newest + 2.0 * Hold, Pose, Hold), TEXT("sample past the hold after the newest"), Newest + 2.0 * Hold);
+    Check(History.Sample(Oldest - 0.5 * Hold, Pose, Hold) && Matches(Pose, GetSyntheticPose(Oldest)),
+        TEXT("no clamp to the oldest sample"), Oldest - 0.5 * Hold);
+    Check(!History.Sample(Oldest - 2.0 * Hold, Pose, Hold), TEXT("sample past the hold before the oldest"), Oldest - 2.0 * Hold);
+
+    // Overwritten by the wraparound
+    if (NumSamples > History.GetCapacity())
+    {
+        Check(!History.Sample(Times[0], Pose, 0.0), TEXT("overwritten sample still found"), Times[0]);
+    }
+
+    // Camera on the head: CamInHmd applied in HMD space before the interpolated HMD pose
+    const FTransform CamInHmd(FQuat(FVector::UpVector, 0.5) * FQuat(FVector::RightVector, -0.2), FVector(6.3, -3.2, -1.7));
+    for (int32 Query = 0; Query < 100; ++Query)
+    {
+        const double QueryTime = FMath::Lerp(Oldest, Newest, static_cast<double>(Random.GetFraction()));
+        FTransform WorldFromCamera;
+        Check(History.SampleComposed(QueryTime, CamInHmd, WorldFromCamera, 0.0)
+            && Matches(WorldFromCamera, CamInHmd * GetSyntheticPose(QueryTime)), TEXT("composed pose wrong"), QueryTime);
+    }
+
+    History.Reset();
+    Check(!History.Sample(Newest, Pose) && History.GetTotalPushed() == 0, TEXT("samples left after Reset"), Newest);
+    Check(History.Push(0.0, FTransform::Identity), TEXT("push after Reset rejected"), 0.0);
+
+    UE_LOG(LogSimpleCamera2, Display, TEXT("Pose history test %s: %d samples (capacity %d), %d interpolated, %d failures"),
+        Failures == 0 ? TEXT("PASSED") : TEXT("FAILED"), NumSamples, History.GetCapacity(), Interpolated, Failures);
+}
+
+static FAutoConsoleCommand GCamera2PoseHistoryTestCommand(
+    TEXT("Camera2.Pose.HistoryTest"),
+    TEXT("Check pose history interpolation, clamping, ordering and wraparound on a synthetic trajectory. Args: [Samples=1300]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const int32 NumSamples = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1300;
+        RunPoseHistoryTest(FMath::Max(NumSamples, 2));
+    }));
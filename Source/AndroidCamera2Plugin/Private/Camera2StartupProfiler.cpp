@@ -0,0 +1,268 @@
+#include "Camera2StartupProfiler.h"
+#include "Camera2Stream.h"
+#include "Camera2Subsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+static TAutoConsoleVariable<int32> CVarCamera2StartupAverageCount(
+    TEXT("Camera2.Startup.AverageCount"),
+    10,
+    TEXT("Completed camera starts averaged by the startup profiler."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarCamera2StartupBudgetMs(
+    TEXT("Camera2.Startup.BudgetMs"),
+    0.0f,
+    TEXT("Warn when a camera start takes longer than this from the start request to the first texture upload (0 = no budget)."),
+    ECVF_Default);
+
+static constexpr int32 NumMilestones = static_cast<int32>(ECamera2StartupMilestone::Count);
+
+// Stage ending at each milestone; none ends at StartRequested
+static const TCHAR* const StageNames[NumMilestones] =
+{
+    TEXT(""),
+    TEXT("Permission"),
+    TEXT("TextureCreate"),
+    TEXT("ClassLoading"),
+    TEXT("StartCall"),
+    TEXT("CameraProbe"),
+    TEXT("Characteristics"),
+    TEXT("OpenRequest"),
+    TEXT("OpenCamera"),
+    TEXT("SessionConfig"),
+    TEXT("FirstImage"),
+    TEXT("FirstConversion"),
+    TEXT("FirstUpload"),
+};
+
+FCamera2StartupProfiler::FCamera2StartupProfiler(int32 InStreamId)
+    : StreamId(InStreamId)
+    , RegionName(FString::Printf(TEXT("Camera2 Startup (stream %d)"), InStreamId))
+{
+    for (double& Time : Times)
+    {
+        Time = -1.0;
+    }
+}
+
+const TCHAR* FCamera2StartupProfiler::GetMilestoneName(ECamera2StartupMilestone Milestone)
+{
+    static const TCHAR* const Names[NumMilestones] =
+    {
+        TEXT("StartRequested"),
+        TEXT("PermissionChecked"),
+        TEXT("TexturesCreated"),
+        TEXT("HelperReady"),
+        TEXT("JavaStartEntered"),
+        TEXT("CamerasProbed"),
+        TEXT("CharacteristicsRead"),
+        TEXT("OpenRequested"),
+        TEXT("CameraOpened"),
+        TEXT("SessionConfigured"),
+        TEXT("FirstImage"),
+        TEXT("FirstFrameConverted"),
+        TEXT("FirstUpload"),
+    };
+    const int32 Index = static_cast<int32>(Milestone);
+    return Index >= 0 && Index < NumMilestones ? Names[Index] : TEXT("Unknown");
+}
+
+void FCamera2StartupProfiler::Begin()
+{
+    FScopeLock ScopeLock(&Lock);
+    if (PendingMask.load(std::memory_order_relaxed) != 0)
+    {
+        UE_LOG(LogSimpleCamera2, Log, TEXT("Stream %d: startup trace restarted before it completed"), StreamId);
+        Finish(false);
+    }
+
+    for (double& Time : Times)
+    {
+        Time = -1.0;
+    }
+    Times[0] = FPlatformTime::Seconds();
+    TRACE_BEGIN_REGION(*RegionName);
+
+    // Every milestone after StartRequested
+    PendingMask.store(((1u << NumMilestones) - 1) & ~1u, std::memory_order_release);
+}
+
+void FCamera2StartupProfiler::Mark(ECamera2StartupMilestone Milestone)
+{
+    if (!IsPending(Milestone))
+    {
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    const uint32 Bit = 1u << static_cast<uint32>(Milestone);
+    FScopeLock ScopeLock(&Lock);
+    if ((PendingMask.load(std::memory_order_relaxed) & Bit) == 0)
+    {
+        return;
+    }
+    PendingMask.fetch_and(~Bit, std::memory_order_relaxed);
+    Times[static_cast<int32>(Milestone)] = Now;
+    TRACE_BOOKMARK(TEXT("Camera2 %d: %s"), StreamId, GetMilestoneName(Milestone));
+
+    if (Milestone == ECamera2StartupMilestone::FirstUpload)
+    {
+        Finish(true);
+    }
+}
+
+void FCamera2StartupProfiler::Abort(const TCHAR* Reason)
+{
+    FScopeLock ScopeLock(&Lock);
+    if (PendingMask.load(std::memory_order_relaxed) == 0)
+    {
+        return;
+    }
+    UE_LOG(LogSimpleCamera2, Log, TEXT("Stream %d: startup trace aborted (%s)"), StreamId, Reason);
+    Finish(false);
+}
+
+void FCamera2StartupProfiler::Finish(bool bComplete)
+{
+    PendingMask.store(0, std::memory_order_relaxed);
+    TRACE_END_REGION(*RegionName);
+
+    FCamera2StartupTrace Trace;
+    Trace.StreamId = StreamId;
+    Trace.bComplete = bComplete;
+    Trace.NumStarts = 1;
+    Trace.Stages.Reserve(NumMilestones - 1);
+    for (int32 Index = 1; Index < NumMilestones; ++Index)
+    {
+        FCamera2StartupStage& Stage = Trace.Stages.AddDefaulted_GetRef();
+        Stage.Name = StageNames[Index];
+        if (Times[Index - 1] >= 0.0 && Times[Index] >= 0.0)
+        {
+            Stage.StartMs = static_cast<float>((Times[Index - 1] - Times[0]) * 1000.0);
+            Stage.DurationMs = static_cast<float>((Times[Index] - Times[Index - 1]) * 1000.0);
+        }
+    }
+
+    if (bComplete)
+    {
+        Trace.TotalMs = static_cast<float>((Times[NumMilestones - 1] - Times[0]) * 1000.0);
+        const float BudgetMs = CVarCamera2StartupBudgetMs.GetValueOnAnyThread();
+        Trace.bOverBudget = BudgetMs > 0.0f && Trace.TotalMs > BudgetMs;
+
+        RecentTraces.Add(Trace);
+        const int32 MaxTraces = FMath::Max(CVarCamera2StartupAverageCount.GetValueOnAnyThread(), 1);
+        if (RecentTraces.Num() > MaxTraces)
+        {
+            RecentTraces.RemoveAt(0, RecentTraces.Num() - MaxTraces);
+        }
+
+        if (Trace.bOverBudget)
+        {
+            UE_LOG(LogSimpleCamera2, Warning, TEXT("Stream %d: camera start took %.1f ms, over the %.1f ms budget\n%s"),
+                StreamId, Trace.TotalMs, BudgetMs, *Describe(Trace));
+        }
+        else
+        {
+            UE_LOG(LogSimpleCamera2, Log, TEXT("Stream %d: camera started in %.1f ms\n%s"), StreamId, Trace.TotalMs, *Describe(Trace));
+        }
+    }
+
+    LastTrace = MoveTemp(Trace);
+    bHasLastTrace = true;
+}
+
+bool FCamera2StartupProfiler::GetLastTrace(FCamera2StartupTrace& OutTrace) const
+{
+    FScopeLock ScopeLock(&Lock);
+    OutTrace = LastTrace;
+    return bHasLastTrace;
+}
+
+bool FCamera2StartupProfiler::GetAverageTrace(FCamera2StartupTrace& OutTrace) const
+{
+    FScopeLock ScopeLock(&Lock);
+    OutTrace = FCamera2StartupTrace();
+    OutTrace.StreamId = StreamId;
+    if (RecentTraces.Num() == 0)
+    {
+        return false;
+    }
+
+    OutTrace.bComplete = true;
+    OutTrace.NumStarts = RecentTraces.Num();
+    OutTrace.Stages = RecentTraces.Last().Stages;
+    double TotalMs = 0.0;
+    for (int32 StageIndex = 0; StageIndex < OutTrace.Stages.Num(); ++StageIndex)
+    {
+        // A milestone Java failed to report leaves its stages out of that start
+        double StartMs = 0.0;
+        double DurationMs = 0.0;
+        int32 Count = 0;
+        for (const FCamera2StartupTrace& Trace : RecentTraces)
+        {
+            const FCamera2StartupStage& Stage = Trace.Stages[StageIndex];
+            if (Stage.DurationMs >= 0.0f)
+            {
+                StartMs += Stage.StartMs;
+                DurationMs += Stage.DurationMs;
+                ++Count;
+            }
+        }
+        FCamera2StartupStage& Average = OutTrace.Stages[StageIndex];
+        Average.StartMs = Count > 0 ? static_cast<float>(StartMs / Count) : -1.0f;
+        Average.DurationMs = Count > 0 ? static_cast<float>(DurationMs / Count) : -1.0f;
+    }
+    for (const FCamera2StartupTrace& Trace : RecentTraces)
+    {
+        TotalMs += Trace.TotalMs;
+        OutTrace.bOverBudget |= Trace.bOverBudget;
+    }
+    OutTrace.TotalMs = static_cast<float>(TotalMs / RecentTraces.Num());
+    return true;
+}
+
+FString FCamera2StartupProfiler::Describe(const FCamera2StartupTrace& Trace)
+{
+    FString Out;
+    for (const FCamera2StartupStage& Stage : Trace.Stages)
+    {
+        if (Stage.DurationMs < 0.0f)
+        {
+            Out += FString::Printf(TEXT("  %-16s        -\n"), *Stage.Name.ToString());
+            continue;
+        }
+        Out += FString::Printf(TEXT("  %-16s %8.2f ms  (at %8.2f ms)\n"), *Stage.Name.ToString(), Stage.DurationMs, Stage.StartMs);
+    }
+    Out += FString::Printf(TEXT("  %-16s %8.2f ms"), TEXT("Total"), Trace.TotalMs);
+    return Out;
+}
+
+static FAutoConsoleCommand GCamera2StartupReportCommand(
+    TEXT("Camera2.Startup.Report"),
+    TEXT("Log the last startup trace of every open camera stream and its average over recent starts."),
+    FConsoleCommandDelegate::CreateLambda([]()
+        {
+            for (const int32 StreamId : UCamera2Subsystem::GetOpenStreamIds())
+            {
+                TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = UCamera2Subsystem::FindStreamForCallback(StreamId);
+                if (!Stream.IsValid())
+                {
+                    continue;
+                }
+
+                FCamera2StartupTrace Trace;
+                if (!Stream->GetStartupProfiler().GetLastTrace(Trace))
+                {
+                    UE_LOG(LogSimpleCamera2, Display, TEXT("Stream %d: not started yet"), StreamId);
+                    continue;
+                }
+                UE_LOG(LogSimpleCamera2, Display, TEXT("Stream %d: last start (%s)\n%s"), StreamId,
+                    Trace.bComplete ? TEXT("complete") : TEXT("incomplete"), *FCamera2StartupProfiler::Describe(Trace));
+                if (Stream->GetStartupProfiler().GetAverageTrace(Trace))
+                {
+                    UE_LOG(LogSimpleCamera2, Display, TEXT("Stream %d: average of %d starts%s\n%s"), StreamId, Trace.NumStarts,
+                        Trace.bOverBudget ? TEXT(", some over budget") : TEXT(""), *FCamera2StartupProfiler::Describe(Trace));
+                }
+            }
+        }));
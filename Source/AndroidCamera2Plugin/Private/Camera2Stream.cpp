@@ -0,0 +1,2219 @@
+#include "Camera2Stream.h"
+#include "Camera2CharacteristicsTable.h"
+#include "Camera2HmdPoseSampler.h"
+#include "Camera2ImageConversion.h"
+#include "Camera2Subsystem.h"
+#include "Quest3CalibrationData.h"
+#include "Async/Async.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RenderingThread.h"
+
+#if PLATFORM_ANDROID
+#include "Android/AndroidJNI.h"
+#include "Android/AndroidApplication.h"
+#endif
+
+// Layout of the long[] metadata passed with each frame (Camera2Helper META_* constants)
+namespace Camera2FrameMetadataLayout
+{
+    constexpr int32 TimestampNs = 0;
+    constexpr int32 FrameNumber = 1;
+    constexpr int32 ExposureTimeNs = 2;
+    constexpr int32 FrameDurationNs = 3;
+    constexpr int32 RollingShutterSkewNs = 4;
+    constexpr int32 SensitivityIso = 5;
+    constexpr int32 Flags = 6;
+    constexpr int32 CaptureFailures = 7;
+    constexpr int32 ControlState = 8;
+    constexpr int32 FieldCount = 9;
+
+    constexpr int64 FlagStarted = 1;
+    constexpr int64 FlagCompleted = 2;
+
+    constexpr int64 ControlManualExposure = 1;
+    constexpr int64 ControlAeLocked = 2;
+    constexpr int64 ControlAwbLocked = 4;
+}
+
+static TAutoConsoleVariable<int32> CVarCamera2TextureBufferCount(
+    TEXT("Camera2.Texture.BufferCount"),
+    3,
+    TEXT("Camera textures per stream, rotated so uploads never touch the texture being sampled (1 = update one texture in place). Applies on the next Start."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCamera2TextureMips(
+    TEXT("Camera2.Texture.Mips"),
+    1,
+    TEXT("Mip levels of the camera texture, built on the CPU with every full-frame upload (1 = none, 0 = full chain down to 1x1). Applies on the next Start."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<float> CVarCamera2UndistortScale(
+    TEXT("Camera2.Undistort.Scale"),
+    0.5f,
+    TEXT("Output scale of the undistorted frame-pipeline slots, relative to the stream resolution."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCamera2DiagnosticsDumpCharacteristics(
+    TEXT("Camera2.Diagnostics.DumpCharacteristics"),
+    0,
+    TEXT("Marshal the camera characteristics on a background thread at every Start instead of only when they are asked for."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCamera2StatsEnable(
+    TEXT("Camera2.Stats.Enable"),
+    0,
+    TEXT("Compute a luma histogram, mean/variance and sharpness for every frame and attach them to its metadata."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarCamera2StatsStep(
+    TEXT("Camera2.Stats.Step"),
+    2,
+    TEXT("Frame statistics sample every Nth row and column."),
+    ECVF_Default);
+
+// Fill the statistics fields of a frame's metadata from its luma
+static void ComputeFrameStats(const uint8* Luma, int32 Width, int32 Height, int32 RowStride, int32 PixelStride,
+    FCamera2FrameMetadata& Metadata)
+{
+    if (CVarCamera2StatsEnable.GetValueOnAnyThread() == 0)
+    {
+        return;
+    }
+
+    FCamera2LumaStats Stats;
+    Camera2ImageConversion::ComputeLumaStats(Luma, Width, Height, RowStride, PixelStride,
+        CVarCamera2StatsStep.GetValueOnAnyThread(), Stats);
+    Metadata.bHasImageStats = Stats.SampleCount > 0;
+    Metadata.MeanLuma = Stats.Mean;
+    Metadata.LumaVariance = Stats.Variance;
+    Metadata.Sharpness = Stats.Sharpness;
+    FMemory::Memcpy(Metadata.LumaHistogram, Stats.Histogram, sizeof(Stats.Histogram));
+}
+
+// =============================================================================
+// CALIBRATION
+// =============================================================================
+
+TArray<float> FCamera2StreamCalibration::GetLensDistortionUE() const
+{
+    // Always return 8 coefficients in the order: [K1,K2,P1,P2,K3,K4,K5,K6]
+    TArray<float> Mapped;
+    Mapped.SetNumZeroed(8);
+
+    // Nothing recorded
+    const int32 N = LensDistortion.Num();
+    if (N <= 0)
+    {
+        return Mapped;
+    }
+
+    // Case 1: Android Brown model (5 floats): [k1, k2, k3, p1, p2]
+    if (N == 5)
+    {
+        // Most devices provide 5 radial coefficients via LENS_DISTORTION (no tangential).
+        // Map them as K1..K5, leaving P1/P2 at zero.
+        Mapped[0] = LensDistortion[0]; // K1
+        Mapped[1] = LensDistortion[1]; // K2
+        // P1,P2 remain 0
+        Mapped[4] = LensDistortion[2]; // K3
+        Mapped[5] = LensDistortion[3]; // K4
+        Mapped[6] = LensDistortion[4]; // K5
+        // K6 remains 0
+        return Mapped;
+    }
+
+    // Case 2: Radial-only model (>=6 floats): [k1,k2,k3,k4,k5,k6,...]
+    if (N >= 6)
+    {
+        Mapped[0] = LensDistortion[0]; // K1
+        Mapped[1] = LensDistortion[1]; // K2
+        // P1,P2 = 0
+        Mapped[4] = LensDistortion[2]; // K3
+        Mapped[5] = LensDistortion[3]; // K4
+        Mapped[6] = LensDistortion[4]; // K5
+        Mapped[7] = LensDistortion[5]; // K6
+        return Mapped;
+    }
+
+    // Fallback: copy what we can for first two as K1,K2
+    Mapped[0] = LensDistortion[0];
+    if (N > 1) { Mapped[1] = LensDistortion[1]; }
+    return Mapped;
+}
+
+// =============================================================================
+// JAVA HELPER ACCESS
+// =============================================================================
+
+#if PLATFORM_ANDROID
+// Camera2Helper has to be loaded through the Activity's class loader; FindClass from
+// non-main threads only sees system classes
+static jclass LoadCamera2HelperClass(JNIEnv* Env)
+{
+    jobject Activity = FAndroidApplication::GetGameActivityThis();
+    if (!Env || !Activity)
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("Game Activity is null; cannot load Camera2Helper"));
+        return nullptr;
+    }
+
+    jclass ActivityClass = Env->GetObjectClass(Activity);
+    jmethodID GetClassLoaderMethod = ActivityClass
+        ? Env->GetMethodID(ActivityClass, "getClassLoader", "()Ljava/lang/ClassLoader;")
+        : nullptr;
+    jobject ClassLoader = GetClassLoaderMethod ? Env->CallObjectMethod(Activity, GetClassLoaderMethod) : nullptr;
+    jclass ClassLoaderClass = ClassLoader ? Env->GetObjectClass(ClassLoader) : nullptr;
+    jmethodID LoadClassMethod = ClassLoaderClass
+        ? Env->GetMethodID(ClassLoaderClass, "loadClass", "(Ljava/lang/String;)Ljava/lang/Class;")
+        : nullptr;
+
+    jclass Camera2Class = nullptr;
+    if (LoadClassMethod)
+    {
+        jstring ClassName = Env->NewStringUTF("com.epicgames.ue4.Camera2Helper");
+        Camera2Class = (jclass)Env->CallObjectMethod(ClassLoader, LoadClassMethod, ClassName);
+        Env->DeleteLocalRef(ClassName);
+    }
+
+    if (Env->ExceptionCheck())
+    {
+        Env->ExceptionDescribe();
+        Env->ExceptionClear();
+        Camera2Class = nullptr;
+    }
+
+    if (ClassLoaderClass) { Env->DeleteLocalRef(ClassLoaderClass); }
+    if (ClassLoader) { Env->DeleteLocalRef(ClassLoader); }
+    if (ActivityClass) { Env->DeleteLocalRef(ActivityClass); }
+
+    if (!Camera2Class)
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("Camera2Helper class not found"));
+    }
+    return Camera2Class;
+}
+
+// Returns false if a permission request was sent; the user has to grant it and retry
+static bool RequestCameraPermissionsIfNeeded(JNIEnv* Env)
+{
+    jobject Activity = FAndroidApplication::GetGameActivityThis();
+    if (!Env || !Activity)
+    {
+        return true;
+    }
+
+    jclass ActivityClass = Env->GetObjectClass(Activity);
+    jmethodID CheckPermMethod = Env->GetMethodID(ActivityClass,
+        "checkSelfPermission", "(Ljava/lang/String;)I");
+    jmethodID RequestPermMethod = Env->GetMethodID(ActivityClass,
+        "requestPermissions", "([Ljava/lang/String;I)V");
+
+    bool bGranted = true;
+    if (CheckPermMethod && RequestPermMethod)
+    {
+        jstring CameraPermStr = Env->NewStringUTF("android.permission.CAMERA");
+        jint CameraPermResult = Env->CallIntMethod(Activity, CheckPermMethod, CameraPermStr);
+        Env->DeleteLocalRef(CameraPermStr);
+
+        // PackageManager.PERMISSION_GRANTED = 0
+        if (CameraPermResult != 0)
+        {
+            UE_LOG(LogSimpleCamera2, Warning, TEXT("Camera permission not granted, requesting..."));
+
+            jclass StringClass = Env->FindClass("java/lang/String");
+            jobjectArray PermArray = Env->NewObjectArray(3, StringClass, nullptr);
+            const char* Permissions[] = {
+                "android.permission.CAMERA",
+                "horizonos.permission.HEADSET_CAMERA",
+                "horizonos.permission.AVATAR_CAMERA"
+            };
+            for (int32 Index = 0; Index < 3; ++Index)
+            {
+                jstring Perm = Env->NewStringUTF(Permissions[Index]);
+                Env->SetObjectArrayElement(PermArray, Index, Perm);
+                Env->DeleteLocalRef(Perm);
+            }
+
+            // Request permissions (request code = 1001)
+            Env->CallVoidMethod(Activity, RequestPermMethod, PermArray, 1001);
+            Env->DeleteLocalRef(PermArray);
+            Env->DeleteLocalRef(StringClass);
+
+            UE_LOG(LogSimpleCamera2, Warning, TEXT("Permission request sent. User must grant permission and retry."));
+            if (GEngine)
+            {
+                GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Yellow,
+                    TEXT("Please grant camera permission and try again"));
+            }
+            bGranted = false;
+        }
+    }
+
+    Env->DeleteLocalRef(ActivityClass);
+    return bGranted;
+}
+
+static void JStringToFString(JNIEnv* Env, jstring InString, FString& Target)
+{
+    if (!InString)
+    {
+        Target.Reset();
+        return;
+    }
+    const char* Chars = Env->GetStringUTFChars(InString, nullptr);
+    if (Chars)
+    {
+        Target = UTF8_TO_TCHAR(Chars);
+        Env->ReleaseStringUTFChars(InString, Chars);
+    }
+    Env->DeleteLocalRef(InString);
+}
+
+bool FCameraStream::EnsureJavaHelper(JNIEnv* Env)
+{
+    if (JavaHelper)
+    {
+        return true;
+    }
+
+    jclass Camera2Class = LoadCamera2HelperClass(Env);
+    if (!Camera2Class)
+    {
+        return false;
+    }
+
+    jmethodID GetInstanceMethod = Env->GetStaticMethodID(Camera2Class, "getInstance",
+        "(Landroid/content/Context;I)Lcom/epicgames/ue4/Camera2Helper;");
+    if (GetInstanceMethod)
+    {
+        jobject LocalHelper = Env->CallStaticObjectMethod(Camera2Class, GetInstanceMethod,
+            FAndroidApplication::GetGameActivityThis(), static_cast<jint>(StreamId));
+        if (Env->ExceptionCheck())
+        {
+            Env->ExceptionDescribe();
+            Env->ExceptionClear();
+        }
+        else if (LocalHelper)
+        {
+            JavaHelper = Env->NewGlobalRef(LocalHelper);
+            Env->DeleteLocalRef(LocalHelper);
+        }
+    }
+    else
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("getInstance(Context, int) not found on Camera2Helper"));
+    }
+
+    Env->DeleteLocalRef(Camera2Class);
+
+    if (!JavaHelper)
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("Failed to acquire Camera2Helper for stream %d"), StreamId);
+    }
+    return JavaHelper != nullptr;
+}
+
+void FCameraStream::ReleaseJavaHelper(JNIEnv* Env)
+{
+    if (!JavaHelper)
+    {
+        return;
+    }
+
+    // releaseInstance stops the camera and drops the Java-side map entry
+    jclass Camera2Class = Env->GetObjectClass(JavaHelper);
+    if (Camera2Class)
+    {
+        jmethodID ReleaseMethod = Env->GetStaticMethodID(Camera2Class, "releaseInstance", "(I)V");
+        if (ReleaseMethod)
+        {
+            Env->CallStaticVoidMethod(Camera2Class, ReleaseMethod, static_cast<jint>(StreamId));
+        }
+        if (Env->ExceptionCheck())
+        {
+            UE_LOG(LogSimpleCamera2, Error, TEXT("Exception releasing Camera2Helper for stream %d"), StreamId);
+            Env->ExceptionDescribe();
+            Env->ExceptionClear();
+        }
+        Env->DeleteLocalRef(Camera2Class);
+    }
+
+    Env->DeleteGlobalRef(JavaHelper);
+    JavaHelper = nullptr;
+}
+
+void FCameraStream::ApplySensorControlsToJava(JNIEnv* Env)
+{
+    jclass HelperClass = Env->GetObjectClass(JavaHelper);
+    if (!HelperClass)
+    {
+        return;
+    }
+
+    jmethodID SetControlsMethod = Env->GetMethodID(HelperClass, "setSensorControls", "(ZJIJZZII)V");
+    if (SetControlsMethod)
+    {
+        Env->CallVoidMethod(JavaHelper, SetControlsMethod,
+            SensorControls.bManualExposure ? JNI_TRUE : JNI_FALSE,
+            static_cast<jlong>(SensorControls.ExposureTimeNs),
+            static_cast<jint>(SensorControls.SensitivityIso),
+            static_cast<jlong>(SensorControls.FrameDurationNs),
+            SensorControls.bLockAutoExposure ? JNI_TRUE : JNI_FALSE,
+            SensorControls.bLockAutoWhiteBalance ? JNI_TRUE : JNI_FALSE,
+            static_cast<jint>(SensorControls.TargetFpsMin),
+            static_cast<jint>(SensorControls.TargetFpsMax));
+    }
+    else
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("setSensorControls not found on Camera2Helper"));
+    }
+
+    if (Env->ExceptionCheck())
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("JNI exception applying sensor controls to stream %d"), StreamId);
+        Env->ExceptionDescribe();
+        Env->ExceptionClear();
+    }
+    Env->DeleteLocalRef(HelperClass);
+}
+
+bool FCameraStream::CallJavaBool(JNIEnv* Env, const char* MethodName)
+{
+    jclass HelperClass = Env->GetObjectClass(JavaHelper);
+    if (!HelperClass)
+    {
+        return false;
+    }
+
+    bool bResult = false;
+    jmethodID Method = Env->GetMethodID(HelperClass, MethodName, "()Z");
+    if (Method)
+    {
+        bResult = Env->CallBooleanMethod(JavaHelper, Method) == JNI_TRUE;
+    }
+    else
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("%s not found on Camera2Helper"), UTF8_TO_TCHAR(MethodName));
+    }
+
+    if (Env->ExceptionCheck())
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("JNI exception in %s on stream %d"), UTF8_TO_TCHAR(MethodName), StreamId);
+        Env->ExceptionDescribe();
+        Env->ExceptionClear();
+        bResult = false;
+    }
+    Env->DeleteLocalRef(HelperClass);
+    return bResult;
+}
+
+void FCameraStream::RequestCharacteristicsDumpFromJava(JNIEnv* Env)
+{
+    jclass HelperClass = Env->GetObjectClass(JavaHelper);
+    if (!HelperClass)
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("Failed to get Camera2Helper class for characteristics"));
+        return;
+    }
+
+    // A helper made just for this request has not been told the stream's camera; without a selected
+    // camera Java dumps the preferred one
+    jmethodID SetPreferredMethod = Env->GetMethodID(HelperClass, "setPreferredCamera", "(Z)V");
+    if (SetPreferredMethod)
+    {
+        Env->CallVoidMethod(JavaHelper, SetPreferredMethod, bPreferLeftCamera ? JNI_TRUE : JNI_FALSE);
+    }
+
+    // Returns at once; the table arrives through onCharacteristicsAvailable
+    jmethodID RequestMethod = Env->GetMethodID(HelperClass, "requestCharacteristicsDump", "()V");
+    if (RequestMethod)
+    {
+        Env->CallVoidMethod(JavaHelper, RequestMethod);
+    }
+    else
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("requestCharacteristicsDump not found on Camera2Helper"));
+    }
+
+    if (Env->ExceptionCheck())
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("JNI exception requesting camera characteristics for stream %d"), StreamId);
+        Env->ExceptionDescribe();
+        Env->ExceptionClear();
+    }
+    Env->DeleteLocalRef(HelperClass);
+}
+#endif
+
+// =============================================================================
+// LIFECYCLE
+// =============================================================================
+
+FCameraStream::FCameraStream(int32 InStreamId, bool bInPreferLeftCamera, FIntPoint InResolution)
+    : StreamId(InStreamId)
+    , Resolution(InResolution)
+    , bPreferLeftCamera(bInPreferLeftCamera)
+    , StartupProfiler(InStreamId)
+{
+}
+
+FCameraStream::~FCameraStream()
+{
+    if (GovernorTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(GovernorTickerHandle);
+    }
+    Stop();
+}
+
+void FCameraStream::CreateTexture()
+{
+    if (TextureRing.IsCreated())
+    {
+        return;
+    }
+
+    const int32 NumBuffers = FMath::Clamp(CVarCamera2TextureBufferCount.GetValueOnGameThread(), 1, 8);
+    const int32 MipsSetting = CVarCamera2TextureMips.GetValueOnGameThread();
+    const int32 NumMips = MipsSetting > 0 ? MipsSetting : Camera2ImageConversion::GetNumMips(Resolution.X, Resolution.Y);
+    UE_LOG(LogSimpleCamera2, Log, TEXT("Stream %d: creating %d camera texture(s) %dx%d"), StreamId, NumBuffers, Resolution.X, Resolution.Y);
+    if (!TextureRing.Create(Resolution.X, Resolution.Y, NumBuffers, true, PF_B8G8R8A8, NumMips))
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("Stream %d: failed to create camera texture"), StreamId);
+    }
+    TextureMips = TextureRing.GetNumMips();
+
+    FScopeLock ScopeLock(&OutputsLock);
+    for (const TSharedPtr<FOutput, ESPMode::ThreadSafe>& Output : Outputs)
+    {
+        CreateOutputTextures(*Output);
+    }
+}
+
+void FCameraStream::ReleaseTexture()
+{
+    TextureRing.Release();
+
+    // Releasing flushes rendering commands; don't hold up the camera thread meanwhile
+    TArray<TSharedPtr<FOutput, ESPMode::ThreadSafe>> Snapshot;
+    {
+        FScopeLock ScopeLock(&OutputsLock);
+        Snapshot = Outputs;
+    }
+    for (const TSharedPtr<FOutput, ESPMode::ThreadSafe>& Output : Snapshot)
+    {
+        Output->Ring.Release();
+    }
+}
+
+void FCameraStream::BindTextureParameter(UMaterialInstanceDynamic* Material, FName ParameterName)
+{
+    check(IsInGameThread());
+    TextureRing.BindMaterialParameter(Material, ParameterName);
+}
+
+bool FCameraStream::Start()
+{
+    check(IsInGameThread());
+
+    if (IsActive())
+    {
+        UE_LOG(LogSimpleCamera2, Warning, TEXT("Stream %d already active"), StreamId);
+        return true;
+    }
+
+#if PLATFORM_ANDROID
+    JNIEnv* Env = FAndroidApplication::GetJavaEnv();
+    if (!Env)
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("Failed to get JNI Environment"));
+        return false;
+    }
+    StartupProfiler.Begin();
+
+    if (!RequestCameraPermissionsIfNeeded(Env))
+    {
+        StartupProfiler.Abort(TEXT("camera permission not granted"));
+        return false;
+    }
+    StartupProfiler.Mark(ECamera2StartupMilestone::PermissionChecked);
+
+    CreateTexture();
+    StartupProfiler.Mark(ECamera2StartupMilestone::TexturesCreated);
+
+    if (!EnsureJavaHelper(Env))
+    {
+        StartupProfiler.Abort(TEXT("Camera2Helper not available"));
+        if (GEngine)
+        {
+            GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Red, TEXT("Camera2Helper not available"));
+        }
+        return false;
+    }
+    StartupProfiler.Mark(ECamera2StartupMilestone::HelperReady);
+
+    jclass Camera2Class = Env->GetObjectClass(JavaHelper);
+    jmethodID SetPreferredMethod = Env->GetMethodID(Camera2Class, "setPreferredCamera", "(Z)V");
+    jmethodID SetDumpOnStartMethod = Env->GetMethodID(Camera2Class, "setDumpCharacteristicsOnStart", "(Z)V");
+    jmethodID StartMethod = Env->GetMethodID(Camera2Class, "startCamera", "()Z");
+
+    if (SetPreferredMethod)
+    {
+        Env->CallVoidMethod(JavaHelper, SetPreferredMethod, bPreferLeftCamera ? JNI_TRUE : JNI_FALSE);
+    }
+    if (SetDumpOnStartMethod)
+    {
+        Env->CallVoidMethod(JavaHelper, SetDumpOnStartMethod,
+            CVarCamera2DiagnosticsDumpCharacteristics.GetValueOnGameThread() != 0 ? JNI_TRUE : JNI_FALSE);
+    }
+
+    // Picked up by the first repeating request once the session is configured
+    ApplySensorControlsToJava(Env);
+
+    // Frames can arrive as soon as the session is configured; accept them from here on
+    bActive.store(true, std::memory_order_release);
+    bool bStarted = false;
+    if (StartMethod)
+    {
+        bStarted = Env->CallBooleanMethod(JavaHelper, StartMethod) == JNI_TRUE;
+    }
+    else
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("startCamera method not found"));
+    }
+
+    if (Env->ExceptionCheck())
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("JNI exception starting stream %d"), StreamId);
+        Env->ExceptionDescribe();
+        Env->ExceptionClear();
+        bStarted = false;
+    }
+    Env->DeleteLocalRef(Camera2Class);
+
+    bActive.store(bStarted, std::memory_order_release);
+    if (bStarted)
+    {
+        UE_LOG(LogSimpleCamera2, Log, TEXT("Stream %d: Camera2 started (%s preferred)"),
+            StreamId, bPreferLeftCamera ? TEXT("LEFT") : TEXT("RIGHT"));
+        if (GEngine)
+        {
+            GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green, TEXT("Camera2: Real Camera Started!"));
+        }
+    }
+    else
+    {
+        StartupProfiler.Abort(TEXT("startCamera failed"));
+        UE_LOG(LogSimpleCamera2, Error, TEXT("Stream %d: failed to start Camera2"), StreamId);
+        if (GEngine)
+        {
+            GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Red, TEXT("Camera2: Failed to start"));
+        }
+    }
+    return bStarted;
+#else
+    UE_LOG(LogSimpleCamera2, Warning, TEXT("Camera preview: Not on Android platform"));
+    return false;
+#endif
+}
+
+void FCameraStream::Stop()
+{
+    // Clear the flag first so callbacks already in flight drop their frames
+    const bool bWasActive = bActive.exchange(false, std::memory_order_acq_rel);
+    bPaused.store(false, std::memory_order_release);
+    ResumeTime.store(0.0);
+    StartupProfiler.Abort(TEXT("stream stopped"));
+    // The helper is released below, so a requested dump may never arrive
+    bCharacteristicsRequested = false;
+
+#if PLATFORM_ANDROID
+    if (JavaHelper)
+    {
+        if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
+        {
+            ReleaseJavaHelper(Env);
+        }
+    }
+#endif
+
+    if (bWasActive)
+    {
+        UE_LOG(LogSimpleCamera2, Log, TEXT("Stream %d stopped"), StreamId);
+    }
+
+    if (IsInGameThread())
+    {
+        ReleaseTexture();
+    }
+    bHasLatestFrameMetadata = false;
+    FrameMirror.Reset();
+    FrameHistory.Reset();
+    ChangeDetector.Reset();
+    RowPoseTable.Reset();
+    RowPoseTableSensorTimestampNs = -1;
+}
+
+bool FCameraStream::Pause()
+{
+    if (!IsActive())
+    {
+        return false;
+    }
+    if (bPaused.exchange(true, std::memory_order_acq_rel))
+    {
+        return true;
+    }
+
+#if PLATFORM_ANDROID
+    JNIEnv* Env = FAndroidApplication::GetJavaEnv();
+    if (Env && JavaHelper && CallJavaBool(Env, "pauseCapture"))
+    {
+        UE_LOG(LogSimpleCamera2, Log, TEXT("Stream %d paused"), StreamId);
+        return true;
+    }
+    UE_LOG(LogSimpleCamera2, Warning, TEXT("Stream %d: pauseCapture failed, frames are dropped natively"), StreamId);
+#endif
+    return true;
+}
+
+bool FCameraStream::Resume()
+{
+    if (!IsActive() || !IsPaused())
+    {
+        return IsActive();
+    }
+
+    // The reference frame of change detection is stale after a pause
+    ChangeDetector.Reset();
+    ResumeTime.store(FPlatformTime::Seconds());
+
+#if PLATFORM_ANDROID
+    JNIEnv* Env = FAndroidApplication::GetJavaEnv();
+    if (Env && JavaHelper && CallJavaBool(Env, "resumeCapture"))
+    {
+        bPaused.store(false, std::memory_order_release);
+        UE_LOG(LogSimpleCamera2, Log, TEXT("Stream %d resumed"), StreamId);
+        return true;
+    }
+
+    // The device was taken away while paused (e.g. app in background for long): take the slow path
+    UE_LOG(LogSimpleCamera2, Warning, TEXT("Stream %d: camera lost while paused, restarting"), StreamId);
+    Stop();
+    return Start();
+#else
+    bPaused.store(false, std::memory_order_release);
+    return true;
+#endif
+}
+
+// =============================================================================
+// ACCESSORS
+// =============================================================================
+
+FCamera2StreamCalibration FCameraStream::GetCalibration() const
+{
+    FScopeLock ScopeLock(&CalibrationLock);
+    return Calibration;
+}
+
+bool FCameraStream::UsesLeftCamera() const
+{
+    FScopeLock ScopeLock(&CalibrationLock);
+    return Calibration.CameraId.IsEmpty() ? bPreferLeftCamera : Calibration.bIsLeftCamera;
+}
+
+FTransform FCameraStream::GetCamInHmdTransform() const
+{
+    {
+        FScopeLock ScopeLock(&CalibrationLock);
+        if (Calibration.bPoseAvailable)
+        {
+            return FTransform(Calibration.PoseRotation, Calibration.PoseTranslation, FVector::OneVector);
+        }
+    }
+
+    using namespace Quest3Calibration;
+    return UsesLeftCamera()
+        ? FTransform(ConvertRotationToUE(LeftQx, LeftQy, LeftQz, LeftQw), ConvertTranslationToUE(LeftTx, LeftTy, LeftTz))
+        : FTransform(ConvertRotationToUE(RightQx, RightQy, RightQz, RightQw), ConvertTranslationToUE(RightTx, RightTy, RightTz));
+}
+
+FCamera2LensModel FCameraStream::GetLensModel() const
+{
+    using namespace Quest3Calibration;
+
+    const FCamera2StreamCalibration Calib = GetCalibration();
+    const bool bHaveRuntimeIntrinsics = Calib.HasIntrinsics();
+    const bool bLeft = UsesLeftCamera();
+    const int32 StreamWidth = Resolution.X;
+    const int32 StreamHeight = Resolution.Y;
+
+    // Center crop of the native sensor: only the principal point moves
+    const float NativeW = bHaveRuntimeIntrinsics ? static_cast<float>(Calib.CalibWidth) : static_cast<float>(NativeWidth);
+    const float NativeH = bHaveRuntimeIntrinsics ? static_cast<float>(Calib.CalibHeight) : static_cast<float>(NativeHeight);
+    const float Fx = bHaveRuntimeIntrinsics ? Calib.Fx : (bLeft ? LeftFx : RightFx);
+    const float Fy = bHaveRuntimeIntrinsics ? Calib.Fy : (bLeft ? LeftFy : RightFy);
+    const float Cx = (bHaveRuntimeIntrinsics ? Calib.Cx : (bLeft ? LeftCx : RightCx)) - (NativeW - StreamWidth) / 2.0f;
+    const float Cy = (bHaveRuntimeIntrinsics ? Calib.Cy : (bLeft ? LeftCy : RightCy)) - (NativeH - StreamHeight) / 2.0f;
+
+    return FCamera2LensModel::Make(Fx, Fy, Cx, Cy, StreamWidth, StreamHeight, Calib.GetLensDistortionUE());
+}
+
+const FCamera2UndistortLUT& FCameraStream::GetUndistortLUT()
+{
+    const FCamera2LensModel Lens = GetLensModel();
+    if (!UndistortLUT.IsBuiltFor(Lens))
+    {
+        UndistortLUT.Build(Lens);
+    }
+    return UndistortLUT;
+}
+
+const FCamera2RowPoseTable* FCameraStream::GetRowPoseTableForLatestFrame()
+{
+    if (!bHasLatestFrameMetadata)
+    {
+        return nullptr;
+    }
+
+    if (RowPoseTableSensorTimestampNs != LatestFrameMetadata.SensorTimestampNs)
+    {
+        // The stream is a center crop of the sensor; skew covers the full sensor height
+        const FCamera2StreamCalibration Calib = GetCalibration();
+        const int32 SensorRows = Calib.CalibHeight > 0 ? Calib.CalibHeight : Quest3Calibration::NativeHeight;
+        const int32 SensorRowOffset = FMath::Max((SensorRows - Resolution.Y) / 2, 0);
+
+        double FirstRowTime = 0.0;
+        double LastRowTime = 0.0;
+        FCamera2RowPoseTable::GetRowTimeSpan(LatestFrameMetadata, Resolution.Y, SensorRows, SensorRowOffset,
+            FirstRowTime, LastRowTime);
+
+        // Keep retrying on later calls until the history covers the readout
+        if (RowPoseTable.Build(FCamera2HmdPoseSampler::GetHistory(), GetCamInHmdTransform(),
+            FirstRowTime, LastRowTime, Resolution.Y))
+        {
+            RowPoseTableSensorTimestampNs = LatestFrameMetadata.SensorTimestampNs;
+        }
+    }
+
+    return RowPoseTable.IsValid() ? &RowPoseTable : nullptr;
+}
+
+bool FCameraStream::GetLatestFrameMetadata(FCamera2FrameMetadata& OutMetadata) const
+{
+    OutMetadata = LatestFrameMetadata;
+    return bHasLatestFrameMetadata;
+}
+
+FCamera2StreamStats FCameraStream::GetStats() const
+{
+    FCamera2StreamStats Stats;
+    Stats.FramesDelivered = FramesDelivered.load();
+    Stats.FramesDropped = FramesDropped.load();
+    Stats.CaptureFailures = CaptureFailures.load();
+    return Stats;
+}
+
+void FCameraStream::SetRegionsOfInterest(const TArray<FIntRect>& InRegions)
+{
+    const FIntRect Frame(FIntPoint::ZeroValue, Resolution);
+
+    TArray<FIntRect> Regions;
+    for (FIntRect Region : InRegions)
+    {
+        // Even bounds keep each 2x2 luma block with its chroma sample
+        Region.Clip(Frame);
+        Region.Min.X &= ~1;
+        Region.Min.Y &= ~1;
+        Region.Max.X = FMath::Min(Align(Region.Max.X, 2), Resolution.X);
+        Region.Max.Y = FMath::Min(Align(Region.Max.Y, 2), Resolution.Y);
+        if (Region.Width() > 0 && Region.Height() > 0)
+        {
+            Regions.Add(Region);
+        }
+        else
+        {
+            UE_LOG(LogSimpleCamera2, Warning, TEXT("Stream %d: ignoring region of interest outside the %dx%d frame"),
+                StreamId, Resolution.X, Resolution.Y);
+        }
+    }
+
+    FScopeLock ScopeLock(&RegionsLock);
+    RegionsOfInterest = MoveTemp(Regions);
+}
+
+TArray<FIntRect> FCameraStream::GetRegionsOfInterest() const
+{
+    FScopeLock ScopeLock(&RegionsLock);
+    return RegionsOfInterest;
+}
+
+bool FCameraStream::GetRegionLensModel(int32 RegionIndex, FCamera2LensModel& OutLens) const
+{
+    FIntRect Region;
+    {
+        FScopeLock ScopeLock(&RegionsLock);
+        if (!RegionsOfInterest.IsValidIndex(RegionIndex))
+        {
+            return false;
+        }
+        Region = RegionsOfInterest[RegionIndex];
+    }
+
+    OutLens = GetLensModel().Crop(Region);
+    return true;
+}
+
+void FCameraStream::SetFramePipeline(TSharedPtr<FCamera2FramePipeline, ESPMode::ThreadSafe> InPipeline)
+{
+    check(!InPipeline.IsValid() || InPipeline->GetSourceSlots().Num() > 0);
+
+    // Slot names are matched once here; each frame only switches on the kind
+    TArray<FPipelineSourceBinding> Sources;
+    if (InPipeline.IsValid())
+    {
+        for (FName Slot : InPipeline->GetSourceSlots())
+        {
+            FPipelineSourceBinding& Source = Sources.AddDefaulted_GetRef();
+            const FString SlotName = Slot.ToString();
+            if (SlotName == TEXT("BGRA"))
+            {
+                Source.Kind = EPipelineSource::Frame;
+            }
+            else if (SlotName == TEXT("UndistortedBGRA"))
+            {
+                Source.Kind = EPipelineSource::UndistortedBgra;
+            }
+            else if (SlotName == TEXT("UndistortedLuma"))
+            {
+                Source.Kind = EPipelineSource::UndistortedLuma;
+            }
+            else if (SlotName.StartsWith(TEXT("ROI")) && SlotName.Len() > 3 && SlotName.RightChop(3).IsNumeric())
+            {
+                // The region may not exist yet; the slot stays invalid until it does
+                Source.Kind = EPipelineSource::Region;
+                Source.RegionIndex = FCString::Atoi(*SlotName.RightChop(3));
+            }
+            else
+            {
+                UE_LOG(LogSimpleCamera2, Warning, TEXT("Stream %d: pipeline source slot %s is not filled by the stream"),
+                    StreamId, *SlotName);
+            }
+        }
+    }
+
+    FScopeLock ScopeLock(&PipelineLock);
+    FramePipeline = MoveTemp(InPipeline);
+    PipelineSources = MoveTemp(Sources);
+}
+
+void FCameraStream::SetSensorControls(const FCamera2SensorControls& InControls)
+{
+    SensorControls = InControls;
+
+#if PLATFORM_ANDROID
+    if (JavaHelper)
+    {
+        if (JNIEnv* Env = FAndroidApplication::GetJavaEnv())
+        {
+            ApplySensorControlsToJava(Env);
+        }
+    }
+#endif
+}
+
+void FCameraStream::SetFrameMirrorEnabled(bool bEnabled)
+{
+    bFrameMirrorEnabled.store(bEnabled, std::memory_order_relaxed);
+    if (!bEnabled)
+    {
+        FrameMirror.Reset();
+    }
+}
+
+void FCameraStream::SetFrameHistoryEnabled(bool bEnabled)
+{
+    bFrameHistoryEnabled.store(bEnabled, std::memory_order_relaxed);
+    if (!bEnabled)
+    {
+        FrameHistory.Reset();
+    }
+}
+
+void FCameraStream::AddFrameSink(const TSharedRef<ICamera2FrameSink, ESPMode::ThreadSafe>& Sink)
+{
+    FScopeLock ScopeLock(&FrameSinksLock);
+    if (!FrameSinks.ContainsByPredicate([&Sink](const TWeakPtr<ICamera2FrameSink, ESPMode::ThreadSafe>& Existing)
+        {
+            return Existing.HasSameObject(&Sink.Get());
+        }))
+    {
+        FrameSinks.Add(Sink);
+    }
+}
+
+void FCameraStream::RemoveFrameSink(const TSharedRef<ICamera2FrameSink, ESPMode::ThreadSafe>& Sink)
+{
+    FScopeLock ScopeLock(&FrameSinksLock);
+    FrameSinks.RemoveAll([&Sink](const TWeakPtr<ICamera2FrameSink, ESPMode::ThreadSafe>& Existing)
+        {
+            return Existing.HasSameObject(&Sink.Get());
+        });
+}
+
+TArray<TSharedPtr<ICamera2FrameSink, ESPMode::ThreadSafe>, TInlineAllocator<2>> FCameraStream::GetFrameSinks()
+{
+    TArray<TSharedPtr<ICamera2FrameSink, ESPMode::ThreadSafe>, TInlineAllocator<2>> Sinks;
+    FScopeLock ScopeLock(&FrameSinksLock);
+    for (int32 Index = FrameSinks.Num() - 1; Index >= 0; --Index)
+    {
+        if (TSharedPtr<ICamera2FrameSink, ESPMode::ThreadSafe> Sink = FrameSinks[Index].Pin())
+        {
+            Sinks.Add(MoveTemp(Sink));
+        }
+        else
+        {
+            FrameSinks.RemoveAtSwap(Index);
+        }
+    }
+    return Sinks;
+}
+
+bool FCameraStream::GetUndistortedLens(FCamera2LensModel& OutLens) const
+{
+    FScopeLock ScopeLock(&RemapLensLock);
+    OutLens = UndistortedLens;
+    return UndistortedLens.IsValid();
+}
+
+FCamera2CharacteristicsTablePtr FCameraStream::GetCharacteristicsTable(bool bRedump)
+{
+    FCamera2CharacteristicsTablePtr Table;
+    {
+        FScopeLock ScopeLock(&CalibrationLock);
+        Table = Characteristics;
+    }
+    if (Table.IsValid() && !bRedump)
+    {
+        return Table;
+    }
+    // A redump always asks; otherwise one outstanding request serves every caller until it arrives
+    if (bCharacteristicsRequested.exchange(true) && !bRedump)
+    {
+        return Table;
+    }
+
+    if (IsInGameThread())
+    {
+        RequestCharacteristics();
+    }
+    else
+    {
+        // The Java helper is created and released by Start and Stop on the game thread, so ask from there
+        TWeakPtr<FCameraStream, ESPMode::ThreadSafe> WeakStream = AsShared();
+        AsyncTask(ENamedThreads::GameThread, [WeakStream]()
+            {
+                if (TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = WeakStream.Pin())
+                {
+                    Stream->RequestCharacteristics();
+                }
+            });
+    }
+    return Table;
+}
+
+void FCameraStream::RequestCharacteristics()
+{
+    check(IsInGameThread());
+
+#if PLATFORM_ANDROID
+    JNIEnv* Env = FAndroidApplication::GetJavaEnv();
+    if (!Env)
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("JNI env not available for GetCameraCharacteristics"));
+        bCharacteristicsRequested = false;
+    }
+    else if (!EnsureJavaHelper(Env))
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("Unable to access Camera2Helper instance for GetCameraCharacteristics"));
+        bCharacteristicsRequested = false;
+    }
+    else
+    {
+        RequestCharacteristicsDumpFromJava(Env);
+    }
+#else
+    UE_LOG(LogSimpleCamera2, Warning, TEXT("Camera characteristics only available on Android"));
+#endif
+}
+
+bool FCameraStream::GetCharacteristics(bool bRedump, FString& OutJson, FString& OutFilePath)
+{
+    OutJson.Reset();
+    OutFilePath.Reset();
+    const FCamera2CharacteristicsTablePtr Table = GetCharacteristicsTable(bRedump);
+    if (!Table.IsValid())
+    {
+        return false;
+    }
+
+    OutJson = Table->ToJson();
+    {
+        FScopeLock ScopeLock(&CalibrationLock);
+        if (Characteristics == Table)
+        {
+            OutFilePath = CharacteristicsJsonPath;
+        }
+    }
+
+    // Written once per table
+    if (OutFilePath.IsEmpty())
+    {
+        const FString Path = FPaths::ConvertRelativePathToFull(FPaths::ProjectSavedDir() / TEXT("Camera2")
+            / FString::Printf(TEXT("camera_characteristics_%s.json"), *Table->CameraId));
+        if (FFileHelper::SaveStringToFile(OutJson, *Path, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+        {
+            UE_LOG(LogSimpleCamera2, Log, TEXT("Stream %d saved CameraCharacteristics JSON: %s"), StreamId, *Path);
+            OutFilePath = Path;
+            FScopeLock ScopeLock(&CalibrationLock);
+            if (Characteristics == Table)
+            {
+                CharacteristicsJsonPath = Path;
+            }
+        }
+        else
+        {
+            UE_LOG(LogSimpleCamera2, Warning, TEXT("Stream %d could not save CameraCharacteristics JSON to %s"), StreamId, *Path);
+        }
+    }
+    return true;
+}
+
+// =============================================================================
+// CALLBACK HANDLERS
+// =============================================================================
+
+void FCameraStream::BeginFrame(const int64* Metadata, int32 MetadataCount, int64 SensorClockNowNs, double EngineNow,
+    FCamera2FrameMetadata& OutMetadata)
+{
+    using namespace Camera2FrameMetadataLayout;
+
+    int64 MetaValues[FieldCount] = {};
+    FMemory::Memcpy(MetaValues, Metadata, sizeof(int64) * FMath::Clamp(MetadataCount, 0, FieldCount));
+    const int64 SensorTimestampNs = MetaValues[TimestampNs];
+
+    ClockSync.AddObservation(SensorClockNowNs, EngineNow);
+
+    const double ResumedAt = ResumeTime.exchange(0.0);
+    if (ResumedAt > 0.0)
+    {
+        UE_LOG(LogSimpleCamera2, Log, TEXT("Stream %d: first frame %.1f ms after resume"), StreamId, (EngineNow - ResumedAt) * 1000.0);
+    }
+
+    // Until the mapping has enough pairs, fall back to this pair's offset alone
+    double FrameEngineTime = 0.0;
+    if (!ClockSync.SensorToEngine(SensorTimestampNs, FrameEngineTime))
+    {
+        FrameEngineTime = EngineNow - static_cast<double>(SensorClockNowNs - SensorTimestampNs) * 1e-9;
+    }
+
+    OutMetadata = FCamera2FrameMetadata();
+    const int64 FlagBits = MetaValues[Flags];
+    OutMetadata.SensorTimestampNs = SensorTimestampNs;
+    OutMetadata.EngineTimestamp = FrameEngineTime;
+    OutMetadata.bHasCaptureResult = (FlagBits & FlagCompleted) != 0;
+    OutMetadata.FrameNumber = (FlagBits & FlagStarted) ? MetaValues[FrameNumber] : -1;
+    OutMetadata.ExposureTimeNs = MetaValues[ExposureTimeNs];
+    OutMetadata.FrameDurationNs = MetaValues[FrameDurationNs];
+    OutMetadata.RollingShutterSkewNs = MetaValues[RollingShutterSkewNs];
+    OutMetadata.SensitivityIso = static_cast<int32>(MetaValues[SensitivityIso]);
+    OutMetadata.bManualExposure = (MetaValues[ControlState] & ControlManualExposure) != 0;
+    OutMetadata.bAutoExposureLocked = (MetaValues[ControlState] & ControlAeLocked) != 0;
+    OutMetadata.bAutoWhiteBalanceLocked = (MetaValues[ControlState] & ControlAwbLocked) != 0;
+
+    // Gaps in the frame number are frames the camera produced that never reached us
+    // (acquireLatestImage skips, buffer loss); a backwards jump is a new capture session
+    if (OutMetadata.FrameNumber >= 0)
+    {
+        if (LastDeliveredFrameNumber >= 0 && OutMetadata.FrameNumber > LastDeliveredFrameNumber)
+        {
+            OutMetadata.DroppedFramesBefore = static_cast<int32>(FMath::Min<int64>(
+                OutMetadata.FrameNumber - LastDeliveredFrameNumber - 1, MAX_int32));
+            FramesDropped += OutMetadata.DroppedFramesBefore;
+        }
+        LastDeliveredFrameNumber = OutMetadata.FrameNumber;
+    }
+    OutMetadata.FrameSequence = FramesDelivered++;
+    CaptureFailures = MetaValues[Camera2FrameMetadataLayout::CaptureFailures];
+}
+
+// Bytes of a frame as handed to DeliverFrame: the full frame and its mip chain, or the regions packed back to back
+static int64 GetDeliveredFrameBytes(const TArray<FIntRect>& Regions, FIntPoint Resolution, int32 NumMips)
+{
+    if (Regions.Num() == 0)
+    {
+        return Camera2ImageConversion::GetMipChainBytes(Resolution.X, Resolution.Y, 4, NumMips);
+    }
+
+    int64 Bytes = 0;
+    for (const FIntRect& Region : Regions)
+    {
+        Bytes += static_cast<int64>(Region.Area()) * 4;
+    }
+    return Bytes;
+}
+
+void FCameraStream::HandleFrame(const uint8* FrameData, int32 Width, int32 Height, const int64* Metadata, int32 MetadataCount,
+    int64 SensorClockNowNs, double EngineNow)
+{
+    if (!IsActive() || IsPaused() || !FrameData || Width != Resolution.X || Height != Resolution.Y)
+    {
+        return;
+    }
+
+    FCamera2FrameMetadata FrameMetadata;
+    BeginFrame(Metadata, MetadataCount, SensorClockNowNs, EngineNow, FrameMetadata);
+
+    // BGRA frames are the grayscale fallback, so the green channel is the luma
+    if (!AnalyzeFrame(FrameData + 1, Width, Height, Width * 4, 4, FrameMetadata))
+    {
+        return;
+    }
+
+    if (IsFrameMirrorEnabled())
+    {
+        FrameMirror.UpdateFromBgra(FrameData, Width, Height, FrameMetadata);
+    }
+
+    for (const TSharedPtr<ICamera2FrameSink, ESPMode::ThreadSafe>& Sink : GetFrameSinks())
+    {
+        Sink->ReceiveBgraFrame(FrameData, Width, Height, FrameMetadata);
+    }
+
+    if (IsFrameHistoryEnabled())
+    {
+        if (FCamera2FrameHistory::GetFormat() == FCamera2HistoryFrame::EFormat::Bgra)
+        {
+            FrameHistory.RecordBgra(FrameData, Width, Height, FrameMetadata);
+        }
+        else
+        {
+            FrameHistory.RecordLuma(FrameData + 1, Width, Height, Width * 4, 4, FrameMetadata);
+        }
+    }
+
+    // Copy frame data (only the regions of interest when set)
+    const TArray<FIntRect> Regions = GetRegionsOfInterest();
+    const int32 NumMips = Regions.Num() == 0 ? TextureMips.load() : 1;
+    uint8* FrameDataCopy = new uint8[GetDeliveredFrameBytes(Regions, Resolution, NumMips)];
+    if (Regions.Num() == 0)
+    {
+        FMemory::Memcpy(FrameDataCopy, FrameData, static_cast<int64>(Width) * Height * 4);
+        Camera2ImageConversion::BuildMipChain(FrameDataCopy, Width, Height, 4, NumMips);
+    }
+    else
+    {
+        uint8* Dst = FrameDataCopy;
+        for (const FIntRect& Region : Regions)
+        {
+            const int32 RowBytes = Region.Width() * 4;
+            for (int32 Row = Region.Min.Y; Row < Region.Max.Y; ++Row, Dst += RowBytes)
+            {
+                FMemory::Memcpy(Dst, FrameData + (static_cast<int64>(Row) * Width + Region.Min.X) * 4, RowBytes);
+            }
+        }
+    }
+
+    DeliverFrame(FrameDataCopy, Regions, FrameMetadata, nullptr, NumMips);
+}
+
+void FCameraStream::HandleYuvFrame(const FCamera2YuvPlanes& Planes, const int64* Metadata, int32 MetadataCount,
+    int64 SensorClockNowNs, double EngineNow)
+{
+    if (!IsActive() || IsPaused() || !Planes.Y || !Planes.U || !Planes.V || Planes.Width != Resolution.X || Planes.Height != Resolution.Y)
+    {
+        return;
+    }
+
+    FCamera2FrameMetadata FrameMetadata;
+    BeginFrame(Metadata, MetadataCount, SensorClockNowNs, EngineNow, FrameMetadata);
+    if (!AnalyzeFrame(Planes.Y, Planes.Width, Planes.Height, Planes.YRowStride, 1, FrameMetadata))
+    {
+        return;
+    }
+
+    if (IsFrameMirrorEnabled())
+    {
+        FrameMirror.UpdateFromYuv(Planes, FrameMetadata);
+    }
+
+    for (const TSharedPtr<ICamera2FrameSink, ESPMode::ThreadSafe>& Sink : GetFrameSinks())
+    {
+        Sink->ReceiveYuvFrame(Planes, FrameMetadata);
+    }
+
+    // Convert straight into the buffer the upload consumes; the planes are only valid during the callback
+    // Lower mip levels are only rebuilt with full frames; regions of interest update level 0
+    const TArray<FIntRect> Regions = GetRegionsOfInterest();
+    const int32 NumMips = Regions.Num() == 0 ? TextureMips.load() : 1;
+    uint8* FrameBgra = new uint8[GetDeliveredFrameBytes(Regions, Resolution, NumMips)];
+    if (Regions.Num() == 0)
+    {
+        Camera2ImageConversion::ConvertYuvToBgra(Planes, FrameBgra, Planes.Width * 4);
+        Camera2ImageConversion::BuildMipChain(FrameBgra, Planes.Width, Planes.Height, 4, NumMips);
+    }
+    else
+    {
+        uint8* Dst = FrameBgra;
+        for (const FIntRect& Region : Regions)
+        {
+            Camera2ImageConversion::ConvertYuvToBgra(Planes.Crop(Region), Dst, Region.Width() * 4);
+            Dst += static_cast<int64>(Region.Area()) * 4;
+        }
+    }
+
+    if (IsFrameHistoryEnabled())
+    {
+        // Reuse the converted frame when it is complete; with regions, convert the full frame into the history
+        if (FCamera2FrameHistory::GetFormat() == FCamera2HistoryFrame::EFormat::Luma)
+        {
+            FrameHistory.RecordLuma(Planes.Y, Planes.Width, Planes.Height, Planes.YRowStride, 1, FrameMetadata);
+        }
+        else if (Regions.Num() == 0)
+        {
+            FrameHistory.RecordBgra(FrameBgra, Planes.Width, Planes.Height, FrameMetadata);
+        }
+        else
+        {
+            FrameHistory.RecordYuv(Planes, FrameMetadata);
+        }
+    }
+
+    ProduceOutputs(Planes);
+    DeliverFrame(FrameBgra, Regions, FrameMetadata, &Planes, NumMips);
+}
+
+bool FCameraStream::AnalyzeFrame(const uint8* Luma, int32 Width, int32 Height, int32 RowStride, int32 PixelStride,
+    FCamera2FrameMetadata& FrameMetadata)
+{
+    // Governor decimation comes first so dropped frames cost nothing beyond the clock mapping
+    const int32 Decimation = FrameDecimation.load(std::memory_order_relaxed);
+    if (Decimation > 1 && (DecimationCounter++ % Decimation) != 0)
+    {
+        return false;
+    }
+
+    if (FCamera2ChangeDetector::IsEnabled())
+    {
+        const bool bChanged = ChangeDetector.Evaluate(Luma, Width, Height, RowStride, PixelStride);
+        FrameMetadata.ChangeScore = ChangeDetector.GetLastScore();
+        if (!bChanged)
+        {
+            // The texture, mirror and pipeline results of the last processed frame stay current
+            return false;
+        }
+    }
+
+    ComputeFrameStats(Luma, Width, Height, RowStride, PixelStride, FrameMetadata);
+    return true;
+}
+
+// =============================================================================
+// OUTPUTS
+// =============================================================================
+
+struct FCameraStream::FOutput
+{
+    FCamera2OutputDesc Desc;
+    // Source region, clamped to the frame with even origin for the 4:2:0 chroma
+    FIntRect Region;
+    FIntPoint Size = FIntPoint::ZeroValue;
+
+    // Camera thread: remap from the source region, rebuilt when the stream lens changes
+    FCamera2RemapLUT Lut;
+
+    // Lens model of the texture, under the stream's OutputsLock; invalid until the first frame
+    FCamera2LensModel Lens;
+
+    // Game thread
+    FCamera2TextureRing Ring;
+
+    int32 GetBytesPerPixel() const { return Desc.bLuma ? 1 : 4; }
+};
+
+void FCameraStream::CreateOutputTextures(FOutput& Output)
+{
+    if (Output.Ring.IsCreated())
+    {
+        return;
+    }
+
+    const int32 NumBuffers = FMath::Clamp(CVarCamera2TextureBufferCount.GetValueOnGameThread(), 1, 8);
+    if (!Output.Ring.Create(Output.Size.X, Output.Size.Y, NumBuffers, true, Output.Desc.bLuma ? PF_G8 : PF_B8G8R8A8))
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("Stream %d: failed to create textures for output %s"), StreamId, *Output.Desc.Name.ToString());
+    }
+}
+
+bool FCameraStream::AddOutput(const FCamera2OutputDesc& Desc)
+{
+    check(IsInGameThread());
+
+    FIntRect Region(FIntPoint::ZeroValue, Resolution);
+    if (Desc.RegionSize.X > 0 && Desc.RegionSize.Y > 0)
+    {
+        // Grow to even coordinates, as for regions of interest
+        Region = FIntRect(Desc.RegionOrigin, Desc.RegionOrigin + Desc.RegionSize);
+        Region.Clip(FIntRect(FIntPoint::ZeroValue, Resolution));
+        Region.Min.X &= ~1;
+        Region.Min.Y &= ~1;
+        Region.Max.X = FMath::Min(Region.Max.X + (Region.Max.X & 1), Resolution.X);
+        Region.Max.Y = FMath::Min(Region.Max.Y + (Region.Max.Y & 1), Resolution.Y);
+    }
+    if (Desc.Name.IsNone() || Region.Width() < 2 || Region.Height() < 2)
+    {
+        UE_LOG(LogSimpleCamera2, Warning, TEXT("Stream %d: output %s rejected (needs a name and a region inside the frame)"),
+            StreamId, *Desc.Name.ToString());
+        return false;
+    }
+
+    TSharedPtr<FOutput, ESPMode::ThreadSafe> Output = MakeShared<FOutput, ESPMode::ThreadSafe>();
+    Output->Desc = Desc;
+    Output->Desc.Scale = FCamera2RemapLUT::ClampScale(Desc.Scale);
+    Output->Region = Region;
+    // Same rounding as FCamera2RemapLUT::Build
+    Output->Size = FIntPoint(FMath::Max(FMath::RoundToInt32(Region.Width() * Output->Desc.Scale), 1),
+        FMath::Max(FMath::RoundToInt32(Region.Height() * Output->Desc.Scale), 1));
+    if (TextureRing.IsCreated())
+    {
+        CreateOutputTextures(*Output);
+    }
+
+    UE_LOG(LogSimpleCamera2, Log, TEXT("Stream %d: output %s %dx%d %s from (%d,%d)-(%d,%d)%s"), StreamId, *Desc.Name.ToString(),
+        Output->Size.X, Output->Size.Y, Desc.bLuma ? TEXT("luma") : TEXT("BGRA"),
+        Region.Min.X, Region.Min.Y, Region.Max.X, Region.Max.Y, Desc.bUndistorted ? TEXT(", undistorted") : TEXT(""));
+
+    TSharedPtr<FOutput, ESPMode::ThreadSafe> Replaced;
+    {
+        FScopeLock ScopeLock(&OutputsLock);
+        const int32 Index = Outputs.IndexOfByPredicate([&Desc](const TSharedPtr<FOutput, ESPMode::ThreadSafe>& Existing)
+            {
+                return Existing->Desc.Name == Desc.Name;
+            });
+        if (Index != INDEX_NONE)
+        {
+            Replaced = MoveTemp(Outputs[Index]);
+            Outputs[Index] = MoveTemp(Output);
+        }
+        else
+        {
+            Outputs.Add(MoveTemp(Output));
+        }
+    }
+    if (Replaced.IsValid())
+    {
+        Replaced->Ring.Release();
+    }
+    return true;
+}
+
+bool FCameraStream::RemoveOutput(FName Name)
+{
+    check(IsInGameThread());
+
+    TSharedPtr<FOutput, ESPMode::ThreadSafe> Removed;
+    {
+        FScopeLock ScopeLock(&OutputsLock);
+        const int32 Index = Outputs.IndexOfByPredicate([Name](const TSharedPtr<FOutput, ESPMode::ThreadSafe>& Output)
+            {
+                return Output->Desc.Name == Name;
+            });
+        if (Index == INDEX_NONE)
+        {
+            return false;
+        }
+        Removed = MoveTemp(Outputs[Index]);
+        Outputs.RemoveAt(Index);
+    }
+
+    // Uploads still queued for it find the ring released and drop their data
+    Removed->Ring.Release();
+    return true;
+}
+
+UTexture2D* FCameraStream::GetOutputTexture(FName Name) const
+{
+    FScopeLock ScopeLock(&OutputsLock);
+    for (const TSharedPtr<FOutput, ESPMode::ThreadSafe>& Output : Outputs)
+    {
+        if (Output->Desc.Name == Name)
+        {
+            return Output->Ring.GetTexture();
+        }
+    }
+    return nullptr;
+}
+
+void FCameraStream::BindOutputTextureParameter(FName Name, UMaterialInstanceDynamic* Material, FName ParameterName)
+{
+    check(IsInGameThread());
+
+    FScopeLock ScopeLock(&OutputsLock);
+    for (const TSharedPtr<FOutput, ESPMode::ThreadSafe>& Output : Outputs)
+    {
+        if (Output->Desc.Name == Name)
+        {
+            Output->Ring.BindMaterialParameter(Material, ParameterName);
+        }
+    }
+}
+
+bool FCameraStream::GetOutputLens(FName Name, FCamera2LensModel& OutLens) const
+{
+    FScopeLock ScopeLock(&OutputsLock);
+    for (const TSharedPtr<FOutput, ESPMode::ThreadSafe>& Output : Outputs)
+    {
+        if (Output->Desc.Name == Name && Output->Lens.IsValid())
+        {
+            OutLens = Output->Lens;
+            return true;
+        }
+    }
+    return false;
+}
+
+void FCameraStream::ProduceOutputs(const FCamera2YuvPlanes& Planes)
+{
+    TArray<TSharedPtr<FOutput, ESPMode::ThreadSafe>, TInlineAllocator<4>> Snapshot;
+    {
+        FScopeLock ScopeLock(&OutputsLock);
+        Snapshot = Outputs;
+    }
+    if (Snapshot.Num() == 0)
+    {
+        return;
+    }
+
+    const FCamera2LensModel StreamLens = GetLensModel();
+    TArray<FCamera2RemapTarget, TInlineAllocator<4>> Targets;
+    TArray<TPair<TSharedPtr<FOutput, ESPMode::ThreadSafe>, uint8*>, TInlineAllocator<4>> Results;
+    for (const TSharedPtr<FOutput, ESPMode::ThreadSafe>& Output : Snapshot)
+    {
+        // Plain outputs remap through the same lens without distortion, i.e. crop and resize only
+        FCamera2LensModel SourceLens = StreamLens.Crop(Output->Region);
+        if (!Output->Desc.bUndistorted)
+        {
+            SourceLens.K1 = SourceLens.K2 = SourceLens.P1 = SourceLens.P2 = 0.0f;
+            SourceLens.K3 = SourceLens.K4 = SourceLens.K5 = SourceLens.K6 = 0.0f;
+            SourceLens.MaxRadius2 = 0.0f;
+        }
+        if (!Output->Lut.IsBuiltFor(SourceLens, Output->Desc.Scale))
+        {
+            Output->Lut.Build(SourceLens, Output->Desc.Scale);
+
+            FCamera2LensModel TextureLens = Output->Lut.GetOutputLens();
+            if (!Output->Desc.bUndistorted)
+            {
+                // The texture still shows the distorted image: same coefficients, intrinsics rescaled
+                const FCamera2LensModel Cropped = StreamLens.Crop(Output->Region);
+                const float Fx = TextureLens.Fx;
+                const float Fy = TextureLens.Fy;
+                const float Cx = TextureLens.Cx;
+                const float Cy = TextureLens.Cy;
+                TextureLens = Cropped;
+                TextureLens.Fx = Fx;
+                TextureLens.Fy = Fy;
+                TextureLens.Cx = Cx;
+                TextureLens.Cy = Cy;
+                TextureLens.Width = Output->Lut.GetOutputWidth();
+                TextureLens.Height = Output->Lut.GetOutputHeight();
+            }
+
+            FScopeLock ScopeLock(&OutputsLock);
+            Output->Lens = TextureLens;
+        }
+        if (Output->Lut.GetOutputWidth() != Output->Size.X || Output->Lut.GetOutputHeight() != Output->Size.Y)
+        {
+            continue;
+        }
+
+        uint8* Buffer = new uint8[static_cast<int64>(Output->Size.X) * Output->Size.Y * Output->GetBytesPerPixel()];
+        FCamera2RemapTarget& Target = Targets.AddDefaulted_GetRef();
+        Target.Planes = Planes.Crop(Output->Region);
+        Target.Lut = &Output->Lut;
+        Target.Dst = Buffer;
+        Target.DstStride = Output->Size.X * Output->GetBytesPerPixel();
+        Target.bLuma = Output->Desc.bLuma;
+        Results.Emplace(Output, Buffer);
+    }
+
+    if (!Camera2ImageConversion::RemapYuvMulti(Targets))
+    {
+        for (const TPair<TSharedPtr<FOutput, ESPMode::ThreadSafe>, uint8*>& Result : Results)
+        {
+            delete[] Result.Value;
+        }
+        return;
+    }
+
+    TWeakPtr<FCameraStream, ESPMode::ThreadSafe> WeakStream = AsShared();
+    AsyncTask(ENamedThreads::GameThread, [WeakStream, Results = MoveTemp(Results)]()
+        {
+            TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = WeakStream.Pin();
+            for (const TPair<TSharedPtr<FOutput, ESPMode::ThreadSafe>, uint8*>& Result : Results)
+            {
+                FOutput& Output = *Result.Key;
+                if (!Stream.IsValid() || !Stream->IsActive() || !Output.Ring.IsCreated())
+                {
+                    delete[] Result.Value;
+                    continue;
+                }
+                Output.Ring.Upload({ FIntRect(FIntPoint::ZeroValue, Output.Size) }, Result.Value);
+            }
+        });
+}
+
+void FCameraStream::SetGovernorEnabled(bool bEnabled)
+{
+    check(IsInGameThread());
+
+    if (bEnabled == Governor.IsValid())
+    {
+        return;
+    }
+
+    if (bEnabled)
+    {
+        Governor = MakeUnique<FCamera2Governor>();
+        UploadLatencySumMs = 0.0;
+        UploadLatencyCount = 0;
+        // The destructor removes the ticker, but a weak capture keeps a tick racing teardown from
+        // touching a stream that is already gone
+        TWeakPtr<FCameraStream, ESPMode::ThreadSafe> WeakStream = AsShared();
+        GovernorTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakStream](float)
+            {
+                const TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = WeakStream.Pin();
+                if (!Stream.IsValid())
+                {
+                    return false;
+                }
+                Stream->TickGovernor();
+                return true;
+            }), FCamera2Governor::GetInterval());
+        UE_LOG(LogSimpleCamera2, Log, TEXT("Stream %d: governor on, latency budget %.0f ms"), StreamId, Governor->GetLatencyBudgetMs());
+        return;
+    }
+
+    FTSTicker::GetCoreTicker().RemoveTicker(GovernorTickerHandle);
+    GovernorTickerHandle.Reset();
+    Governor.Reset();
+
+    // Back to full quality
+    FrameDecimation = 1;
+    OutputScale = 1.0f;
+    {
+        FScopeLock ScopeLock(&PipelineLock);
+        if (FramePipeline.IsValid())
+        {
+            FramePipeline->SetSkipOptionalStages(false);
+        }
+    }
+    UE_LOG(LogSimpleCamera2, Log, TEXT("Stream %d: governor off"), StreamId);
+}
+
+FCamera2GovernorState FCameraStream::GetGovernorState() const
+{
+    return Governor.IsValid() ? Governor->GetState() : FCamera2GovernorState();
+}
+
+void FCameraStream::TickGovernor()
+{
+    if (!Governor.IsValid() || !IsActive() || IsPaused())
+    {
+        return;
+    }
+
+    FCamera2GovernorInputs Inputs;
+    if (UploadLatencyCount > 0)
+    {
+        Inputs.UploadLatencyMs = UploadLatencySumMs / UploadLatencyCount;
+    }
+    UploadLatencySumMs = 0.0;
+    UploadLatencyCount = 0;
+    Inputs.QueueDepth = PendingUploads.load();
+    Inputs.Thermal = Governor->GetThermalSeverity();
+
+    TSharedPtr<FCamera2FramePipeline, ESPMode::ThreadSafe> Pipeline;
+    {
+        FScopeLock ScopeLock(&PipelineLock);
+        Pipeline = FramePipeline;
+    }
+    if (Pipeline.IsValid())
+    {
+        Governor->SampleInputs(*Pipeline, Inputs);
+    }
+
+    const FCamera2GovernorState State = Governor->Update(Inputs);
+    FrameDecimation = FMath::Max(State.Decimation, 1);
+    OutputScale = State.OutputScale;
+    if (Pipeline.IsValid())
+    {
+        Pipeline->SetSkipOptionalStages(State.bSkipOptionalStages);
+    }
+}
+
+void FCameraStream::FillPipelineSource(const FPipelineSourceBinding& Source, FCamera2PipelineBuffer& Buffer, const uint8* FrameData,
+    const TArray<FIntRect>& Regions, const FCamera2YuvPlanes* Planes)
+{
+    switch (Source.Kind)
+    {
+    case EPipelineSource::Frame:
+        if (Regions.Num() == 0)
+        {
+            Buffer.Allocate(Resolution.X, Resolution.Y, 4);
+            FMemory::Memcpy(Buffer.Data.GetData(), FrameData, Buffer.Data.Num());
+            return;
+        }
+        break;
+
+    case EPipelineSource::Region:
+        if (Regions.IsValidIndex(Source.RegionIndex))
+        {
+            // Regions are packed one after another in the delivered frame
+            const uint8* RegionData = FrameData;
+            for (int32 Index = 0; Index < Source.RegionIndex; ++Index)
+            {
+                RegionData += static_cast<int64>(Regions[Index].Area()) * 4;
+            }
+            const FIntRect& Region = Regions[Source.RegionIndex];
+            Buffer.Allocate(Region.Width(), Region.Height(), 4);
+            FMemory::Memcpy(Buffer.Data.GetData(), RegionData, Buffer.Data.Num());
+            return;
+        }
+        break;
+
+    case EPipelineSource::UndistortedBgra:
+    case EPipelineSource::UndistortedLuma:
+        if (Planes)
+        {
+            FillUndistortedPipelineSource(Source.Kind == EPipelineSource::UndistortedBgra, Buffer, *Planes);
+            return;
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    // Reset keeps the allocation; an empty source is marked invalid for this frame
+    Buffer.Data.Reset();
+}
+
+void FCameraStream::FillUndistortedPipelineSource(bool bUndistortedBgra, FCamera2PipelineBuffer& Buffer, const FCamera2YuvPlanes& Planes)
+{
+    const float Scale = CVarCamera2UndistortScale.GetValueOnAnyThread() * OutputScale.load(std::memory_order_relaxed);
+    const FCamera2LensModel Lens = GetLensModel();
+    if (!RemapLUT.IsBuiltFor(Lens, Scale))
+    {
+        RemapLUT.Build(Lens, Scale);
+
+        FScopeLock ScopeLock(&RemapLensLock);
+        UndistortedLens = RemapLUT.GetOutputLens();
+    }
+
+    const int32 BytesPerPixel = bUndistortedBgra ? 4 : 1;
+    Buffer.Allocate(RemapLUT.GetOutputWidth(), RemapLUT.GetOutputHeight(), BytesPerPixel);
+    const bool bRemapped = bUndistortedBgra
+        ? Camera2ImageConversion::RemapYuvToBgra(Planes, RemapLUT, Buffer.Data.GetData(), Buffer.Width * BytesPerPixel)
+        : Camera2ImageConversion::RemapYuvToLuma(Planes, RemapLUT, Buffer.Data.GetData(), Buffer.Width * BytesPerPixel);
+    if (!bRemapped)
+    {
+        Buffer.Data.Reset();
+    }
+}
+
+void FCameraStream::DeliverFrame(uint8* FrameData, const TArray<FIntRect>& Regions, const FCamera2FrameMetadata& FrameMetadata,
+    const FCamera2YuvPlanes* Planes, int32 NumMips)
+{
+    StartupProfiler.Mark(ECamera2StartupMilestone::FirstFrameConverted);
+
+    TSharedPtr<FCamera2FramePipeline, ESPMode::ThreadSafe> Pipeline;
+    TArray<FPipelineSourceBinding, TInlineAllocator<8>> SourceBindings;
+    {
+        FScopeLock ScopeLock(&PipelineLock);
+        Pipeline = FramePipeline;
+        SourceBindings = PipelineSources;
+    }
+    if (Pipeline.IsValid())
+    {
+        Pipeline->Submit([&](FCamera2FrameMetadata& OutMetadata, TArrayView<FCamera2PipelineBuffer*> Sources)
+            {
+                OutMetadata = FrameMetadata;
+                for (int32 Index = 0; Index < Sources.Num(); ++Index)
+                {
+                    FillPipelineSource(SourceBindings[Index], *Sources[Index], FrameData, Regions, Planes);
+                }
+            });
+    }
+
+    // Rectangles of the texture to update, in the order their pixels are packed in FrameData
+    TArray<FIntRect> UploadRects = Regions;
+    if (UploadRects.Num() == 0)
+    {
+        UploadRects.Add(FIntRect(FIntPoint::ZeroValue, Resolution));
+    }
+
+    // Update texture on the game thread; the stream may be closed by the time this runs
+    TWeakPtr<FCameraStream, ESPMode::ThreadSafe> WeakStream = AsShared();
+    ++PendingUploads;
+    AsyncTask(ENamedThreads::GameThread,
+        [WeakStream, FrameData, UploadRects = MoveTemp(UploadRects), FrameMetadata, NumMips]() mutable
+        {
+            TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = WeakStream.Pin();
+            if (Stream.IsValid())
+            {
+                --Stream->PendingUploads;
+            }
+            if (!Stream.IsValid() || !Stream->IsActive() || !Stream->TextureRing.IsCreated())
+            {
+                // Clean up if camera was stopped
+                delete[] FrameData;
+                return;
+            }
+
+            if (FrameMetadata.EngineTimestamp > 0.0)
+            {
+                Stream->UploadLatencySumMs += (FPlatformTime::Seconds() - FrameMetadata.EngineTimestamp) * 1000.0;
+                ++Stream->UploadLatencyCount;
+            }
+
+            // Metadata describes the latest camera frame even if the ring drops its upload
+            Stream->LatestFrameMetadata = FrameMetadata;
+            Stream->bHasLatestFrameMetadata = true;
+            const int32 Slot = Stream->TextureRing.Upload(MoveTemp(UploadRects), FrameData, NumMips);
+            if (Slot != INDEX_NONE && Stream->StartupProfiler.IsPending(ECamera2StartupMilestone::FirstUpload))
+            {
+                // Runs after the upload's own render command
+                ENQUEUE_RENDER_COMMAND(Camera2StartupFirstUpload)([WeakStream](FRHICommandListImmediate&)
+                    {
+                        if (TSharedPtr<FCameraStream, ESPMode::ThreadSafe> UploadedStream = WeakStream.Pin())
+                        {
+                            UploadedStream->StartupProfiler.Mark(ECamera2StartupMilestone::FirstUpload);
+                        }
+                    });
+            }
+        });
+}
+
+void FCameraStream::HandleCameraSelected(const FString& CameraId, bool bIsLeftCamera)
+{
+    UE_LOG(LogSimpleCamera2, Warning, TEXT("Stream %d camera selected: ID=%s, isLeft=%s"),
+        StreamId, *CameraId, bIsLeftCamera ? TEXT("true") : TEXT("false"));
+
+    FScopeLock ScopeLock(&CalibrationLock);
+    if (Calibration.CameraId != CameraId)
+    {
+        // Characteristics of the previous camera no longer describe this stream, and a dump in flight is of that camera
+        Characteristics.Reset();
+        CharacteristicsJsonPath.Reset();
+        bCharacteristicsRequested = false;
+    }
+    Calibration.CameraId = CameraId;
+    Calibration.bIsLeftCamera = bIsLeftCamera;
+}
+
+void FCameraStream::HandleIntrinsics(float Fx, float Fy, float Cx, float Cy, float Skew, int32 Width, int32 Height)
+{
+    UE_LOG(LogSimpleCamera2, Warning, TEXT("Stream %d intrinsics received: fx=%.2f fy=%.2f cx=%.2f cy=%.2f skew=%.3f %dx%d"),
+        StreamId, Fx, Fy, Cx, Cy, Skew, Width, Height);
+
+    FScopeLock ScopeLock(&CalibrationLock);
+    Calibration.Fx = Fx;
+    Calibration.Fy = Fy;
+    Calibration.Cx = Cx;
+    Calibration.Cy = Cy;
+    Calibration.Skew = Skew;
+    Calibration.CalibWidth = Width;
+    Calibration.CalibHeight = Height;
+}
+
+void FCameraStream::HandleDistortion(const float* Coeffs, int32 Count)
+{
+    FScopeLock ScopeLock(&CalibrationLock);
+    if (Coeffs && Count > 0)
+    {
+        Calibration.LensDistortion = TArray<float>(Coeffs, Count);
+
+        // Log first few coefficients for debugging
+        FString CoeffStr = TEXT("Distortion coeffs: ");
+        for (int32 Index = 0; Index < FMath::Min(Count, 5); ++Index)
+        {
+            CoeffStr += FString::Printf(TEXT("%.4f "), Coeffs[Index]);
+        }
+        UE_LOG(LogSimpleCamera2, Warning, TEXT("Stream %d %s"), StreamId, *CoeffStr);
+    }
+    else
+    {
+        UE_LOG(LogSimpleCamera2, Warning, TEXT("Stream %d: no lens distortion data available"), StreamId);
+        Calibration.LensDistortion.Empty();
+    }
+}
+
+void FCameraStream::HandleOriginalResolution(int32 Width, int32 Height)
+{
+    FScopeLock ScopeLock(&CalibrationLock);
+    Calibration.OriginalWidth = Width;
+    Calibration.OriginalHeight = Height;
+}
+
+void FCameraStream::HandleCameraPose(const FVector& TranslationCm, const FQuat& Rotation)
+{
+    UE_LOG(LogSimpleCamera2, Warning,
+        TEXT("Stream %d camera pose received - Translation(cm): [%.2f, %.2f, %.2f], Rotation(xyzw): [%.4f, %.4f, %.4f, %.4f]"),
+        StreamId, TranslationCm.X, TranslationCm.Y, TranslationCm.Z, Rotation.X, Rotation.Y, Rotation.Z, Rotation.W);
+
+    FScopeLock ScopeLock(&CalibrationLock);
+    Calibration.PoseTranslation = TranslationCm;
+    Calibration.PoseRotation = Rotation;
+    Calibration.bPoseAvailable = true;
+}
+
+void FCameraStream::HandleStartupMilestone(int32 Milestone)
+{
+    if (Milestone > 0 && Milestone < static_cast<int32>(ECamera2StartupMilestone::Count))
+    {
+        StartupProfiler.Mark(static_cast<ECamera2StartupMilestone>(Milestone));
+    }
+}
+
+bool FCameraStream::HandleCharacteristics(const FCamera2CharacteristicsTablePtr& Table)
+{
+    {
+        FScopeLock ScopeLock(&CalibrationLock);
+        if (!Calibration.CameraId.IsEmpty() && Calibration.CameraId != Table->CameraId)
+        {
+            UE_LOG(LogSimpleCamera2, Log, TEXT("Stream %d dropped CameraCharacteristics of camera %s (now %s)"),
+                StreamId, *Table->CameraId, *Calibration.CameraId);
+            return false;
+        }
+
+        UE_LOG(LogSimpleCamera2, Log, TEXT("Stream %d received %d CameraCharacteristics of camera %s (%llu bytes)"),
+            StreamId, Table->Num(), *Table->CameraId, static_cast<uint64>(Table->GetAllocatedSize()));
+        Characteristics = Table;
+        CharacteristicsJsonPath.Reset();
+        bCharacteristicsRequested = false;
+    }
+
+    // Listeners run on the game thread; the stream may be closed by the time this runs
+    TWeakPtr<FCameraStream, ESPMode::ThreadSafe> WeakStream = AsShared();
+    AsyncTask(ENamedThreads::GameThread, [WeakStream, Table]()
+        {
+            TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = WeakStream.Pin();
+            if (!Stream.IsValid())
+            {
+                return;
+            }
+            {
+                // Skip a table a camera change or a newer dump replaced meanwhile
+                FScopeLock ScopeLock(&Stream->CalibrationLock);
+                if (Stream->Characteristics != Table)
+                {
+                    return;
+                }
+            }
+            Stream->OnCharacteristicsAvailable.Broadcast(Table);
+            if (UCamera2Subsystem* Subsystem = UCamera2Subsystem::Get())
+            {
+                Subsystem->OnCharacteristicsAvailable.Broadcast(Stream->GetStreamId());
+            }
+        });
+    return true;
+}
+
+// =============================================================================
+// JNI CALLBACKS
+// Each Camera2Helper passes its stream id; callbacks for closed streams are dropped.
+// =============================================================================
+
+#if PLATFORM_ANDROID
+extern "C" JNIEXPORT void JNICALL
+Java_com_epicgames_ue4_Camera2Helper_onFrameAvailable(
+    JNIEnv* env, jclass clazz, jint streamId, jbyteArray data, jint width, jint height,
+    jlongArray metadata, jlong sensorClockNowNs)
+{
+    // Read engine time first so the clock pair is as tight as possible
+    const double EngineNow = FPlatformTime::Seconds();
+
+    TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = UCamera2Subsystem::FindStreamForCallback(streamId);
+    if (!Stream.IsValid() || !Stream->IsActive() || !data)
+    {
+        return;
+    }
+
+    // Metadata arrives in a preallocated Java array; copy it out without pinning
+    jlong MetaValues[Camera2FrameMetadataLayout::FieldCount] = {};
+    if (metadata && env->GetArrayLength(metadata) >= Camera2FrameMetadataLayout::FieldCount)
+    {
+        env->GetLongArrayRegion(metadata, 0, Camera2FrameMetadataLayout::FieldCount, MetaValues);
+    }
+    int64 Metadata[Camera2FrameMetadataLayout::FieldCount];
+    for (int32 Index = 0; Index < Camera2FrameMetadataLayout::FieldCount; ++Index)
+    {
+        Metadata[Index] = MetaValues[Index];
+    }
+
+    // Get frame data from Java
+    jbyte* frameData = env->GetByteArrayElements(data, nullptr);
+    if (!frameData)
+    {
+        static bool bLoggedOnce = false;
+        if (!bLoggedOnce)
+        {
+            UE_LOG(LogSimpleCamera2, Error, TEXT("Failed to get frame data from Java"));
+            bLoggedOnce = true;
+        }
+        return;
+    }
+
+    Stream->HandleFrame(reinterpret_cast<const uint8*>(frameData), width, height,
+        Metadata, Camera2FrameMetadataLayout::FieldCount, sensorClockNowNs, EngineNow);
+
+    // Release Java array immediately
+    env->ReleaseByteArrayElements(data, frameData, JNI_ABORT);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_epicgames_ue4_Camera2Helper_onYuvFrameAvailable(
+    JNIEnv* env, jclass clazz, jint streamId, jobject yBuffer, jobject uBuffer, jobject vBuffer,
+    jint width, jint height, jint yRowStride, jint uvRowStride, jint uvPixelStride,
+    jlongArray metadata, jlong sensorClockNowNs)
+{
+    const double EngineNow = FPlatformTime::Seconds();
+
+    TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = UCamera2Subsystem::FindStreamForCallback(streamId);
+    if (!Stream.IsValid() || !Stream->IsActive() || !yBuffer || !uBuffer || !vBuffer)
+    {
+        return;
+    }
+
+    jlong MetaValues[Camera2FrameMetadataLayout::FieldCount] = {};
+    if (metadata && env->GetArrayLength(metadata) >= Camera2FrameMetadataLayout::FieldCount)
+    {
+        env->GetLongArrayRegion(metadata, 0, Camera2FrameMetadataLayout::FieldCount, MetaValues);
+    }
+    int64 Metadata[Camera2FrameMetadataLayout::FieldCount];
+    for (int32 Index = 0; Index < Camera2FrameMetadataLayout::FieldCount; ++Index)
+    {
+        Metadata[Index] = MetaValues[Index];
+    }
+
+    // Image plane buffers are direct, so this reads the camera buffer without a copy
+    FCamera2YuvPlanes Planes;
+    Planes.Y = static_cast<const uint8*>(env->GetDirectBufferAddress(yBuffer));
+    Planes.U = static_cast<const uint8*>(env->GetDirectBufferAddress(uBuffer));
+    Planes.V = static_cast<const uint8*>(env->GetDirectBufferAddress(vBuffer));
+    Planes.Width = width;
+    Planes.Height = height;
+    Planes.YRowStride = yRowStride;
+    Planes.UVRowStride = uvRowStride;
+    Planes.UVPixelStride = uvPixelStride;
+
+    if (!Planes.Y || !Planes.U || !Planes.V
+        || env->GetDirectBufferCapacity(yBuffer) < Planes.GetRequiredYBytes()
+        || env->GetDirectBufferCapacity(uBuffer) < Planes.GetRequiredUVBytes()
+        || env->GetDirectBufferCapacity(vBuffer) < Planes.GetRequiredUVBytes())
+    {
+        static bool bLoggedOnce = false;
+        if (!bLoggedOnce)
+        {
+            UE_LOG(LogSimpleCamera2, Error, TEXT("YUV planes are not direct buffers or are smaller than %dx%d needs"), width, height);
+            bLoggedOnce = true;
+        }
+        return;
+    }
+
+    Stream->HandleYuvFrame(Planes, Metadata, Camera2FrameMetadataLayout::FieldCount, sensorClockNowNs, EngineNow);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_epicgames_ue4_Camera2Helper_onStartupMilestone(JNIEnv* env, jclass clazz, jint streamId, jint milestone)
+{
+    if (TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = UCamera2Subsystem::FindStreamForCallback(streamId))
+    {
+        Stream->HandleStartupMilestone(milestone);
+    }
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_epicgames_ue4_Camera2Helper_onCharacteristicsAvailable(JNIEnv* env, jclass clazz,
+    jint streamId, jstring cameraIdStr, jint sdk, jobjectArray keysArray, jintArray entriesArray, jlongArray intsArray,
+    jfloatArray floatsArray, jobjectArray stringsArray)
+{
+    TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = UCamera2Subsystem::FindStreamForCallback(streamId);
+    if (!Stream.IsValid())
+    {
+        return;
+    }
+    if (!keysArray || !entriesArray || !intsArray || !floatsArray || !stringsArray)
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("Failed to receive CameraCharacteristics"));
+        return;
+    }
+
+    // Each array is copied once, straight into the table's arenas
+    auto ToStrings = [env](jobjectArray Array, TArray<FString>& OutStrings)
+        {
+            const jsize Length = env->GetArrayLength(Array);
+            OutStrings.SetNum(Length);
+            for (jsize Index = 0; Index < Length; ++Index)
+            {
+                JStringToFString(env, (jstring)env->GetObjectArrayElement(Array, Index), OutStrings[Index]);
+            }
+        };
+
+    TArray<FString> Keys;
+    TArray<FString> Strings;
+    ToStrings(keysArray, Keys);
+    ToStrings(stringsArray, Strings);
+
+    TArray<int32> Entries;
+    Entries.SetNumUninitialized(env->GetArrayLength(entriesArray));
+    env->GetIntArrayRegion(entriesArray, 0, Entries.Num(), reinterpret_cast<jint*>(Entries.GetData()));
+
+    TArray<int64> Ints;
+    Ints.SetNumUninitialized(env->GetArrayLength(intsArray));
+    env->GetLongArrayRegion(intsArray, 0, Ints.Num(), reinterpret_cast<jlong*>(Ints.GetData()));
+
+    TArray<float> Floats;
+    Floats.SetNumUninitialized(env->GetArrayLength(floatsArray));
+    env->GetFloatArrayRegion(floatsArray, 0, Floats.Num(), Floats.GetData());
+
+    TSharedRef<FCamera2CharacteristicsTable, ESPMode::ThreadSafe> Table = MakeShared<FCamera2CharacteristicsTable, ESPMode::ThreadSafe>();
+    JStringToFString(env, cameraIdStr, Table->CameraId);
+    Table->SdkVersion = sdk;
+    Table->Build(Keys, Entries, MoveTemp(Ints), MoveTemp(Floats), MoveTemp(Strings));
+
+    if (Stream->HandleCharacteristics(Table) && GEngine)
+    {
+        GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Silver, TEXT("CameraCharacteristics received"));
+    }
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_epicgames_ue4_Camera2Helper_onIntrinsicsAvailable(JNIEnv* env, jclass clazz,
+    jint streamId, jfloat fx, jfloat fy, jfloat cx, jfloat cy, jfloat skew, jint width, jint height)
+{
+    if (TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = UCamera2Subsystem::FindStreamForCallback(streamId))
+    {
+        Stream->HandleIntrinsics(fx, fy, cx, cy, skew, width, height);
+    }
+
+    if (GEngine)
+    {
+        GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Cyan,
+            FString::Printf(TEXT("Intrinsics fx=%.0f fy=%.0f cx=%.0f cy=%.0f"), fx, fy, cx, cy));
+    }
+}
+
+// JNI callback for SENSOR_INFO_PIXEL_ARRAY_SIZE
+extern "C" JNIEXPORT void JNICALL
+Java_com_epicgames_ue4_Camera2Helper_onPixelArraySizeAvailable(JNIEnv* env, jclass clazz,
+    jint streamId, jint width, jint height)
+{
+    UE_LOG(LogSimpleCamera2, Warning, TEXT("Stream %d pixel array size: %dx%d"), streamId, width, height);
+}
+
+// JNI callback for SENSOR_INFO_ACTIVE_ARRAY_SIZE
+extern "C" JNIEXPORT void JNICALL
+Java_com_epicgames_ue4_Camera2Helper_onActiveArraySizeAvailable(JNIEnv* env, jclass clazz,
+    jint streamId, jint width, jint height)
+{
+    UE_LOG(LogSimpleCamera2, Warning, TEXT("Stream %d active array size: %dx%d"), streamId, width, height);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_epicgames_ue4_Camera2Helper_onDistortionAvailable(JNIEnv* env, jclass clazz,
+    jint streamId, jfloatArray coeffs, jint length)
+{
+    TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = UCamera2Subsystem::FindStreamForCallback(streamId);
+    if (!Stream.IsValid())
+    {
+        return;
+    }
+
+    jfloat* distortionData = (coeffs && length > 0) ? env->GetFloatArrayElements(coeffs, nullptr) : nullptr;
+    Stream->HandleDistortion(distortionData, distortionData ? length : 0);
+    if (distortionData)
+    {
+        env->ReleaseFloatArrayElements(coeffs, distortionData, JNI_ABORT);
+        if (GEngine)
+        {
+            GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Magenta,
+                FString::Printf(TEXT("Lens Distortion: %d coeffs"), length));
+        }
+    }
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_com_epicgames_ue4_Camera2Helper_onOriginalResolutionAvailable(JNIEnv* env, jclass clazz,
+    jint streamId, jint width, jint height)
+{
+    UE_LOG(LogSimpleCamera2, Warning, TEXT("Stream %d original resolution received: %dx%d"), streamId, width, height);
+    if (TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = UCamera2Subsystem::FindStreamForCallback(streamId))
+    {
+        Stream->HandleOriginalResolution(width, height);
+    }
+}
+
+// JNI callback for camera selection (Quest 3: 50=left, 51=right)
+extern "C" JNIEXPORT void JNICALL
+Java_com_epicgames_ue4_Camera2Helper_onCameraSelected(JNIEnv* env, jclass clazz,
+    jint streamId, jstring cameraId, jboolean isLeftCamera)
+{
+    FString SelectedId = TEXT("unknown");
+    const char* IdChars = (cameraId != nullptr) ? env->GetStringUTFChars(cameraId, nullptr) : nullptr;
+    if (IdChars)
+    {
+        SelectedId = UTF8_TO_TCHAR(IdChars);
+        env->ReleaseStringUTFChars(cameraId, IdChars);
+    }
+
+    const bool bIsLeft = (isLeftCamera == JNI_TRUE);
+    if (TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = UCamera2Subsystem::FindStreamForCallback(streamId))
+    {
+        Stream->HandleCameraSelected(SelectedId, bIsLeft);
+    }
+
+    if (GEngine)
+    {
+        GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Cyan,
+            FString::Printf(TEXT("Camera: %s (%s)"), *SelectedId, bIsLeft ? TEXT("LEFT") : TEXT("RIGHT")));
+    }
+}
+
+// JNI callback for camera pose (CamInHmd transform)
+// Translation is in meters, rotation is quaternion (x,y,z,w) in Android/OpenGL convention
+extern "C" JNIEXPORT void JNICALL
+Java_com_epicgames_ue4_Camera2Helper_onCameraPoseAvailable(JNIEnv* env, jclass clazz,
+    jint streamId, jfloat tx, jfloat ty, jfloat tz, jfloat qx, jfloat qy, jfloat qz, jfloat qw)
+{
+    // Same conversion as the hardcoded calibration (validated against Meta's Unity sample)
+    const FVector Translation = Quest3Calibration::ConvertTranslationToUE(tx, ty, tz);
+    const FQuat Rotation = Quest3Calibration::ConvertRotationToUE(qx, qy, qz, qw);
+
+    if (TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = UCamera2Subsystem::FindStreamForCallback(streamId))
+    {
+        Stream->HandleCameraPose(Translation, Rotation);
+    }
+
+    if (GEngine)
+    {
+        GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Green,
+            FString::Printf(TEXT("CamInHmd: [%.1f, %.1f, %.1f] cm"), Translation.X, Translation.Y, Translation.Z));
+    }
+}
+#endif
@@ -0,0 +1,277 @@
+#include "Camera2Subsystem.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/ScopeLock.h"
+
+static TAutoConsoleVariable<int32> CVarCamera2PauseInBackground(
+    TEXT("Camera2.PauseInBackground"),
+    1,
+    TEXT("Put running camera streams into warm standby while the app is in the background."),
+    ECVF_Default);
+
+// Camera threads resolve streams through this; cleared before the subsystem is destroyed
+static FCriticalSection GActiveSubsystemLock;
+static UCamera2Subsystem* GActiveSubsystem = nullptr;
+
+void UCamera2Subsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    WillEnterBackgroundHandle = FCoreDelegates::ApplicationWillEnterBackgroundDelegate.AddUObject(
+        this, &UCamera2Subsystem::HandleApplicationWillEnterBackground);
+    HasEnteredForegroundHandle = FCoreDelegates::ApplicationHasEnteredForegroundDelegate.AddUObject(
+        this, &UCamera2Subsystem::HandleApplicationHasEnteredForeground);
+    FrameNotifyTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateUObject(this, &UCamera2Subsystem::TickFrameNotifications));
+
+    FScopeLock ScopeLock(&GActiveSubsystemLock);
+    GActiveSubsystem = this;
+}
+
+void UCamera2Subsystem::Deinitialize()
+{
+    {
+        FScopeLock ScopeLock(&GActiveSubsystemLock);
+        GActiveSubsystem = nullptr;
+    }
+
+    FCoreDelegates::ApplicationWillEnterBackgroundDelegate.Remove(WillEnterBackgroundHandle);
+    FCoreDelegates::ApplicationHasEnteredForegroundDelegate.Remove(HasEnteredForegroundHandle);
+    FTSTicker::GetCoreTicker().RemoveTicker(FrameNotifyTickerHandle);
+    StreamsPausedForBackground.Reset();
+    NotifiedFrameSequences.Reset();
+
+    TArray<TSharedPtr<FCameraStream, ESPMode::ThreadSafe>> ToStop;
+    {
+        FScopeLock ScopeLock(&StreamsLock);
+        Streams.GenerateValueArray(ToStop);
+        Streams.Empty();
+    }
+    for (const TSharedPtr<FCameraStream, ESPMode::ThreadSafe>& Stream : ToStop)
+    {
+        Stream->Stop();
+    }
+
+    Super::Deinitialize();
+}
+
+UCamera2Subsystem* UCamera2Subsystem::Get()
+{
+    return GEngine ? GEngine->GetEngineSubsystem<UCamera2Subsystem>() : nullptr;
+}
+
+int32 UCamera2Subsystem::OpenStream(bool bUseLeftCamera)
+{
+    UCamera2Subsystem* Subsystem = Get();
+    if (!Subsystem)
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("OpenStream: Camera2 subsystem not available"));
+        return INDEX_NONE;
+    }
+
+    TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream;
+    {
+        FScopeLock ScopeLock(&Subsystem->StreamsLock);
+        const int32 StreamId = Subsystem->NextStreamId++;
+        Stream = MakeShared<FCameraStream, ESPMode::ThreadSafe>(StreamId, bUseLeftCamera);
+        Subsystem->Streams.Add(StreamId, Stream);
+    }
+
+    if (!Stream->Start())
+    {
+        CloseStream(Stream->GetStreamId());
+        return INDEX_NONE;
+    }
+    return Stream->GetStreamId();
+}
+
+void UCamera2Subsystem::CloseStream(int32 StreamId)
+{
+    UCamera2Subsystem* Subsystem = Get();
+    if (!Subsystem)
+    {
+        return;
+    }
+
+    TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream;
+    {
+        FScopeLock ScopeLock(&Subsystem->StreamsLock);
+        Subsystem->Streams.RemoveAndCopyValue(StreamId, Stream);
+    }
+    Subsystem->NotifiedFrameSequences.Remove(StreamId);
+
+    if (Stream.IsValid())
+    {
+        Stream->Stop();
+    }
+    else
+    {
+        UE_LOG(LogSimpleCamera2, Warning, TEXT("CloseStream: no stream with id %d"), StreamId);
+    }
+}
+
+UTexture2D* UCamera2Subsystem::GetStreamTexture(int32 StreamId)
+{
+    UCamera2Subsystem* Subsystem = Get();
+    TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = Subsystem ? Subsystem->FindStream(StreamId) : nullptr;
+    return Stream.IsValid() ? Stream->GetTexture() : nullptr;
+}
+
+void UCamera2Subsystem::BindStreamTextureToMaterial(int32 StreamId, UMaterialInstanceDynamic* Material, FName ParameterName)
+{
+    UCamera2Subsystem* Subsystem = Get();
+    TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = Subsystem ? Subsystem->FindStream(StreamId) : nullptr;
+    if (Stream.IsValid())
+    {
+        Stream->BindTextureParameter(Material, ParameterName);
+    }
+    else
+    {
+        UE_LOG(LogSimpleCamera2, Warning, TEXT("BindStreamTextureToMaterial: no stream with id %d"), StreamId);
+    }
+}
+
+bool UCamera2Subsystem::IsStreamActive(int32 StreamId)
+{
+    UCamera2Subsystem* Subsystem = Get();
+    TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = Subsystem ? Subsystem->FindStream(StreamId) : nullptr;
+    return Stream.IsValid() && Stream->IsActive();
+}
+
+bool UCamera2Subsystem::PauseStream(int32 StreamId)
+{
+    UCamera2Subsystem* Subsystem = Get();
+    TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = Subsystem ? Subsystem->FindStream(StreamId) : nullptr;
+    return Stream.IsValid() && Stream->Pause();
+}
+
+bool UCamera2Subsystem::ResumeStream(int32 StreamId)
+{
+    UCamera2Subsystem* Subsystem = Get();
+    TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = Subsystem ? Subsystem->FindStream(StreamId) : nullptr;
+    return Stream.IsValid() && Stream->Resume();
+}
+
+bool UCamera2Subsystem::IsStreamPaused(int32 StreamId)
+{
+    UCamera2Subsystem* Subsystem = Get();
+    TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = Subsystem ? Subsystem->FindStream(StreamId) : nullptr;
+    return Stream.IsValid() && Stream->IsPaused();
+}
+
+void UCamera2Subsystem::HandleApplicationWillEnterBackground()
+{
+    if (CVarCamera2PauseInBackground.GetValueOnGameThread() == 0)
+    {
+        return;
+    }
+
+    TArray<TSharedPtr<FCameraStream, ESPMode::ThreadSafe>> Running;
+    {
+        FScopeLock ScopeLock(&StreamsLock);
+        for (const TPair<int32, TSharedPtr<FCameraStream, ESPMode::ThreadSafe>>& Pair : Streams)
+        {
+            if (Pair.Value->IsActive() && !Pair.Value->IsPaused())
+            {
+                Running.Add(Pair.Value);
+            }
+        }
+    }
+
+    // Streams the app paused itself stay paused on return
+    for (const TSharedPtr<FCameraStream, ESPMode::ThreadSafe>& Stream : Running)
+    {
+        if (Stream->Pause())
+        {
+            StreamsPausedForBackground.Add(Stream);
+        }
+    }
+}
+
+void UCamera2Subsystem::HandleApplicationHasEnteredForeground()
+{
+    TArray<TWeakPtr<FCameraStream, ESPMode::ThreadSafe>> ToResume = MoveTemp(StreamsPausedForBackground);
+    for (const TWeakPtr<FCameraStream, ESPMode::ThreadSafe>& WeakStream : ToResume)
+    {
+        if (TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = WeakStream.Pin())
+        {
+            Stream->Resume();
+        }
+    }
+}
+
+bool UCamera2Subsystem::TickFrameNotifications(float DeltaTime)
+{
+    TArray<TSharedPtr<FCameraStream, ESPMode::ThreadSafe>, TInlineAllocator<4>> Snapshot;
+    {
+        FScopeLock ScopeLock(&StreamsLock);
+        for (const TPair<int32, TSharedPtr<FCameraStream, ESPMode::ThreadSafe>>& Pair : Streams)
+        {
+            Snapshot.Add(Pair.Value);
+        }
+    }
+
+    // Several frames uploaded since the last tick collapse into one notification for the newest
+    for (const TSharedPtr<FCameraStream, ESPMode::ThreadSafe>& Stream : Snapshot)
+    {
+        const int64 FrameSequence = Stream->GetFrameSequence();
+        int64& Notified = NotifiedFrameSequences.FindOrAdd(Stream->GetStreamId(), INDEX_NONE);
+        if (FrameSequence == Notified)
+        {
+            continue;
+        }
+        Notified = FrameSequence;
+
+        FCamera2FrameMetadata Metadata;
+        if (FrameSequence >= 0 && Stream->GetLatestFrameMetadata(Metadata))
+        {
+            OnCameraFrameNative.Broadcast(Stream->GetStreamId(), Metadata);
+            OnCameraFrame.Broadcast(Stream->GetStreamId(), Metadata);
+        }
+    }
+    return true;
+}
+
+TArray<int32> UCamera2Subsystem::GetOpenStreamIds()
+{
+    TArray<int32> Ids;
+    if (UCamera2Subsystem* Subsystem = Get())
+    {
+        FScopeLock ScopeLock(&Subsystem->StreamsLock);
+        Subsystem->Streams.GetKeys(Ids);
+        Ids.Sort();
+    }
+    return Ids;
+}
+
+int64 UCamera2Subsystem::GetStreamFrameSequence(int32 StreamId)
+{
+    UCamera2Subsystem* Subsystem = Get();
+    TSharedPtr<FCameraStream, ESPMode::ThreadSafe> Stream = Subsystem ? Subsystem->FindStream(StreamId) : nullptr;
+    return Stream.IsValid() ? Stream->GetFrameSequence() : INDEX_NONE;
+}
+
+TSharedPtr<FCameraStream, ESPMode::ThreadSafe> UCamera2Subsystem::FindStream(int32 StreamId) const
+{
+    FScopeLock ScopeLock(&StreamsLock);
+    const TSharedPtr<FCameraStream, ESPMode::ThreadSafe>* Found = Streams.Find(StreamId);
+    return Found ? *Found : nullptr;
+}
+
+TSharedPtr<FCameraStream, ESPMode::ThreadSafe> UCamera2Subsystem::GetOrCreateDefaultStream()
+{
+    FScopeLock ScopeLock(&StreamsLock);
+    TSharedPtr<FCameraStream, ESPMode::ThreadSafe>& Stream = Streams.FindOrAdd(DefaultStreamId);
+    if (!Stream.IsValid())
+    {
+        Stream = MakeShared<FCameraStream, ESPMode::ThreadSafe>(DefaultStreamId, bDefaultPreferLeftCamera);
+    }
+    return Stream;
+}
+
+TSharedPtr<FCameraStream, ESPMode::ThreadSafe> UCamera2Subsystem::FindStreamForCallback(int32 StreamId)
+{
+    FScopeLock ScopeLock(&GActiveSubsystemLock);
+    return GActiveSubsystem ? GActiveSubsystem->FindStream(StreamId) : nullptr;
+}
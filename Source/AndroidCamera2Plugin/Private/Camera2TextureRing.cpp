@@ -0,0 +1,390 @@
+#include "Camera2TextureRing.h"
+#include "Camera2ImageConversion.h"
+#include "SimpleCamera2Test.h"
+#include "Engine/Texture2D.h"
+#include "HAL/IConsoleManager.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "RHICommandList.h"
+#include "Rendering/Texture2DResource.h"
+#include "RenderingThread.h"
+
+static TAutoConsoleVariable<int32> CVarCamera2TextureRetireFrames(
+    TEXT("Camera2.Texture.RetireFrames"),
+    1,
+    TEXT("Frames a camera texture stays out of use after it stopped being the published one, for GPU work still in flight."),
+    ECVF_Default);
+
+FCamera2TextureRing::~FCamera2TextureRing()
+{
+    Release();
+}
+
+int32 FCamera2TextureRing::GetRetireFrames()
+{
+    return FMath::Max(CVarCamera2TextureRetireFrames.GetValueOnGameThread(), 0);
+}
+
+bool FCamera2TextureRing::Create(int32 Width, int32 Height, int32 NumBuffers, bool bAutoTick, EPixelFormat Format, int32 InNumMips)
+{
+    check(IsInGameThread());
+    Release();
+
+    Size = FIntPoint(Width, Height);
+    BytesPerPixel = GPixelFormats[Format].BlockBytes;
+    NumMips = FMath::Clamp(InNumMips, 1, Camera2ImageConversion::GetNumMips(Width, Height));
+    Slots.SetNum(FMath::Clamp(NumBuffers, 1, 8));
+    for (int32 Index = 0; Index < Slots.Num(); ++Index)
+    {
+        UTexture2D* Texture = UTexture2D::CreateTransient(Width, Height, Format);
+        if (!Texture)
+        {
+            UE_LOG(LogSimpleCamera2, Error, TEXT("Texture ring: failed to create texture %d of %d (%dx%d)"),
+                Index + 1, Slots.Num(), Width, Height);
+            Release();
+            return false;
+        }
+        Texture->AddToRoot(); // Prevent garbage collection
+
+        // CreateTransient makes level 0 only; the lower levels are written by uploads, never streamed
+        for (int32 Mip = 1; Mip < NumMips; ++Mip)
+        {
+            const int32 MipWidth = FMath::Max(Width >> Mip, 1);
+            const int32 MipHeight = FMath::Max(Height >> Mip, 1);
+            FTexture2DMipMap* MipMap = new FTexture2DMipMap(MipWidth, MipHeight);
+            MipMap->BulkData.Lock(LOCK_READ_WRITE);
+            FMemory::Memzero(MipMap->BulkData.Realloc(static_cast<int64>(MipWidth) * MipHeight * BytesPerPixel),
+                static_cast<int64>(MipWidth) * MipHeight * BytesPerPixel);
+            MipMap->BulkData.Unlock();
+            Texture->GetPlatformData()->Mips.Add(MipMap);
+        }
+        Texture->NeverStream = true;
+        Texture->UpdateResource();
+        Slots[Index].Texture = Texture;
+
+        // Initialize with a dark pattern so the first frames don't show garbage
+        const int64 InitSize = Camera2ImageConversion::GetMipChainBytes(Width, Height, BytesPerPixel, NumMips);
+        uint8* InitData = new uint8[InitSize];
+        FMemory::Memset(InitData, 64, InitSize); // Dark gray
+        EnqueueUpload(Index, { FIntRect(0, 0, Width, Height) }, InitData, NumMips);
+    }
+
+    // Start out showing slot 0; the others become free once their clear has run
+    Slots[0].State = ESlotState::Published;
+    PublishedSlot = 0;
+    for (int32 Index = 1; Index < Slots.Num(); ++Index)
+    {
+        Slots[Index].State = ESlotState::Retiring;
+        Slots[Index].RetiredFrame = FrameIndex - GetRetireFrames();
+    }
+    UpdateMaterialBindings();
+
+    if (bAutoTick)
+    {
+        TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this](float)
+            {
+                Tick();
+                return true;
+            }));
+    }
+
+    UE_LOG(LogSimpleCamera2, Log, TEXT("Texture ring: %d x %dx%d camera textures (%s, %d mips)"), Slots.Num(), Width, Height,
+        GPixelFormats[Format].Name, NumMips);
+    return true;
+}
+
+void FCamera2TextureRing::Release()
+{
+    if (TickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+        TickerHandle.Reset();
+    }
+
+    if (Slots.Num() == 0)
+    {
+        return;
+    }
+
+    FlushRenderingCommands();
+    for (FSlot& Slot : Slots)
+    {
+        if (Slot.Texture)
+        {
+            Slot.Texture->RemoveFromRoot();
+        }
+    }
+    Slots.Reset();
+    PublishedSlot = INDEX_NONE;
+}
+
+UTexture2D* FCamera2TextureRing::GetTexture() const
+{
+    return Slots.IsValidIndex(PublishedSlot) ? Slots[PublishedSlot].Texture : nullptr;
+}
+
+void FCamera2TextureRing::BindMaterialParameter(UMaterialInstanceDynamic* Material, FName ParameterName)
+{
+    if (!Material)
+    {
+        return;
+    }
+
+    MaterialBindings.RemoveAll([Material, ParameterName](const FMaterialBinding& Binding)
+        {
+            return !Binding.Material.IsValid() || (Binding.Material.Get() == Material && Binding.ParameterName == ParameterName);
+        });
+    MaterialBindings.Add({ Material, ParameterName });
+
+    if (UTexture2D* Texture = GetTexture())
+    {
+        Material->SetTextureParameterValue(ParameterName, Texture);
+    }
+}
+
+int32 FCamera2TextureRing::Upload(TArray<FIntRect> Rects, uint8* Data, int32 NumDataMips)
+{
+    check(IsInGameThread());
+    if (Slots.Num() == 0)
+    {
+        delete[] Data;
+        return INDEX_NONE;
+    }
+
+    ++Stats.Uploads;
+
+    // A single texture is updated in place, as before the ring existed
+    if (Slots.Num() == 1)
+    {
+        EnqueueUpload(0, MoveTemp(Rects), Data, NumDataMips);
+        return 0;
+    }
+
+    UpdateSlots();
+
+    // Least recently used free slot
+    int32 Target = INDEX_NONE;
+    for (int32 Index = 0; Index < Slots.Num(); ++Index)
+    {
+        if (Slots[Index].State == ESlotState::Free
+            && (Target == INDEX_NONE || Slots[Index].UploadSerial < Slots[Target].UploadSerial))
+        {
+            Target = Index;
+        }
+    }
+
+    if (Target == INDEX_NONE)
+    {
+        ++Stats.Dropped;
+        delete[] Data;
+        return INDEX_NONE;
+    }
+
+    EnqueueUpload(Target, MoveTemp(Rects), Data, NumDataMips);
+    return Target;
+}
+
+void FCamera2TextureRing::EnqueueUpload(int32 Slot, TArray<FIntRect> Rects, uint8* Data, int32 NumDataMips)
+{
+    FSlot& Target = Slots[Slot];
+    FTexture2DResource* TextureResource = static_cast<FTexture2DResource*>(Target.Texture->GetResource());
+    if (!TextureResource)
+    {
+        delete[] Data;
+        return;
+    }
+
+    // Lower levels only follow a whole level 0
+    const bool bFullFrame = Rects.Num() == 1 && Rects[0] == FIntRect(FIntPoint::ZeroValue, Size);
+    const int32 UploadMips = bFullFrame ? FMath::Clamp(NumDataMips, 1, NumMips) : 1;
+
+    ENQUEUE_RENDER_COMMAND(UpdateCameraTexture2D)(
+        [TextureResource, Rects = MoveTemp(Rects), Data, BytesPerPixel = BytesPerPixel, UploadMips, Size = Size](FRHICommandListImmediate& RHICmdList)
+        {
+            const uint8* Src = Data;
+            for (const FIntRect& Rect : Rects)
+            {
+                const uint32 SrcPitch = static_cast<uint32>(Rect.Width() * BytesPerPixel);
+                FUpdateTextureRegion2D Region(static_cast<uint32>(Rect.Min.X), static_cast<uint32>(Rect.Min.Y), 0, 0,
+                    static_cast<uint32>(Rect.Width()), static_cast<uint32>(Rect.Height()));
+                RHICmdList.UpdateTexture2D(TextureResource->GetTexture2DRHI(), 0, Region, SrcPitch, Src);
+                Src += static_cast<int64>(Rect.Area()) * BytesPerPixel;
+            }
+            for (int32 Mip = 1; Mip < UploadMips; ++Mip)
+            {
+                const uint32 MipWidth = static_cast<uint32>(FMath::Max(Size.X >> Mip, 1));
+                const uint32 MipHeight = static_cast<uint32>(FMath::Max(Size.Y >> Mip, 1));
+                RHICmdList.UpdateTexture2D(TextureResource->GetTexture2DRHI(), Mip, FUpdateTextureRegion2D(0, 0, 0, 0, MipWidth, MipHeight),
+                    MipWidth * BytesPerPixel, Src);
+                Src += static_cast<int64>(MipWidth) * MipHeight * BytesPerPixel;
+            }
+            delete[] Data;
+        });
+
+    if (Slots.Num() > 1)
+    {
+        Target.State = ESlotState::Uploading;
+        Target.UploadSerial = NextUploadSerial++;
+        Target.Fence.BeginFence();
+    }
+}
+
+void FCamera2TextureRing::UpdateSlots()
+{
+    // Newest upload the render thread has executed; older completed ones are already stale
+    int32 Newest = INDEX_NONE;
+    for (int32 Index = 0; Index < Slots.Num(); ++Index)
+    {
+        FSlot& Slot = Slots[Index];
+        if (Slot.State == ESlotState::Uploading && Slot.Fence.IsFenceComplete()
+            && (Newest == INDEX_NONE || Slot.UploadSerial > Slots[Newest].UploadSerial))
+        {
+            Newest = Index;
+        }
+    }
+    if (Newest != INDEX_NONE)
+    {
+        for (int32 Index = 0; Index < Slots.Num(); ++Index)
+        {
+            FSlot& Slot = Slots[Index];
+            if (Index != Newest && Slot.State == ESlotState::Uploading && Slot.UploadSerial < Slots[Newest].UploadSerial
+                && Slot.Fence.IsFenceComplete())
+            {
+                // Never published, so nothing can be sampling it
+                Slot.State = ESlotState::Free;
+                ++Stats.Superseded;
+            }
+        }
+        Publish(Newest);
+    }
+
+    const int32 RetireFrames = GetRetireFrames();
+    for (FSlot& Slot : Slots)
+    {
+        if (Slot.State == ESlotState::Retiring && Slot.Fence.IsFenceComplete() && FrameIndex - Slot.RetiredFrame >= RetireFrames)
+        {
+            Slot.State = ESlotState::Free;
+        }
+    }
+}
+
+void FCamera2TextureRing::Publish(int32 Slot)
+{
+    if (Slots.IsValidIndex(PublishedSlot))
+    {
+        // Commands enqueued so far may still reference the old texture; reuse it once they ran
+        FSlot& Previous = Slots[PublishedSlot];
+        Previous.State = ESlotState::Retiring;
+        Previous.RetiredFrame = FrameIndex;
+        Previous.Fence.BeginFence();
+    }
+
+    Slots[Slot].State = ESlotState::Published;
+    PublishedSlot = Slot;
+    ++Stats.Published;
+    UpdateMaterialBindings();
+}
+
+void FCamera2TextureRing::UpdateMaterialBindings()
+{
+    UTexture2D* Texture = GetTexture();
+    for (int32 Index = MaterialBindings.Num() - 1; Index >= 0; --Index)
+    {
+        if (UMaterialInstanceDynamic* Material = MaterialBindings[Index].Material.Get())
+        {
+            Material->SetTextureParameterValue(MaterialBindings[Index].ParameterName, Texture);
+        }
+        else
+        {
+            MaterialBindings.RemoveAtSwap(Index);
+        }
+    }
+}
+
+void FCamera2TextureRing::Tick()
+{
+    ++FrameIndex;
+    if (Slots.Num() > 1)
+    {
+        UpdateSlots();
+    }
+}
+
+// =============================================================================
+// SELF TEST (runs with -nullrhi)
+// =============================================================================
+
+static void RunTextureRingTest(int32 NumFrames, int32 NumBuffers)
+{
+    FCamera2TextureRing Ring;
+    if (!Ring.Create(64, 64, NumBuffers, false))
+    {
+        UE_LOG(LogSimpleCamera2, Error, TEXT("Texture ring test: could not create textures"));
+        return;
+    }
+
+    const int32 RetireFrames = FCamera2TextureRing::GetRetireFrames();
+    TMap<int32, int32> LastPublishedFrame; // slot -> last frame it was the published slot
+    int32 Hazards = 0;
+    int32 StaleAfterFlush = 0;
+    int32 LastUploadedSlot = INDEX_NONE;
+    FRandomStream Random(1234);
+
+    for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        // Camera frames arrive unevenly relative to engine frames: 0-2 uploads per frame
+        const int32 NumUploads = Random.RandRange(0, 2);
+        for (int32 Upload = 0; Upload < NumUploads; ++Upload)
+        {
+            const int32 PublishedBefore = Ring.GetPublishedSlot();
+            const int32 Slot = Ring.Upload({ FIntRect(0, 0, 64, 64) }, new uint8[64 * 64 * 4]);
+            if (Slot == INDEX_NONE)
+            {
+                continue;
+            }
+            LastUploadedSlot = Slot;
+
+            // The upload must not target what is shown now or what was shown in the last RetireFrames frames
+            const int32* ShownAt = LastPublishedFrame.Find(Slot);
+            if (NumBuffers > 1 && (Slot == PublishedBefore || (ShownAt && Frame - *ShownAt <= RetireFrames)))
+            {
+                ++Hazards;
+            }
+        }
+
+        // Let the render thread catch up now and then, as a slow frame would
+        if (Random.FRand() < 0.3f)
+        {
+            FlushRenderingCommands();
+            Ring.Tick();
+            if (NumBuffers > 1 && LastUploadedSlot != INDEX_NONE && Ring.GetPublishedSlot() != LastUploadedSlot)
+            {
+                ++StaleAfterFlush;
+            }
+        }
+        else
+        {
+            Ring.Tick();
+        }
+
+        LastPublishedFrame.Add(Ring.GetPublishedSlot(), Frame);
+    }
+
+    const FCamera2TextureRing::FStats Stats = Ring.GetStats();
+    Ring.Release();
+
+    const bool bPassed = Hazards == 0 && StaleAfterFlush == 0 && Stats.Published > 0;
+    UE_LOG(LogSimpleCamera2, Display,
+        TEXT("Texture ring test %s: %d buffers, %d frames, %lld uploads, %lld published, %lld dropped, %lld superseded, %d hazards, %d stale after flush"),
+        bPassed ? TEXT("PASSED") : TEXT("FAILED"), NumBuffers, NumFrames, Stats.Uploads, Stats.Published, Stats.Dropped,
+        Stats.Superseded, Hazards, StaleAfterFlush);
+}
+
+static FAutoConsoleCommand GCamera2TextureRingTestCommand(
+    TEXT("Camera2.Texture.RingTest"),
+    TEXT("Exercise the camera texture ring's fencing with random upload timing. Args: [Frames=600] [Buffers=3]"),
+    FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+    {
+        const int32 NumFrames = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 600;
+        const int32 NumBuffers = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 3;
+        RunTextureRingTest(FMath::Max(NumFrames, 1), FMath::Clamp(NumBuffers, 1, 8));
+    }));
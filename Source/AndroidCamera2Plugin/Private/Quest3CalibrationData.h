@@ -0,0 +1,127 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// =============================================================================
+// QUEST 3 HARDCODED CALIBRATION DATA
+// Extracted from actual Quest 3 device dumps - these are the reference values
+// =============================================================================
+namespace Quest3Calibration
+{
+    // Native sensor resolution (both cameras)
+    constexpr int32 NativeWidth = 1280;
+    constexpr int32 NativeHeight = 1280;
+    
+    // LEFT CAMERA (ID 50) - Native 1280x1280 intrinsics (from JSON dump)
+    constexpr float LeftFx = 870.6005249023438f;
+    constexpr float LeftFy = 870.6005249023438f;
+    constexpr float LeftCx = 640.2453002929688f;
+    constexpr float LeftCy = 641.2428588867188f;
+    
+    // LEFT CAMERA pose in HMD space (meters, gyroscope reference)
+    // Translation: [-0.03187, -0.01716, -0.06286] meters
+    // Rotation: quaternion [x,y,z,w] from JSON (Android Camera2 order)
+    // JSON: "rotation":[-0.9951009154319763,-0.0002342800289625302,-0.005589410196989775,0.09870576858520508]
+    // Note: This is in Android/OpenGL convention
+    constexpr float LeftTx = -0.03187057375907898f;
+    constexpr float LeftTy = -0.01715778559446335f;
+    constexpr float LeftTz = -0.06285717338323593f;
+    constexpr float LeftQx = -0.9951009154319763f;
+    constexpr float LeftQy = -0.0002342800289625302f;
+    constexpr float LeftQz = -0.005589410196989775f;
+    constexpr float LeftQw = 0.09870576858520508f;
+    
+    // RIGHT CAMERA (ID 51) - Native 1280x1280 intrinsics
+    constexpr float RightFx = 869.4124755859375f;
+    constexpr float RightFy = 869.4124755859375f;
+    constexpr float RightCx = 635.97998046875f;
+    constexpr float RightCy = 636.2386474609375f;
+    
+    // RIGHT CAMERA pose in HMD space (meters, gyroscope reference)
+    // Translation: [0.03175, -0.01712, -0.06281] meters
+    // Rotation: quaternion [x,y,z,w] from JSON (Android Camera2 order)
+    // JSON: "rotation":[-0.9954029321670532,-0.00033292744774371386,0.00344613054767251,0.09571301192045212]
+    constexpr float RightTx = 0.031745150685310367f;
+    constexpr float RightTy = -0.017119500786066057f;
+    constexpr float RightTz = -0.06280999630689621f;
+    constexpr float RightQx = -0.9954029321670532f;
+    constexpr float RightQy = -0.00033292744774371386f;
+    constexpr float RightQz = 0.00344613054767251f;
+    constexpr float RightQw = 0.09571301192045212f;
+    
+    // Convert Android/OpenGL pose to UE coordinate system
+    // Android Camera2: X-right, Y-up, Z-backward (toward user), right-handed
+    // UE: X-forward, Y-right, Z-up, left-handed
+    //
+    // VALIDATED AGAINST META'S OFFICIAL UNITY SAMPLE:
+    // Unity uses: MRUK.FlipZ(translation) and complex quaternion transform
+    // Result: ~11° downward pitch for Quest 3 passthrough cameras
+    
+    inline FVector ConvertTranslationToUE(float tx, float ty, float tz)
+    {
+        // Meta Unity approach: FlipZ (negate Z)
+        // Then coordinate system transform: Android → UE
+        // Android: X-right, Y-up, Z-backward → After FlipZ: X-right, Y-up, Z-forward
+        // UE: X-forward, Y-right, Z-up
+        //
+        // So: UE_X = Android_Z (after flip = -original_Z)
+        //     UE_Y = Android_X
+        //     UE_Z = Android_Y
+        // Convert meters to cm
+        return FVector(-tz * 100.0f, tx * 100.0f, ty * 100.0f);
+    }
+    
+    inline FQuat ConvertRotationToUE(float qx, float qy, float qz, float qw)
+    {
+        // =========================================================================
+        // QUATERNION CONVERSION - VALIDATED AGAINST META'S UNITY SAMPLE
+        // =========================================================================
+        // Meta's Unity sample produces Euler angles: (11.24°, 0.26°, 359.50°)
+        // This represents approximately 11° downward tilt for Quest 3 cameras.
+        //
+        // The Quest 3 cameras physically point ~11° downward to better capture
+        // hand interactions. In UE coordinates, this should be ~-11° pitch
+        // (negative pitch = looking down).
+        //
+        // Meta Unity transform:
+        //   Quaternion.Inverse(new Quaternion(-x, -y, z, w)) * Quaternion.Euler(180, 0, 0)
+        // =========================================================================
+        
+        // Combined steps 1-2: Start with (-qx,-qy,qz,qw), then conjugate gives (qx,qy,-qz,qw)
+        float ax = qx;
+        float ay = qy;
+        float az = -qz;
+        float aw = qw;
+        
+        // Normalize
+        float mag = FMath::Sqrt(ax*ax + ay*ay + az*az + aw*aw);
+        if (mag > SMALL_NUMBER)
+        {
+            ax /= mag; ay /= mag; az /= mag; aw /= mag;
+        }
+        
+        // Step 3: Multiply by 180° rotation around X: R = (1, 0, 0, 0)
+        // result.x = qw, result.y = qz, result.z = -qy, result.w = -qx
+        float bx = aw;
+        float by = az;
+        float bz = -ay;
+        float bw = -ax;
+        
+        // Step 4: Convert Unity (X-right, Y-up, Z-forward) to UE (X-forward, Y-right, Z-up)
+        // Axis mapping: Unity_Z → UE_X, Unity_X → UE_Y, Unity_Y → UE_Z
+        //
+        // Unity X (right) is the pitch axis; UE Y (right) is the pitch axis.
+        // Both engines are left-handed, so positive rotation around the right
+        // axis tilts the forward vector DOWNWARD in both systems.
+        // Therefore the pitch component maps 1:1 -- NO sign flip.
+        //
+        // Previous code had "-bx" which INVERTED the camera's 11° downward
+        // tilt to 11° upward, causing every tag's world position to have a
+        // ~38% vertical error that rotated with HMD orientation -- the root
+        // cause of catastrophic Z-component disagreement between players.
+        FQuat UEQuat(bz, bx, by, bw);
+        UEQuat.Normalize();
+        
+        return UEQuat;
+    }
+}
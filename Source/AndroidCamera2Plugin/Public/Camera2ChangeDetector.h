@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/BitArray.h"
+#include <atomic>
+
+/**
+ * Decides whether a frame differs enough from the last processed one to be worth processing.
+ *
+ * The luma is box-averaged onto a coarse grid (Camera2.Change.GridStep pixels per cell) and
+ * compared with the grid of the last processed frame in tiles of Camera2.Change.TileCells cells;
+ * a tile changed when its mean absolute difference exceeds Camera2.Change.Threshold. A frame with
+ * no changed tile is skipped, but never more than Camera2.Change.MaxSkip frames in a row. The
+ * reference only moves on processed frames, so slow drift still adds up to a change.
+ *
+ * Evaluate runs on the camera thread; Reset and GetStats may be called from any thread.
+ */
+class ANDROIDCAMERA2PLUGIN_API FCamera2ChangeDetector
+{
+public:
+    struct FStats
+    {
+        int64 FramesEvaluated = 0;
+        int64 FramesSkipped = 0;
+        // Unchanged frames processed anyway because Camera2.Change.MaxSkip was reached
+        int64 FramesForced = 0;
+
+        float GetSkipRate() const { return FramesEvaluated > 0 ? static_cast<float>(FramesSkipped) / FramesEvaluated : 0.0f; }
+    };
+
+    /** Whether Camera2.Change.Enable is set. */
+    static bool IsEnabled();
+
+    /**
+     * Compare a frame's luma with the last processed frame. PixelStride 4 over a gray BGRA frame works too.
+     * @return false if the frame is unchanged and should be skipped
+     */
+    bool Evaluate(const uint8* Luma, int32 Width, int32 Height, int32 RowStride, int32 PixelStride);
+
+    /** Largest per-tile mean difference (0-255) of the last evaluated frame, -1 when it had no reference. */
+    float GetLastScore() const { return LastScore; }
+
+    /** Tiles of the last evaluated frame that changed, row-major over GetTileCount() (camera thread). */
+    const TBitArray<>& GetChangedTiles() const { return ChangedTiles; }
+    FIntPoint GetTileCount() const { return TileCount; }
+
+    /** Drop the reference so the next frame is processed. */
+    void Reset() { bResetRequested = true; }
+
+    FStats GetStats() const;
+
+private:
+    void BuildGrid(const uint8* Luma, int32 Width, int32 Height, int32 RowStride, int32 PixelStride, int32 Step);
+
+    // Camera thread
+    TArray<uint8> Grid;
+    TArray<uint8> ReferenceGrid;
+    FIntPoint GridSize = FIntPoint::ZeroValue;
+    FIntPoint ReferenceGridSize = FIntPoint::ZeroValue;
+    FIntPoint TileCount = FIntPoint::ZeroValue;
+    TBitArray<> ChangedTiles;
+    int32 SkippedInARow = 0;
+    float LastScore = -1.0f;
+
+    std::atomic<bool> bResetRequested{ false };
+    std::atomic<int64> FramesEvaluated{ 0 };
+    std::atomic<int64> FramesSkipped{ 0 };
+    std::atomic<int64> FramesForced{ 0 };
+};
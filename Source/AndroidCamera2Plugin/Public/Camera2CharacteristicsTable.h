@@ -0,0 +1,98 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Value type of a camera characteristic; shared with Camera2Helper (CHAR_* constants). */
+enum class ECamera2CharacteristicType : uint8
+{
+    Bool,       // int arena: 0 or 1
+    Int,        // int arena
+    Float,      // float arena
+    Rational,   // int arena: numerator, denominator
+    Size,       // int arena: width, height
+    SizeF,      // float arena: width, height
+    Rect,       // int arena: left, top, right, bottom
+    IntRange,   // int arena: lower, upper
+    FloatRange, // float arena: lower, upper
+    String,     // string arena: value as text (types the table has no layout for)
+    Count,
+};
+
+/**
+ * Typed camera characteristics of one camera, marshalled once by Camera2Helper in a single walk
+ * over its keys. Values live in three flat arenas (int64, float, string) and each key maps to one
+ * entry (type, array flag, offset, element count), so a lookup is one hash of the key name and the
+ * value is read in place. Keys are the Android names, e.g. android.sensor.info.activeArraySize.
+ *
+ * Immutable once built; shared between threads through FCamera2CharacteristicsTablePtr. JSON is
+ * only made for export, by ToJson.
+ */
+class ANDROIDCAMERA2PLUGIN_API FCamera2CharacteristicsTable
+{
+public:
+    struct FEntry
+    {
+        ECamera2CharacteristicType Type = ECamera2CharacteristicType::Int;
+        bool bArray = false;
+        // Into the arena of Type, in arena values
+        int32 Offset = 0;
+        // Elements; 1 unless bArray
+        int32 Count = 0;
+    };
+
+    /** Arena values per element of a type (4 for Rect, 2 for Size, 1 for Int...). */
+    static int32 GetTypeWidth(ECamera2CharacteristicType Type);
+    static bool IsFloatType(ECamera2CharacteristicType Type);
+
+    /**
+     * Adopt the arenas and add the keys; RawEntries holds 4 ints per key as sent by Java. Entries that
+     * reach outside their arena, and non-array entries that are not exactly one element, are dropped.
+     * Returns the number of keys added.
+     */
+    int32 Build(const TArray<FString>& Keys, TConstArrayView<int32> RawEntries, TArray<int64>&& InInts,
+        TArray<float>&& InFloats, TArray<FString>&& InStrings);
+
+    FString CameraId;
+    int32 SdkVersion = 0;
+
+    int32 Num() const { return Entries.Num(); }
+    bool Contains(FName Key) const { return KeyToEntry.Contains(Key); }
+    const FEntry* Find(FName Key) const;
+    TArray<FName> GetKeys() const;
+
+    /** A scalar Bool or Int, or the first element of an int array. */
+    bool GetInt(FName Key, int64& OutValue) const;
+    /** A scalar Float, Int, Bool or Rational (as a fraction), or the first element of such an array. */
+    bool GetFloat(FName Key, float& OutValue) const;
+    bool GetRational(FName Key, int64& OutNumerator, int64& OutDenominator) const;
+    bool GetSize(FName Key, FIntPoint& OutSize) const;
+    /** Rect characteristics are left, top, right, bottom (right and bottom exclusive). */
+    bool GetRect(FName Key, FIntRect& OutRect) const;
+    bool GetIntRange(FName Key, int64& OutLower, int64& OutUpper) const;
+    bool GetString(FName Key, FString& OutValue) const;
+
+    /** Arena values of any int-arena key (Bool, Int, Rational, Size, Rect, IntRange), without copying. */
+    TConstArrayView<int64> GetInts(FName Key) const;
+    /** Arena values of any float-arena key (Float, SizeF, FloatRange), without copying. */
+    TConstArrayView<float> GetFloats(FName Key) const;
+    /** Values of a numeric key as floats, element by element; Rationals become fractions. */
+    bool GetFloatArray(FName Key, TArray<float>& OutValues) const;
+
+    /** The whole table as JSON: {"cameraId", "sdk", "values": {key: value}}. */
+    FString ToJson() const;
+
+    /** Bytes held by the table (arenas, entries and lookup). */
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    void AppendJsonValue(FString& Out, const FEntry& Entry, int32 Element) const;
+
+    TArray<FName> Names;
+    TArray<FEntry> Entries;
+    TMap<FName, int32> KeyToEntry;
+    TArray<int64> Ints;
+    TArray<float> Floats;
+    TArray<FString> Strings;
+};
+
+using FCamera2CharacteristicsTablePtr = TSharedPtr<const FCamera2CharacteristicsTable, ESPMode::ThreadSafe>;
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * Maps camera sensor timestamps (Image.getTimestamp(), CLOCK_BOOTTIME or CLOCK_MONOTONIC
+ * nanoseconds) to engine time (FPlatformTime::Seconds()).
+ *
+ * Fed with paired observations (sensor clock "now", engine clock "now") taken as close
+ * together as possible. Fits Engine = Offset + Rate * Sensor by least squares over a
+ * sliding window of accepted pairs. Pairs delayed by preemption show up as large positive
+ * residuals and are gated out against a running residual scale, so the fit follows the
+ * tight lower envelope. The gate is only armed once the first window is full: the scale is
+ * seeded from that window's residual spread and the pairs past the gate are dropped from it.
+ * Rejected pairs still widen the scale slowly, so jitter larger than the accepted residuals
+ * does not lock the gate shut. Updates and queries are O(1) (the sums are rebased once per
+ * window) and thread-safe.
+ */
+class ANDROIDCAMERA2PLUGIN_API FCamera2ClockSync
+{
+public:
+    struct FStats
+    {
+        // Engine time of sensor time zero, seconds
+        double OffsetSeconds = 0.0;
+        // Rate - 1 in parts per million
+        double DriftPpm = 0.0;
+        // Running residual scale, seconds (0 until the gate is armed)
+        double ResidualSeconds = 0.0;
+        int32 WindowCount = 0;
+        uint64 Accepted = 0;
+        uint64 Rejected = 0;
+        uint32 Resets = 0;
+    };
+
+    /** @param InWindowSize - pairs kept in the regression window */
+    explicit FCamera2ClockSync(int32 InWindowSize = 256);
+
+    /** Add a paired observation. Returns false if it was rejected as an outlier. */
+    bool AddObservation(int64 SensorNs, double EngineSeconds);
+
+    /** Map a sensor timestamp to engine seconds. Returns false until enough pairs were seen. */
+    bool SensorToEngine(int64 SensorNs, double& OutEngineSeconds) const;
+
+    /** Inverse mapping, e.g. to look up frames by engine time. */
+    bool EngineToSensor(double EngineSeconds, int64& OutSensorNs) const;
+
+    bool IsValid() const;
+    FStats GetStats() const;
+    void Reset();
+
+private:
+    struct FPair
+    {
+        int64 SensorNs;
+        double EngineSeconds;
+    };
+
+    void ResetLocked();
+    void ArmGate();
+    void AddToSums(const FPair& Pair, double Sign);
+    void Rebase();
+    void Solve();
+
+    int32 WindowSize = 0;
+    TArray<FPair> Window;
+    int32 Head = 0;
+    int32 Count = 0;
+    int32 InsertsSinceRebase = 0;
+
+    // Centered regression sums; x = sensor seconds since SensorRefNs, y = engine seconds since EngineRef
+    int64 SensorRefNs = 0;
+    double EngineRef = 0.0;
+    double SumX = 0.0;
+    double SumY = 0.0;
+    double SumXX = 0.0;
+    double SumXY = 0.0;
+
+    // Current fit in reference-relative coordinates: y = Intercept + Rate * x
+    double Intercept = 0.0;
+    double Rate = 1.0;
+    bool bHasFit = false;
+
+    // Mean absolute residual (EWMA), rejected pairs counted at the gate with a smaller weight
+    double ResidualScale = 0.0;
+    // Late pairs are only gated once the first window seeded ResidualScale
+    bool bGateArmed = false;
+    int32 ConsecutiveRejects = 0;
+
+    uint64 Accepted = 0;
+    uint64 Rejected = 0;
+    uint32 Resets = 0;
+
+    mutable FCriticalSection Lock;
+};
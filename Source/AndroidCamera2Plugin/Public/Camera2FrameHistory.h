@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Camera2ImageConversion.h"
+#include "SimpleCamera2Test.h"
+#include "HAL/CriticalSection.h"
+
+/** One recorded frame: full-resolution 8-bit luma or BGRA, tightly packed, plus its metadata. Immutable once recorded. */
+struct ANDROIDCAMERA2PLUGIN_API FCamera2HistoryFrame
+{
+    enum class EFormat : uint8
+    {
+        Luma,
+        Bgra,
+    };
+
+    FCamera2FrameMetadata Metadata;
+    EFormat Format = EFormat::Luma;
+    int32 Width = 0;
+    int32 Height = 0;
+    TArray<uint8> Pixels;
+
+    int32 GetBytesPerPixel() const { return Format == EFormat::Bgra ? 4 : 1; }
+    int64 GetSizeBytes() const { return Pixels.Num(); }
+};
+
+/**
+ * Bounded history of a stream's recent frames for processing after the fact, e.g. re-running
+ * detection on the frame captured when a button was pressed.
+ *
+ * Frames are kept in capture order, so lookups by sequence number, sensor timestamp or engine
+ * time are binary searches. A returned pointer pins its frame: pinned frames are never evicted
+ * or overwritten, and consumers read them without copying. At most Camera2.History.MaxFrames
+ * frames and Camera2.History.BudgetMB megabytes are held; the oldest unpinned frame is evicted
+ * to make room and its buffer reused for the new frame. When only pinned frames are left, new
+ * frames are rejected instead of exceeding the budget.
+ *
+ * Record runs on the camera thread; lookups, Reset and GetStats may be called from any thread.
+ */
+class ANDROIDCAMERA2PLUGIN_API FCamera2FrameHistory
+{
+public:
+    using FFramePtr = TSharedPtr<const FCamera2HistoryFrame, ESPMode::ThreadSafe>;
+
+    struct FStats
+    {
+        int32 NumFrames = 0;
+        int32 NumPinned = 0;
+        int64 BytesInUse = 0;
+        int64 ByteBudget = 0;
+        int64 FramesRecorded = 0;
+        int64 FramesEvicted = 0;
+        // Not recorded because pinned frames held the whole budget (or one frame exceeds it)
+        int64 FramesRejected = 0;
+        // Recorded into the buffer of an evicted frame instead of a new allocation
+        int64 BuffersReused = 0;
+    };
+
+    /** Record the luma of a frame; PixelStride 4 over a gray BGRA frame works too (camera thread). */
+    bool RecordLuma(const uint8* Luma, int32 Width, int32 Height, int32 RowStride, int32 PixelStride,
+        const FCamera2FrameMetadata& Metadata);
+
+    /** Record a tightly packed BGRA frame (camera thread). */
+    bool RecordBgra(const uint8* Bgra, int32 Width, int32 Height, const FCamera2FrameMetadata& Metadata);
+
+    /** Convert the YUV planes of a frame to BGRA straight into the history (camera thread). */
+    bool RecordYuv(const FCamera2YuvPlanes& Planes, const FCamera2FrameMetadata& Metadata);
+
+    /** Frame with this FrameSequence, or null if it was never recorded or is gone. */
+    FFramePtr FindBySequence(int64 FrameSequence) const;
+
+    /** Frame whose SensorTimestampNs is closest; null if empty or further than MaxDeltaNs (0 = any distance). */
+    FFramePtr FindNearestSensorTime(int64 SensorTimestampNs, int64 MaxDeltaNs = 0) const;
+
+    /** Frame whose EngineTimestamp is closest; null if empty or further than MaxDeltaSeconds (0 = any distance). */
+    FFramePtr FindNearestEngineTime(double EngineTime, double MaxDeltaSeconds = 0.0) const;
+
+    FFramePtr GetLatest() const;
+
+    /** Forget all frames (pinned ones stay alive with their holders). Counters are kept. */
+    void Reset();
+
+    FStats GetStats() const;
+
+    /** Format new frames are recorded in (Camera2.History.Format). */
+    static FCamera2HistoryFrame::EFormat GetFormat();
+
+private:
+    using FMutableFramePtr = TSharedPtr<FCamera2HistoryFrame, ESPMode::ThreadSafe>;
+
+    // Make room and return a frame to fill, or null if the frame cannot be recorded
+    FCamera2HistoryFrame* BeginRecord(FCamera2HistoryFrame::EFormat Format, int32 Width, int32 Height,
+        const FCamera2FrameMetadata& Metadata);
+    void EndRecord();
+
+    // Nearest frame by a key that grows with capture order (lock held)
+    template <typename KeyType, typename ProjectionType>
+    FFramePtr FindNearest(KeyType Key, KeyType MaxDelta, ProjectionType Projection) const;
+
+    mutable FCriticalSection Lock;
+    // Oldest first
+    TArray<FMutableFramePtr> Frames;
+    // Includes the frame being recorded
+    int64 BytesInUse = 0;
+    FStats Counters;
+
+    // Camera thread: frame between BeginRecord and EndRecord
+    FMutableFramePtr Recording;
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Camera2ImageConversion.h"
+#include "SimpleCamera2Test.h"
+#include "HAL/CriticalSection.h"
+
+/**
+ * One CPU copy of a camera frame, downsampled by an integer factor: BGRA pixels, 8-bit luma and a
+ * summed-area table of the luma. Immutable once published. Queries take stream pixel coordinates.
+ */
+struct ANDROIDCAMERA2PLUGIN_API FCamera2MirrorFrame
+{
+    FCamera2FrameMetadata Metadata;
+    FIntPoint SourceSize = FIntPoint::ZeroValue;
+    int32 Downsample = 1;
+    int32 Width = 0;
+    int32 Height = 0;
+
+    TArray<FColor> Pixels;
+    TArray<uint8> Luma;
+    // (Width + 1) x (Height + 1); entry (x, y) is the luma sum of all pixels left of x and above y
+    TArray<uint32> LumaSAT;
+
+    /** Color of the mirror pixel covering a stream pixel. O(1). */
+    bool GetPixelAt(FIntPoint StreamPixel, FColor& OutColor) const;
+
+    /** Mean luma (0-255) of a stream rectangle, snapped to mirror pixels. O(1). */
+    bool GetMeanLuminance(const FIntRect& StreamRect, float& OutMean) const;
+
+    /** Luma histogram of a stream rectangle with NumBins equal bins over 0-255. O(area / Downsample^2). */
+    bool GetHistogram(const FIntRect& StreamRect, int32 NumBins, TArray<int32>& OutBins) const;
+
+private:
+    // Stream rectangle to mirror pixels, clamped; false when nothing is left
+    bool ToMirrorRect(const FIntRect& StreamRect, FIntRect& OutRect) const;
+};
+
+/**
+ * Double-buffered CPU mirror of a stream's frames for pixel queries without a GPU readback.
+ *
+ * The camera thread builds each frame into the back buffer and swaps it in; readers hold a shared
+ * reference to the published frame, so a query never sees a frame being written. A back buffer
+ * still referenced by a reader is replaced rather than overwritten. Cost per frame is one
+ * downsample pass (Camera2.Mirror.Downsample) and one summed-area-table pass.
+ */
+class ANDROIDCAMERA2PLUGIN_API FCamera2FrameMirror
+{
+public:
+    using FFramePtr = TSharedPtr<const FCamera2MirrorFrame, ESPMode::ThreadSafe>;
+
+    /** Build from the YUV planes of a frame (camera thread). */
+    void UpdateFromYuv(const FCamera2YuvPlanes& Planes, const FCamera2FrameMetadata& Metadata);
+
+    /** Build from a tightly packed BGRA frame (camera thread). */
+    void UpdateFromBgra(const uint8* Bgra, int32 InWidth, int32 InHeight, const FCamera2FrameMetadata& Metadata);
+
+    /** Latest published frame, or null before the first one. Any thread. */
+    FFramePtr GetLatest() const;
+
+    /** Drop the published frame (game thread, e.g. when the stream stops). */
+    void Reset();
+
+    /** Mirror downsample factor from Camera2.Mirror.Downsample, at least 1. */
+    static int32 GetDownsample();
+
+private:
+    using FMutableFramePtr = TSharedPtr<FCamera2MirrorFrame, ESPMode::ThreadSafe>;
+
+    // Back buffer sized for a source frame, reallocated if a reader still holds it
+    FCamera2MirrorFrame& BeginUpdate(int32 SourceWidth, int32 SourceHeight, const FCamera2FrameMetadata& Metadata);
+    void Publish();
+
+    mutable FCriticalSection Lock;
+    FMutableFramePtr Front;
+    // Camera thread only
+    FMutableFramePtr Back;
+};
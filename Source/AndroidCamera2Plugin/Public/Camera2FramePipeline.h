@@ -0,0 +1,239 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SimpleCamera2Test.h"
+#include "HAL/CriticalSection.h"
+#include "Tasks/Task.h"
+#include <atomic>
+
+/** One named buffer flowing between stages. Storage is kept across frames, so stages should resize, not reallocate. */
+struct FCamera2PipelineBuffer
+{
+    TArray<uint8> Data;
+    int32 Width = 0;
+    int32 Height = 0;
+    int32 BytesPerPixel = 0;
+
+    // Set when the producing stage succeeded for this frame; stages with an invalid input are skipped
+    bool bValid = false;
+
+    void Allocate(int32 InWidth, int32 InHeight, int32 InBytesPerPixel)
+    {
+        Width = InWidth;
+        Height = InHeight;
+        BytesPerPixel = InBytesPerPixel;
+        Data.SetNumUninitialized(InWidth * InHeight * InBytesPerPixel, EAllowShrinking::No);
+    }
+};
+
+/** What a stage sees for one frame: its declared inputs and outputs, in declaration order. */
+struct FCamera2StageContext
+{
+    int64 FrameIndex = 0;
+    const FCamera2FrameMetadata* Metadata = nullptr;
+    TArray<const FCamera2PipelineBuffer*, TInlineAllocator<4>> Inputs;
+    TArray<FCamera2PipelineBuffer*, TInlineAllocator<4>> Outputs;
+};
+
+/**
+ * Stage declaration. A stage runs when all stages producing its inputs have finished for the
+ * same frame, and after its own run for the previous frame, so the body may keep state across
+ * frames without locking. Return false to abandon the frame (downstream stages are skipped).
+ */
+struct FCamera2PipelineStageDesc
+{
+    FName Name;
+    TArray<FName> Inputs;
+    TArray<FName> Outputs;
+    TFunction<bool(FCamera2StageContext&)> Work;
+
+    // Skip this stage for a frame when a newer frame has already been submitted (e.g. detection)
+    bool bSkipWhenBehind = false;
+
+    // Skip this stage for frames whose metadata it rejects, e.g. Camera2PipelineStages::IsFrameUsable
+    TFunction<bool(const FCamera2FrameMetadata&)> ShouldRun;
+
+    // Nice-to-have work, shed while SetSkipOptionalStages(true) (e.g. by the governor under load)
+    bool bOptional = false;
+};
+
+/**
+ * Stage graph over UE::Tasks. Each submitted frame launches one task per stage with the
+ * producers of its inputs and the same stage of the previous frame as prerequisites, so
+ * consecutive frames overlap: frame N+1 converts while frame N detects.
+ *
+ * At most MaxInFlight frames are in the graph; Submit drops frames beyond that. Frame state and
+ * buffers come from a pool of MaxInFlight entries and are reused. Timing is kept per stage.
+ * The destructor waits for frames still in the graph.
+ */
+class ANDROIDCAMERA2PLUGIN_API FCamera2FramePipeline
+{
+public:
+    struct FStageStats
+    {
+        FName Name;
+        int64 Runs = 0;
+        int64 Skipped = 0;
+        double MeanMs = 0.0;
+        double MaxMs = 0.0;
+    };
+
+    struct FStats
+    {
+        int64 Submitted = 0;
+        int64 Completed = 0;
+        // Rejected by Submit because MaxInFlight frames were already in the graph
+        int64 Dropped = 0;
+        // Submit to completion, milliseconds
+        double MeanLatencyMs = 0.0;
+        double MaxLatencyMs = 0.0;
+        TArray<FStageStats> Stages;
+    };
+
+    /** Called when a frame leaves the graph, on a worker thread. Bind before the first Submit. */
+    DECLARE_MULTICAST_DELEGATE_TwoParams(FOnFrameCompleted, int64 /*FrameIndex*/, bool /*bCompletedAllStages*/);
+    FOnFrameCompleted OnFrameCompleted;
+
+    explicit FCamera2FramePipeline(int32 InMaxInFlight = 3);
+    ~FCamera2FramePipeline();
+
+    FCamera2FramePipeline(const FCamera2FramePipeline&) = delete;
+    FCamera2FramePipeline& operator=(const FCamera2FramePipeline&) = delete;
+
+    /** Declare a stage. Stages must be added before Finalize, producers before consumers. */
+    void AddStage(FCamera2PipelineStageDesc Stage);
+
+    /** Resolve slots and dependencies. Returns false (and logs) on an unknown input or a duplicate output. */
+    bool Finalize();
+
+    /**
+     * Push a frame into the graph. Fill writes the frame metadata and the source slots (buffers not
+     * produced by any stage) on the calling thread before any stage is launched.
+     * @param bWaitForSlot - block until a frame slot frees up instead of dropping the frame
+     * @return false if the frame was dropped
+     */
+    bool Submit(TFunctionRef<void(FCamera2FrameMetadata&, TArrayView<FCamera2PipelineBuffer*>)> Fill,
+        bool bWaitForSlot = false);
+
+    /** Names of the source slots, in the order Submit's Fill receives them. */
+    const TArray<FName>& GetSourceSlots() const { return SourceSlotNames; }
+
+    /** Wait until every submitted frame has completed. */
+    void Flush();
+
+    /** Skip stages flagged bOptional from their next run on. Any thread. */
+    void SetSkipOptionalStages(bool bSkip) { bSkipOptionalStages = bSkip; }
+
+    int32 GetMaxInFlight() const { return MaxInFlight; }
+    int32 GetNumInFlight() const { return InFlight.load(); }
+
+    FStats GetStats() const;
+    void ResetStats();
+
+private:
+    struct FStage
+    {
+        FCamera2PipelineStageDesc Desc;
+        TArray<int32> InputSlots;
+        TArray<int32> OutputSlots;
+        TArray<int32> Producers;
+
+        std::atomic<int64> Runs{ 0 };
+        std::atomic<int64> Skipped{ 0 };
+        std::atomic<int64> TotalNs{ 0 };
+        std::atomic<int64> MaxNs{ 0 };
+    };
+
+    struct FFrameState
+    {
+        int64 FrameIndex = 0;
+        FCamera2FrameMetadata Metadata;
+        double SubmitTime = 0.0;
+        TArray<FCamera2PipelineBuffer> Slots;
+        TArray<UE::Tasks::FTask> StageTasks;
+        std::atomic<bool> bAbandoned{ false };
+        std::atomic<bool> bAnySkipped{ false };
+    };
+
+    void RunStage(int32 StageIndex, FFrameState& Frame);
+    void CompleteFrame(FFrameState& Frame);
+    int32 FindOrAddSlot(FName Name);
+
+    const int32 MaxInFlight;
+    bool bFinalized = false;
+
+    TArray<TUniquePtr<FStage>> Stages;
+    TArray<FName> SlotNames;
+    TArray<int32> SlotProducer;
+    TArray<FName> SourceSlotNames;
+    TArray<int32> SourceSlots;
+
+    TArray<TUniquePtr<FFrameState>> FramePool;
+    TArray<FFrameState*> FreeFrames;
+    FCriticalSection FreeFramesLock;
+    FEvent* FrameFreedEvent = nullptr;
+
+    // Last launched task per stage, the cross-frame prerequisite of the next launch (submit thread only)
+    TArray<UE::Tasks::FTask> LastStageTasks;
+    TArray<UE::Tasks::FTask> FrameDoneTasks;
+    FCriticalSection SubmitLock;
+
+    int64 NextFrameIndex = 0;
+    std::atomic<int64> LatestSubmittedIndex{ -1 };
+    std::atomic<int32> InFlight{ 0 };
+    std::atomic<bool> bSkipOptionalStages{ false };
+
+    std::atomic<int64> Submitted{ 0 };
+    std::atomic<int64> Completed{ 0 };
+    std::atomic<int64> Dropped{ 0 };
+    std::atomic<int64> TotalLatencyNs{ 0 };
+    std::atomic<int64> MaxLatencyNs{ 0 };
+};
+
+/**
+ * Frame source for running pipelines without a camera: replays raw BGRA frames from a directory
+ * (one file per frame, all Width x Height x 4 bytes) or, without one, generates a moving test pattern.
+ * Metadata follows a synthetic 30 fps cadence so timing code sees plausible values.
+ */
+class ANDROIDCAMERA2PLUGIN_API FCamera2ReplaySource
+{
+public:
+    FCamera2ReplaySource(int32 InWidth = 1280, int32 InHeight = 960);
+
+    /** Load every file in Directory (sorted by name). Returns the number of frames loaded. */
+    int32 LoadDirectory(const FString& Directory);
+
+    /** Write the next frame (looping) into OutBGRA and its metadata. */
+    void NextFrame(FCamera2PipelineBuffer& OutBGRA, FCamera2FrameMetadata& OutMetadata);
+
+    int32 GetWidth() const { return Width; }
+    int32 GetHeight() const { return Height; }
+    int32 GetNumRecordedFrames() const { return Frames.Num(); }
+
+private:
+    void GeneratePattern(uint8* Dest) const;
+
+    int32 Width;
+    int32 Height;
+    TArray<TArray<uint8>> Frames;
+    int64 FrameCounter = 0;
+};
+
+namespace Camera2PipelineStages
+{
+    /**
+     * Reference graph: BGRA -> luma -> 3-level pyramid -> corner detection (skipped when behind).
+     * Source slot "BGRA", outputs "Luma", "Pyramid" (levels 1-3 stacked) and "Corners" (int16 x,y pairs
+     * in stream pixels).
+     */
+    ANDROIDCAMERA2PLUGIN_API void AddReferenceStages(FCamera2FramePipeline& Pipeline);
+
+    /**
+     * Whether a frame is worth expensive processing: Sharpness of at least Camera2.Stats.MinSharpness
+     * and MeanLuma within Camera2.Stats.MinMeanLuma..MaxMeanLuma. Frames without statistics pass.
+     */
+    ANDROIDCAMERA2PLUGIN_API bool IsFrameUsable(const FCamera2FrameMetadata& Metadata);
+
+    /** Run the reference graph over replayed frames and log throughput and per-stage timing. */
+    ANDROIDCAMERA2PLUGIN_API void RunBenchmark(int32 NumFrames, int32 MaxInFlight, float SubmitFps, const FString& ReplayDirectory);
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Camera2FramePipeline.h"
+#include "Misc/CoreDelegates.h"
+#include <atomic>
+
+/** Load signals for one governor evaluation, averaged over the window since the previous one. */
+struct FCamera2GovernorInputs
+{
+    // Capture to texture upload on the game thread
+    double UploadLatencyMs = 0.0;
+    // Submit to completion in the frame pipeline
+    double PipelineLatencyMs = 0.0;
+    // Mean time of the slowest pipeline stage
+    double SlowestStageMs = 0.0;
+    // Frames queued behind the camera thread: pending game-thread uploads plus pipeline frames in flight
+    int32 QueueDepth = 0;
+    // Frames the pipeline dropped because it was full
+    int64 PipelineDrops = 0;
+    ETemperatureSeverity Thermal = ETemperatureSeverity::Unknown;
+
+    double GetLatencyMs() const { return FMath::Max(UploadLatencyMs, PipelineLatencyMs); }
+};
+
+/** What the governor asks of a stream. Level 0 is full quality; higher levels shed more work. */
+struct FCamera2GovernorState
+{
+    int32 Level = 0;
+    // Process every Nth camera frame
+    int32 Decimation = 1;
+    // Multiplier on the resolution of derived outputs (undistorted pipeline slots)
+    float OutputScale = 1.0f;
+    // Skip pipeline stages flagged bOptional
+    bool bSkipOptionalStages = false;
+
+    bool operator==(const FCamera2GovernorState& Other) const
+    {
+        return Level == Other.Level && Decimation == Other.Decimation && OutputScale == Other.OutputScale
+            && bSkipOptionalStages == Other.bSkipOptionalStages;
+    }
+    bool operator!=(const FCamera2GovernorState& Other) const { return !(*this == Other); }
+};
+
+/** Decides the next state from the inputs. Implementations may keep history (hysteresis). */
+class ICamera2GovernorPolicy
+{
+public:
+    virtual ~ICamera2GovernorPolicy() = default;
+    virtual FCamera2GovernorState Evaluate(const FCamera2GovernorInputs& Inputs, const FCamera2GovernorState& Current,
+        double LatencyBudgetMs) = 0;
+};
+
+/**
+ * Default policy: a fixed ladder of states, one step down after Camera2.Governor.StepDownWindows
+ * windows over budget (latency, queue depth or thermal at Serious and above), one step up after
+ * Camera2.Governor.StepUpWindows windows with clear headroom (latency under 60% of budget, thermal
+ * below Bad). Ladder: full -> skip optional stages -> every 2nd frame -> half output scale ->
+ * every 3rd frame -> every 4th frame.
+ */
+class ANDROIDCAMERA2PLUGIN_API FCamera2LadderGovernorPolicy : public ICamera2GovernorPolicy
+{
+public:
+    FCamera2LadderGovernorPolicy();
+
+    virtual FCamera2GovernorState Evaluate(const FCamera2GovernorInputs& Inputs, const FCamera2GovernorState& Current,
+        double LatencyBudgetMs) override;
+
+    const TArray<FCamera2GovernorState>& GetLadder() const { return Ladder; }
+
+private:
+    TArray<FCamera2GovernorState> Ladder;
+    int32 OverBudgetWindows = 0;
+    int32 HeadroomWindows = 0;
+};
+
+/**
+ * Holds a latency budget by stepping a stream's workload through a policy. Feed it inputs at a
+ * fixed interval (SampleInputs helps with the pipeline part) and apply the returned state.
+ * Thermal severity is tracked from FCoreDelegates::OnTemperatureChange.
+ */
+class ANDROIDCAMERA2PLUGIN_API FCamera2Governor
+{
+public:
+    /** Uses FCamera2LadderGovernorPolicy when Policy is null. */
+    explicit FCamera2Governor(TSharedPtr<ICamera2GovernorPolicy> InPolicy = nullptr);
+    ~FCamera2Governor();
+
+    FCamera2Governor(const FCamera2Governor&) = delete;
+    FCamera2Governor& operator=(const FCamera2Governor&) = delete;
+
+    void SetPolicy(TSharedPtr<ICamera2GovernorPolicy> InPolicy);
+
+    /** Budget from capture to upload/pipeline completion. Defaults to Camera2.Governor.LatencyBudgetMs. */
+    void SetLatencyBudgetMs(double InBudgetMs) { LatencyBudgetMs = InBudgetMs; }
+    double GetLatencyBudgetMs() const;
+
+    /** Evaluate the policy once; logs level changes. */
+    FCamera2GovernorState Update(const FCamera2GovernorInputs& Inputs);
+
+    FCamera2GovernorState GetState() const { return State; }
+
+    /** Latest severity reported by the platform. */
+    ETemperatureSeverity GetThermalSeverity() const { return Thermal.load(); }
+
+    /** Pipeline latency, slowest stage and drops over the window since the previous call. */
+    void SampleInputs(const FCamera2FramePipeline& Pipeline, FCamera2GovernorInputs& InOutInputs);
+
+    /** Evaluation interval in seconds (Camera2.Governor.Interval). */
+    static float GetInterval();
+
+private:
+    void HandleTemperatureChange(ETemperatureSeverity Severity);
+
+    TSharedPtr<ICamera2GovernorPolicy> Policy;
+    FCamera2GovernorState State;
+    double LatencyBudgetMs = 0.0;
+    std::atomic<ETemperatureSeverity> Thermal{ ETemperatureSeverity::Unknown };
+    FDelegateHandle TemperatureHandle;
+
+    // Pipeline counters at the previous SampleInputs
+    FCamera2FramePipeline::FStats LastPipelineStats;
+};
+
+namespace Camera2Governor
+{
+    /**
+     * Run the governor against a modeled pipeline (reference stages plus a synthetic load and an
+     * optional stage on one worker, 3 frames in flight) under a thermal script (cool, throttled,
+     * cool) and log how it steps; checks that it sheds work while throttled and recovers afterwards.
+     * Time is virtual, so the run returns immediately whatever the frame count. Then replays frames
+     * through a real FCamera2FramePipeline to check SampleInputs and optional-stage skipping.
+     */
+    ANDROIDCAMERA2PLUGIN_API bool RunSimulation(int32 NumFrames, double LatencyBudgetMs);
+}
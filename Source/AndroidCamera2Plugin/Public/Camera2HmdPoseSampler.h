@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Camera2PoseHistory.h"
+
+/** Where an HMD pose sample comes from; each source has its own history. */
+enum class ECamera2PoseSource : uint8
+{
+    GameTick,   // every engine tick: the game frame's prediction
+    LateUpdate, // render thread after the XR late update: the newer prediction for the same display
+    Count,
+};
+
+/**
+ * Records the HMD world pose into a FCamera2PoseHistory so camera frames can be paired
+ * with the head pose at their exposure time.
+ *
+ * Samples are taken every engine tick and again on the render thread after the XR late update.
+ * The XR system predicts both for when the frame is displayed, not for when they are read, so each
+ * sample is stamped with its read time plus the source's prediction lead (Camera2.Pose.GameLeadFrames,
+ * Camera2.Pose.LateUpdateLeadFrames, in frames of the smoothed frame time). The two sources never share
+ * a history: their leads differ, and interleaving them would interpolate between two time bases.
+ * Lookups use the late-update history while it is fed and fall back to the tick one (e.g. -nullrhi).
+ *
+ * All times are engine seconds (the FPlatformTime::Seconds() clock) at which the head was at the
+ * pose, e.g. a frame's exposure time mapped through the stream's clock sync.
+ * Started and stopped by the module.
+ */
+class ANDROIDCAMERA2PLUGIN_API FCamera2HmdPoseSampler
+{
+public:
+    static void Startup();
+    static void Shutdown();
+
+    /** HMD-to-world pose history lookups use (about 4 seconds at 120 samples/s). */
+    static FCamera2PoseHistory& GetHistory();
+
+    /** History of one source. */
+    static FCamera2PoseHistory& GetHistory(ECamera2PoseSource Source);
+
+    /** Source GetHistory() reads: LateUpdate while it received a sample in the last quarter second. */
+    static ECamera2PoseSource GetActiveSource();
+
+    /** Interpolated HMD-to-world pose at an engine time (see class comment for the time base). */
+    static bool GetHmdPoseAtTime(double EngineTimeSeconds, FTransform& OutHmdToWorld);
+
+    /** Interpolated world-from-camera transform at an engine time: CamInHmd composed with the HMD pose. */
+    static bool GetWorldFromCameraAtTime(double EngineTimeSeconds, const FTransform& CamInHmd, FTransform& OutWorldFromCamera);
+
+    /** Sample the current HMD pose now, into the tick history on the game thread or the late-update one on the render thread. */
+    static void SampleNow();
+};
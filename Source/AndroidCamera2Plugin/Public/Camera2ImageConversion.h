@@ -0,0 +1,189 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Camera2Projection.h"
+
+/** Planes of a YUV_420_888 image as handed out by android.media.Image (chroma at half resolution). */
+struct FCamera2YuvPlanes
+{
+    const uint8* Y = nullptr;
+    const uint8* U = nullptr;
+    const uint8* V = nullptr;
+    int32 Width = 0;
+    int32 Height = 0;
+    int32 YRowStride = 0;
+    int32 UVRowStride = 0;
+    // 1 for planar I420, 2 for the interleaved NV12/NV21 layouts most devices use
+    int32 UVPixelStride = 1;
+
+    /** View of a sub-rectangle; Rect.Min must be even so chroma samples stay aligned with their luma pairs. */
+    FCamera2YuvPlanes Crop(const FIntRect& Rect) const;
+
+    /** Bytes each plane must span for these dimensions and strides. */
+    int64 GetRequiredYBytes() const;
+    int64 GetRequiredUVBytes() const;
+};
+
+/**
+ * Source positions for a fused undistort + rescale of a stream frame.
+ *
+ * The output is an ideal pinhole image of the same lens at Scale times the stream resolution
+ * (GetOutputLens). Each output pixel stores the top-left luma tap of its distorted source position
+ * and 8-bit bilinear weights, so the remap kernels read the YUV planes once and never touch a
+ * full-resolution intermediate.
+ */
+class ANDROIDCAMERA2PLUGIN_API FCamera2RemapLUT
+{
+public:
+    struct FEntry
+    {
+        uint16 X = 0;
+        uint16 Y = 0;
+        uint8 FracX = 0;
+        uint8 FracY = 0;
+        // 0 when the source lies outside the image or past the lens model's trusted radius
+        uint8 bValid = 0;
+        uint8 Padding = 0;
+    };
+
+    /** (Re)build for a lens model (stream pixels) and an output scale, clamped to [1/16, 2]. */
+    void Build(const FCamera2LensModel& InLens, float InScale);
+
+    bool IsBuiltFor(const FCamera2LensModel& InLens, float InScale) const;
+
+    int32 GetOutputWidth() const { return OutputWidth; }
+    int32 GetOutputHeight() const { return OutputHeight; }
+    float GetScale() const { return Scale; }
+
+    /** Distortion-free lens model of the output image. */
+    FCamera2LensModel GetOutputLens() const;
+
+    /** Scale actually used for a requested one. */
+    static float ClampScale(float InScale);
+
+    const FCamera2LensModel& GetSourceLens() const { return Lens; }
+    const FEntry* GetRow(int32 Row) const { return Entries.GetData() + static_cast<int64>(Row) * OutputWidth; }
+
+private:
+    FCamera2LensModel Lens;
+    float Scale = 0.0f;
+    int32 OutputWidth = 0;
+    int32 OutputHeight = 0;
+    TArray<FEntry> Entries;
+};
+
+/** One destination of Camera2ImageConversion::RemapYuvMulti. */
+struct FCamera2RemapTarget
+{
+    // Source the LUT was built for: the full frame or a crop of it
+    FCamera2YuvPlanes Planes;
+    const FCamera2RemapLUT* Lut = nullptr;
+    uint8* Dst = nullptr;
+    int32 DstStride = 0;
+    // 8-bit luma instead of BGRA8
+    bool bLuma = false;
+};
+
+/** Luma statistics of one frame, over the pixels sampled by ComputeLumaStats. */
+struct FCamera2LumaStats
+{
+    uint32 Histogram[256] = {};
+    int64 SampleCount = 0;
+    float Mean = 0.0f;
+    float Variance = 0.0f;
+    // Variance of the 4-neighbour Laplacian; falls sharply with motion blur and defocus
+    float Sharpness = 0.0f;
+};
+
+/**
+ * Native image conversion kernels. Rows are split into tiles of about Camera2.Convert.TileKB output
+ * bytes, claimed by up to Camera2.Convert.MaxWorkers task-graph workers; images smaller than
+ * Camera2.Convert.ParallelMinPixels are converted on the calling thread.
+ */
+namespace Camera2ImageConversion
+{
+    /** Full-range BT.601 YUV to BGRA8 (the camera texture format). DstStride is in bytes. */
+    ANDROIDCAMERA2PLUGIN_API void ConvertYuvToBgra(const FCamera2YuvPlanes& Planes, uint8* Dst, int32 DstStride);
+
+    /**
+     * Repack the planes as NV12: Height rows of Y, then (Height + 1) / 2 rows of interleaved U,V, all at
+     * DstStride bytes. A U,V row is Align(Width, 2) bytes, so DstStride must be at least that (one more
+     * than Width for odd widths). Semi-planar camera buffers in U,V order are copied row by row.
+     */
+    ANDROIDCAMERA2PLUGIN_API void ConvertYuvToNv12(const FCamera2YuvPlanes& Planes, uint8* Dst, int32 DstStride);
+
+    /** Copy the Y plane into a tightly packed (or DstStride) 8-bit luma image. */
+    ANDROIDCAMERA2PLUGIN_API void ConvertYuvToLuma(const FCamera2YuvPlanes& Planes, uint8* Dst, int32 DstStride);
+
+    /**
+     * Box-downsample by an integer Factor into tightly packed BGRA8 and/or 8-bit luma
+     * ((Width / Factor) x (Height / Factor); either destination may be null).
+     */
+    ANDROIDCAMERA2PLUGIN_API void DownsampleYuv(const FCamera2YuvPlanes& Planes, int32 Factor, uint8* BgraDst, uint8* LumaDst);
+
+    /**
+     * Halve an 8-bit image with Channels (1 or 4) interleaved channels: each output pixel is the
+     * rounded mean of a 2x2 block (the last row/column is repeated for odd sizes of 1). Output is
+     * max(SrcWidth / 2, 1) x max(SrcHeight / 2, 1). SSE2/NEON, on the calling thread.
+     */
+    ANDROIDCAMERA2PLUGIN_API void Downsample2x2(const uint8* Src, int32 SrcWidth, int32 SrcHeight, int32 SrcStride,
+        uint8* Dst, int32 DstStride, int32 Channels);
+
+    /** Levels of a full mip chain down to 1x1. */
+    ANDROIDCAMERA2PLUGIN_API int32 GetNumMips(int32 Width, int32 Height);
+
+    /** Bytes of NumMips tightly packed levels, level 0 first. */
+    ANDROIDCAMERA2PLUGIN_API int64 GetMipChainBytes(int32 Width, int32 Height, int32 BytesPerPixel, int32 NumMips);
+
+    /**
+     * Fill levels 1..NumMips-1 of a tightly packed chain whose level 0 is already in Data, each
+     * from the one above with Downsample2x2 (rows split across workers for the large levels).
+     */
+    ANDROIDCAMERA2PLUGIN_API void BuildMipChain(uint8* Data, int32 Width, int32 Height, int32 BytesPerPixel, int32 NumMips);
+
+    /**
+     * Histogram, mean/variance and Laplacian sharpness of an 8-bit luma image, sampling every
+     * Step-th row and column (borders excluded). PixelStride 4 over a gray BGRA frame works too.
+     */
+    ANDROIDCAMERA2PLUGIN_API void ComputeLumaStats(const uint8* Luma, int32 Width, int32 Height, int32 RowStride,
+        int32 PixelStride, int32 Step, FCamera2LumaStats& OutStats);
+
+    /**
+     * Run Body over [0, NumRows) in row tiles sized for BytesPerRow, on worker threads when the
+     * image is large enough. Shared by the conversion and remap kernels.
+     * @param MaxWorkersOverride - cap on threads (0 = use the cvar)
+     */
+    ANDROIDCAMERA2PLUGIN_API void ParallelForRowTiles(int32 NumRows, int32 Width, int32 BytesPerRow,
+        TFunctionRef<void(int32 RowBegin, int32 RowEnd)> Body, int32 MaxWorkersOverride = 0);
+
+    /**
+     * Fused YUV to BGRA8 + undistort + rescale in one pass over Lut's output (bilinear luma, nearest chroma).
+     * Returns false if the planes do not match the LUT's source resolution.
+     */
+    ANDROIDCAMERA2PLUGIN_API bool RemapYuvToBgra(const FCamera2YuvPlanes& Planes, const FCamera2RemapLUT& Lut,
+        uint8* Dst, int32 DstStride);
+
+    /** Fused undistort + rescale of the Y plane into 8-bit luma. */
+    ANDROIDCAMERA2PLUGIN_API bool RemapYuvToLuma(const FCamera2YuvPlanes& Planes, const FCamera2RemapLUT& Lut,
+        uint8* Dst, int32 DstStride);
+
+    /**
+     * RemapYuvToBgra / RemapYuvToLuma into several targets in one parallel pass. Work is split into
+     * bands covering the same fraction of every target, so for full-frame targets the rows one
+     * worker reads are shared by all its outputs while they are in cache.
+     * Returns false (writing nothing) if any target's planes do not match its LUT.
+     */
+    ANDROIDCAMERA2PLUGIN_API bool RemapYuvMulti(TArrayView<const FCamera2RemapTarget> Targets);
+
+    /** Convert synthetic frames with 1..N workers and log time per frame and speedup. */
+    ANDROIDCAMERA2PLUGIN_API void RunBenchmark(int32 Iterations, int32 Width, int32 Height);
+
+    /** Time the fused remap against convert, undistort and resize run as separate passes. */
+    ANDROIDCAMERA2PLUGIN_API void RunRemapBenchmark(int32 Iterations, int32 Width, int32 Height, float Scale);
+
+    /** Time RemapYuvMulti over a full, a quarter and a luma output against one remap call per output. */
+    ANDROIDCAMERA2PLUGIN_API void RunFanOutBenchmark(int32 Iterations, int32 Width, int32 Height);
+
+    /** Check the vector 2x2 kernel against the scalar reference, then time mip chains against conversion. */
+    ANDROIDCAMERA2PLUGIN_API bool RunMipBenchmark(int32 Iterations, int32 Width, int32 Height);
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IMediaCache.h"
+#include "IMediaControls.h"
+#include "IMediaPlayer.h"
+#include "IMediaPlayerFactory.h"
+#include "IMediaTracks.h"
+#include "IMediaView.h"
+
+class FCameraStream;
+class FCamera2MediaSampleWriter;
+class FCamera2ReplaySource;
+class FMediaSamples;
+class IMediaEventSink;
+
+/**
+ * Media Framework player over a camera stream, so UMediaPlayer, UMediaTexture and Media Plates can
+ * show the camera. Opens URLs of the form camera2://<StreamId>[?format=nv12|bgra][&replay=<dir>],
+ * e.g. camera2://0 for the default stream (started on open if needed, stopped on close if so).
+ *
+ * Frames are written on the camera thread straight from the YUV planes into pooled texture samples
+ * (NV12 is a plane copy; BGRA repeats the conversion the camera texture already does), timestamped with their capture time on the
+ * engine clock, and queued up to Camera2.Media.MaxQueuedSamples; the media texture does the color
+ * conversion and sample timing. Off Android the frames come from an FCamera2ReplaySource at 30 fps
+ * (BGRA only). Live source: no seeking or looping; rate 0 pauses sample delivery, not the camera.
+ */
+class ANDROIDCAMERA2PLUGIN_API FCamera2MediaPlayer
+    : public IMediaPlayer
+    , protected IMediaCache
+    , protected IMediaControls
+    , protected IMediaTracks
+    , protected IMediaView
+{
+public:
+    explicit FCamera2MediaPlayer(IMediaEventSink& InEventSink);
+    virtual ~FCamera2MediaPlayer();
+
+    //~ IMediaPlayer
+    virtual void Close() override;
+    virtual IMediaCache& GetCache() override { return *this; }
+    virtual IMediaControls& GetControls() override { return *this; }
+    virtual FString GetInfo() const override;
+    virtual FGuid GetPlayerPluginGUID() const override;
+    virtual IMediaSamples& GetSamples() override;
+    virtual FString GetStats() const override;
+    virtual IMediaTracks& GetTracks() override { return *this; }
+    virtual FString GetUrl() const override { return Url; }
+    virtual IMediaView& GetView() override { return *this; }
+    virtual bool Open(const FString& InUrl, const IMediaOptions* Options) override;
+    virtual bool Open(const TSharedRef<FArchive, ESPMode::ThreadSafe>& Archive, const FString& OriginalUrl,
+        const IMediaOptions* Options) override;
+    virtual void TickInput(FTimespan DeltaTime, FTimespan Timecode) override;
+
+    /** Whether Url names a camera stream (camera2://). */
+    static bool IsCameraUrl(const FString& InUrl);
+
+protected:
+    //~ IMediaControls
+    virtual bool CanControl(EMediaControl Control) const override;
+    virtual FTimespan GetDuration() const override { return FTimespan::MaxValue(); }
+    virtual float GetRate() const override;
+    virtual EMediaState GetState() const override { return State; }
+    virtual EMediaStatus GetStatus() const override { return EMediaStatus::None; }
+    virtual TRangeSet<float> GetSupportedRates(EMediaRateThinning Thinning) const override;
+    virtual FTimespan GetTime() const override;
+    virtual bool IsLooping() const override { return false; }
+    virtual bool Seek(const FTimespan& Time) override { return false; }
+    virtual bool SetLooping(bool Looping) override { return false; }
+    virtual bool SetRate(float Rate) override;
+
+    //~ IMediaTracks
+    virtual bool GetAudioTrackFormat(int32 TrackIndex, int32 FormatIndex, FMediaAudioTrackFormat& OutFormat) const override { return false; }
+    virtual int32 GetNumTracks(EMediaTrackType TrackType) const override;
+    virtual int32 GetNumTrackFormats(EMediaTrackType TrackType, int32 TrackIndex) const override;
+    virtual int32 GetSelectedTrack(EMediaTrackType TrackType) const override;
+    virtual FText GetTrackDisplayName(EMediaTrackType TrackType, int32 TrackIndex) const override;
+    virtual int32 GetTrackFormat(EMediaTrackType TrackType, int32 TrackIndex) const override;
+    virtual FString GetTrackLanguage(EMediaTrackType TrackType, int32 TrackIndex) const override { return FString(); }
+    virtual FString GetTrackName(EMediaTrackType TrackType, int32 TrackIndex) const override;
+    virtual bool GetVideoTrackFormat(int32 TrackIndex, int32 FormatIndex, FMediaVideoTrackFormat& OutFormat) const override;
+    virtual bool SelectTrack(EMediaTrackType TrackType, int32 TrackIndex) override;
+    virtual bool SetTrackFormat(EMediaTrackType TrackType, int32 TrackIndex, int32 FormatIndex) override;
+
+private:
+    bool IsVideoTrack(EMediaTrackType TrackType, int32 TrackIndex) const;
+
+    IMediaEventSink& EventSink;
+    TSharedRef<FMediaSamples, ESPMode::ThreadSafe> Samples;
+    TSharedPtr<FCamera2MediaSampleWriter, ESPMode::ThreadSafe> Writer;
+
+    FString Url;
+    int32 StreamId = INDEX_NONE;
+    FIntPoint Resolution = FIntPoint::ZeroValue;
+    bool bNv12 = false;
+    EMediaState State = EMediaState::Closed;
+    // Engine time (FPlatformTime::Seconds) that media time 0 maps to, and the media time paused at
+    double ClockOrigin = 0.0;
+    FTimespan PausedTime = FTimespan::Zero();
+
+    TWeakPtr<FCameraStream, ESPMode::ThreadSafe> Stream;
+    bool bStartedStream = false;
+
+    // Off Android: frames replayed on the game thread
+    TUniquePtr<FCamera2ReplaySource> Replay;
+    double NextReplayTime = 0.0;
+};
+
+/** Creates FCamera2MediaPlayer for camera2:// URLs; registered with the Media module by the plugin module. */
+class FCamera2MediaPlayerFactory : public IMediaPlayerFactory
+{
+public:
+    FCamera2MediaPlayerFactory();
+
+    virtual bool CanPlayUrl(const FString& Url, const IMediaOptions* Options, TArray<FText>* OutWarnings,
+        TArray<FText>* OutErrors) const override;
+    virtual TSharedPtr<IMediaPlayer, ESPMode::ThreadSafe> CreatePlayer(IMediaEventSink& EventSink) override;
+    virtual FText GetDisplayName() const override;
+    virtual FName GetPlayerName() const override;
+    virtual FGuid GetPlayerPluginGUID() const override;
+    virtual const TArray<FString>& GetSupportedPlatforms() const override { return SupportedPlatforms; }
+    virtual bool SupportsFeature(EMediaFeature Feature) const override;
+
+private:
+    TArray<FString> SupportedPlatforms;
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+/**
+ * Fixed-capacity history of timestamped rigid poses (e.g. HMD in world space).
+ *
+ * Reads are lock-free: each slot is guarded by a sequence counter and readers retry or
+ * skip slots that were overwritten while being read. Writers are serialized by a small
+ * lock so the game-thread tick and the render-thread late update can both push.
+ *
+ * Times are engine seconds (FPlatformTime::Seconds()) and must be pushed in
+ * non-decreasing order; out-of-order samples are dropped.
+ */
+class ANDROIDCAMERA2PLUGIN_API FCamera2PoseHistory
+{
+public:
+    /** @param InCapacity - rounded up to a power of two */
+    explicit FCamera2PoseHistory(int32 InCapacity = 512);
+
+    FCamera2PoseHistory(const FCamera2PoseHistory&) = delete;
+    FCamera2PoseHistory& operator=(const FCamera2PoseHistory&) = delete;
+
+    /** Append a pose. Returns false when the sample is older than the newest one. */
+    bool Push(double TimeSeconds, const FTransform& Pose);
+
+    /**
+     * Interpolated pose at a time (slerp rotation, lerp translation).
+     * Times outside the retained samples clamp to the nearest end (newest or oldest) for up to MaxHoldSeconds.
+     * @return false when the time is further outside the retained window
+     */
+    bool Sample(double TimeSeconds, FTransform& OutPose, double MaxHoldSeconds = 0.05) const;
+
+    /** Interpolated pose composed with a fixed child offset, e.g. CamInHmd -> WorldFromCamera. */
+    bool SampleComposed(double TimeSeconds, const FTransform& ChildInPose, FTransform& OutChildPose, double MaxHoldSeconds = 0.05) const
+    {
+        FTransform Pose;
+        if (!Sample(TimeSeconds, Pose, MaxHoldSeconds))
+        {
+            return false;
+        }
+        // FTransform composition applies left to right: child -> pose space -> parent
+        OutChildPose = ChildInPose * Pose;
+        return true;
+    }
+
+    /** Oldest and newest retained sample times. Returns false when empty. */
+    bool GetTimeRange(double& OutOldest, double& OutNewest) const;
+
+    int32 GetCapacity() const { return Capacity; }
+
+    /** Number of samples pushed since construction or the last Reset(). */
+    uint64 GetTotalPushed() const { return WriteCount.load(std::memory_order_acquire); }
+
+    /** Drop all samples. Not safe against concurrent writers. */
+    void Reset();
+
+private:
+    struct FSlot
+    {
+        // Odd while the slot is being written; 2 * (LogicalIndex + 1) once complete
+        std::atomic<uint64> Sequence{ 0 };
+        // Time, rotation XYZW, translation XYZ
+        std::atomic<double> Data[8];
+    };
+
+    struct FSampleData
+    {
+        double Time;
+        FQuat Rotation;
+        FVector Translation;
+    };
+
+    bool ReadSlot(uint64 LogicalIndex, FSampleData& Out) const;
+
+    int32 Capacity = 0;
+    uint64 IndexMask = 0;
+    TUniquePtr<FSlot[]> Slots;
+
+    // Total number of completed pushes; slot of logical index N is N & IndexMask
+    std::atomic<uint64> WriteCount{ 0 };
+    double LastPushedTime = -DBL_MAX;
+    FCriticalSection WriteLock;
+};
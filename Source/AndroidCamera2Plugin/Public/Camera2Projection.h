@@ -0,0 +1,223 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FQuest3CameraCalibration;
+struct FCamera2FrameMetadata;
+class FCamera2PoseHistory;
+
+/**
+ * Pinhole intrinsics plus lens distortion used by the batched projection kernels.
+ *
+ * Distortion follows the OpenCV rational/tangential model and takes its coefficients
+ * in the order returned by USimpleCamera2Test::GetLensDistortionUE(): [K1,K2,P1,P2,K3,K4,K5,K6].
+ *
+ * Camera space uses UE axes (X forward, Y right, Z up), matching GetCamInHmdTransform().
+ * Normalized image coordinates are x = Y / X (right) and y = -Z / X (down).
+ */
+struct ANDROIDCAMERA2PLUGIN_API FCamera2LensModel
+{
+    float Fx = 0.0f;
+    float Fy = 0.0f;
+    float Cx = 0.0f;
+    float Cy = 0.0f;
+
+    float K1 = 0.0f;
+    float K2 = 0.0f;
+    float P1 = 0.0f;
+    float P2 = 0.0f;
+    float K3 = 0.0f;
+    float K4 = 0.0f;
+    float K5 = 0.0f;
+    float K6 = 0.0f;
+
+    // Image size the intrinsics are expressed in
+    int32 Width = 0;
+    int32 Height = 0;
+
+    // Squared normalized radius beyond which the distortion polynomial is not trusted.
+    // Wide-angle models fold back outside the calibrated area, so points past this are rejected.
+    float MaxRadius2 = 0.0f;
+
+    /** Build from stream intrinsics and the UE-ordered coefficients of GetLensDistortionUE(). */
+    static FCamera2LensModel Make(float InFx, float InFy, float InCx, float InCy, int32 InWidth, int32 InHeight,
+        const TArray<float>& DistortionUE);
+
+    /** Build from the stream-adjusted part of a calibration snapshot. */
+    static FCamera2LensModel FromCalibration(const FQuest3CameraCalibration& Calib, const TArray<float>& DistortionUE);
+
+    /** Same lens seen through a sub-rectangle of the image: principal point moved, trusted radius kept. */
+    FCamera2LensModel Crop(const FIntRect& Rect) const;
+
+    bool IsValid() const { return Fx > 0.0f && Fy > 0.0f && Width > 0 && Height > 0; }
+    bool HasDistortion() const;
+
+    /** Apply distortion to a normalized undistorted coordinate. */
+    FVector2f Distort(const FVector2f& Undistorted) const;
+
+    /** Remove distortion from a normalized distorted coordinate by fixed-point iteration. */
+    FVector2f Undistort(const FVector2f& Distorted, const FVector2f& Seed, int32 Iterations) const;
+
+    bool operator==(const FCamera2LensModel& Other) const;
+    bool operator!=(const FCamera2LensModel& Other) const { return !(*this == Other); }
+};
+
+/** 3D points as structure-of-arrays (cm, in whatever space the caller's transform expects). */
+struct ANDROIDCAMERA2PLUGIN_API FCamera2PointsSoA
+{
+    TArray<float> X;
+    TArray<float> Y;
+    TArray<float> Z;
+
+    int32 Num() const { return X.Num(); }
+    void SetNumUninitialized(int32 Count);
+    void SetNumZeroed(int32 Count);
+    void Reset(int32 Slack = 0);
+    void Add(const FVector& Point);
+    FVector Get(int32 Index) const { return FVector(X[Index], Y[Index], Z[Index]); }
+};
+
+/** Pixel coordinates as structure-of-arrays, with a per-pixel validity mask. */
+struct ANDROIDCAMERA2PLUGIN_API FCamera2PixelsSoA
+{
+    TArray<float> U;
+    TArray<float> V;
+
+    // 1 when the source point was in front of the camera, inside the trusted lens radius and inside the image
+    TArray<uint8> Valid;
+
+    int32 Num() const { return U.Num(); }
+    void SetNumUninitialized(int32 Count);
+    /** Zero pixels, all invalid. */
+    void SetNumZeroed(int32 Count);
+    void Reset(int32 Slack = 0);
+    void Add(const FVector2D& Pixel);
+};
+
+/**
+ * Coarse grid over the distorted image that stores undistorted normalized coordinates.
+ * Used to seed the iterative inversion so only a couple of refinement steps are needed.
+ */
+class ANDROIDCAMERA2PLUGIN_API FCamera2UndistortLUT
+{
+public:
+    /** (Re)build the table for a lens model. Grid sizes are node counts per axis. */
+    void Build(const FCamera2LensModel& InLens, int32 InGridX = 33, int32 InGridY = 33);
+
+    bool IsBuiltFor(const FCamera2LensModel& InLens) const { return GridX > 1 && Lens == InLens; }
+
+    /** Bilinearly sample the undistorted normalized coordinate for a distorted pixel. */
+    FVector2f Sample(float U, float V) const;
+
+    const FCamera2LensModel& GetLens() const { return Lens; }
+
+private:
+    FCamera2LensModel Lens;
+    int32 GridX = 0;
+    int32 GridY = 0;
+    float CellScaleX = 0.0f;
+    float CellScaleY = 0.0f;
+    TArray<FVector2f> Nodes;
+};
+
+namespace Camera2Projection
+{
+    // Row-vector 3x4 affine in float, laid out as in FMatrix (P' = P * M)
+    struct FAffine3x4
+    {
+        float M[4][3];
+
+        FAffine3x4() = default;
+        explicit FAffine3x4(const FTransform& Transform);
+    };
+}
+
+/**
+ * Per-row camera poses for one rolling-shutter frame.
+ *
+ * Sensor rows start exposing one after another over SENSOR_ROLLING_SHUTTER_SKEW, so under head
+ * motion each image row sees the world from a slightly different pose. The table holds the
+ * world-from-camera pose of every stream row at the middle of that row's exposure. The HMD history
+ * is only queried at a few knots across the readout; rows are blended between them.
+ */
+class ANDROIDCAMERA2PLUGIN_API FCamera2RowPoseTable
+{
+public:
+    /**
+     * Build from the HMD history for rows exposed between two times.
+     * @param FirstRowTime - mid-exposure engine time of stream row 0
+     * @param LastRowTime  - mid-exposure engine time of stream row NumRows-1
+     * @return false (and the table is left empty) if the history does not cover the readout
+     */
+    bool Build(const FCamera2PoseHistory& HmdHistory, const FTransform& CamInHmd,
+        double FirstRowTime, double LastRowTime, int32 NumRows, int32 NumKnots = 9);
+
+    /**
+     * Mid-exposure times of the first and last stream rows of a frame.
+     * The sensor timestamp refers to the first row of the full sensor, so a stream cropped
+     * from SensorRows rows starting at SensorRowOffset is shifted into the readout accordingly.
+     */
+    static void GetRowTimeSpan(const FCamera2FrameMetadata& Frame, int32 StreamRows, int32 SensorRows, int32 SensorRowOffset,
+        double& OutFirstRowTime, double& OutLastRowTime);
+
+    void Reset();
+
+    bool IsValid() const { return NumRows > 0; }
+    int32 GetNumRows() const { return NumRows; }
+
+    /** Stream row for a (possibly out-of-image) pixel row coordinate. */
+    int32 RowForPixel(float V) const { return FMath::Clamp(FMath::FloorToInt32(V), 0, NumRows - 1); }
+
+    double GetRowTime(int32 Row) const;
+    FTransform GetWorldFromCamera(int32 Row) const;
+
+    const Camera2Projection::FAffine3x4& GetCameraFromWorldAffine(int32 Row) const { return CameraFromWorld[Row]; }
+    const Camera2Projection::FAffine3x4& GetWorldFromCameraAffine(int32 Row) const { return WorldFromCamera[Row]; }
+
+private:
+    TArray<FTransform> Knots;
+    TArray<Camera2Projection::FAffine3x4> CameraFromWorld;
+    TArray<Camera2Projection::FAffine3x4> WorldFromCamera;
+    double FirstRowTime = 0.0;
+    double LastRowTime = 0.0;
+    int32 NumRows = 0;
+};
+
+namespace Camera2Projection
+{
+    /*
+     * All kernels size their outputs to the input count and always write them: when they cannot run
+     * (invalid lens or row table) outputs are zero, pixels are marked invalid and they return false.
+     */
+
+    /**
+     * Project N points to distorted pixels.
+     * @param CameraFromSpace - transform taking the input points into camera space
+     *                          (e.g. GetCamInHmdTransform().Inverse() for HMD-space points)
+     * @return false (all pixels invalid) for an invalid lens
+     */
+    ANDROIDCAMERA2PLUGIN_API bool ProjectPoints(const FCamera2LensModel& Lens, const FTransform& CameraFromSpace,
+        const FCamera2PointsSoA& Points, FCamera2PixelsSoA& OutPixels);
+
+    /**
+     * Unproject N distorted pixels to unit ray directions.
+     * @param SpaceFromCamera - only its rotation is applied to the camera-space rays (identity for camera space)
+     * @param Iterations      - fixed-point refinement steps after the LUT seed
+     * @return false (zero directions) when the LUT was built for an invalid lens
+     */
+    ANDROIDCAMERA2PLUGIN_API bool UnprojectPixels(const FCamera2UndistortLUT& Lut, const FTransform& SpaceFromCamera,
+        const FCamera2PixelsSoA& Pixels, FCamera2PointsSoA& OutDirections, int32 Iterations = 3);
+
+    /**
+     * Project N world points using the pose of the row each point lands on.
+     * Starts from the middle row's pose, then re-projects each point with the pose of the row it hit.
+     * @param Iterations - row refinement passes; the row moves by (row time delta x image motion), so 2 converge
+     * @return false (all pixels invalid) for an invalid lens or row table
+     */
+    ANDROIDCAMERA2PLUGIN_API bool ProjectPointsRollingShutter(const FCamera2LensModel& Lens, const FCamera2RowPoseTable& Rows,
+        const FCamera2PointsSoA& WorldPoints, FCamera2PixelsSoA& OutPixels, int32 Iterations = 2);
+
+    /** Unproject N pixels to world rays, each from the pose of the pixel's row. False (zero rays) for an invalid lens or row table. */
+    ANDROIDCAMERA2PLUGIN_API bool UnprojectPixelsRollingShutter(const FCamera2UndistortLUT& Lut, const FCamera2RowPoseTable& Rows,
+        const FCamera2PixelsSoA& Pixels, FCamera2PointsSoA& OutOrigins, FCamera2PointsSoA& OutDirections, int32 Iterations = 3);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SimpleCamera2Test.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+/**
+ * Milestones of a camera start, in the order they are reached. Java reports its own through
+ * onStartupMilestone with these values (Camera2Helper STARTUP_* constants).
+ */
+enum class ECamera2StartupMilestone : uint8
+{
+    StartRequested,      // FCameraStream::Start
+    PermissionChecked,   // camera permissions granted
+    TexturesCreated,     // texture ring allocated
+    HelperReady,         // Camera2Helper class loaded and instance fetched
+    JavaStartEntered,    // Java: startCamera entered
+    CamerasProbed,       // Java: camera ids listed and probed, camera selected
+    CharacteristicsRead, // Java: intrinsics, distortion and pose read
+    OpenRequested,       // Java: ImageReader set up, openCamera about to be called
+    CameraOpened,        // Java: CameraDevice.StateCallback.onOpened
+    SessionConfigured,   // Java: capture session configured and repeating request set
+    FirstImage,          // Java: first onImageAvailable
+    FirstFrameConverted, // first frame converted and handed to the texture upload
+    FirstUpload,         // render thread: first texture update executed
+    Count,
+};
+
+/**
+ * Per-start trace of a stream's startup: every milestone is stamped with FPlatformTime::Seconds()
+ * the first time it is reached after Begin, Java ones through their JNI callback. The stages between
+ * consecutive milestones make an FCamera2StartupTrace; completed traces are kept for rolling averages
+ * over the last Camera2.Startup.AverageCount starts. While a start is in progress it is also an
+ * Insights timing region ("Camera2 Startup (stream N)") with a bookmark per milestone.
+ *
+ * Begin and Abort run on the game thread; Mark and the getters on any thread.
+ */
+class ANDROIDCAMERA2PLUGIN_API FCamera2StartupProfiler
+{
+public:
+    explicit FCamera2StartupProfiler(int32 InStreamId);
+
+    /** Start a new trace; a trace still in progress is aborted. */
+    void Begin();
+
+    /** Stamp a milestone of the trace in progress; only its first Mark counts. FirstUpload completes the trace. */
+    void Mark(ECamera2StartupMilestone Milestone);
+
+    /** Whether the trace in progress still waits for Milestone (a relaxed load, cheap enough per frame). */
+    bool IsPending(ECamera2StartupMilestone Milestone) const
+    {
+        return (PendingMask.load(std::memory_order_relaxed) & (1u << static_cast<uint32>(Milestone))) != 0;
+    }
+
+    /** End the trace in progress as incomplete, e.g. when the start failed. No-op without one. */
+    void Abort(const TCHAR* Reason);
+
+    bool GetLastTrace(FCamera2StartupTrace& OutTrace) const;
+    bool GetAverageTrace(FCamera2StartupTrace& OutTrace) const;
+
+    static const TCHAR* GetMilestoneName(ECamera2StartupMilestone Milestone);
+
+    /** One line per stage, for logs. */
+    static FString Describe(const FCamera2StartupTrace& Trace);
+
+private:
+    // Close the trace in progress and publish it (lock held)
+    void Finish(bool bComplete);
+
+    const int32 StreamId;
+    const FString RegionName;
+
+    mutable FCriticalSection Lock;
+    std::atomic<uint32> PendingMask{ 0 };
+    // Engine time of each milestone of the trace in progress, negative until reached
+    double Times[static_cast<int32>(ECamera2StartupMilestone::Count)];
+
+    FCamera2StartupTrace LastTrace;
+    bool bHasLastTrace = false;
+    // Completed traces, oldest first
+    TArray<FCamera2StartupTrace> RecentTraces;
+};
@@ -0,0 +1,442 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Camera2ChangeDetector.h"
+#include "Camera2CharacteristicsTable.h"
+#include "Camera2ClockSync.h"
+#include "Camera2FrameMirror.h"
+#include "Camera2FrameHistory.h"
+#include "Camera2FramePipeline.h"
+#include "Camera2Governor.h"
+#include "Camera2ImageConversion.h"
+#include "Camera2Projection.h"
+#include "Camera2StartupProfiler.h"
+#include "Camera2TextureRing.h"
+#include "SimpleCamera2Test.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+#if PLATFORM_ANDROID
+#include <jni.h>
+#endif
+
+class UTexture2D;
+
+/** Calibration reported by the device for one stream. Fields stay zero/empty until the camera sends them. */
+struct ANDROIDCAMERA2PLUGIN_API FCamera2StreamCalibration
+{
+    // Selected camera (Quest 3: "50" = left, "51" = right); empty before the camera was opened
+    FString CameraId;
+    bool bIsLeftCamera = true;
+
+    // LENS_INTRINSIC_CALIBRATION, in CalibWidth x CalibHeight pixels
+    float Fx = 0.0f;
+    float Fy = 0.0f;
+    float Cx = 0.0f;
+    float Cy = 0.0f;
+    float Skew = 0.0f;
+    int32 CalibWidth = 0;
+    int32 CalibHeight = 0;
+
+    // Raw LENS_DISTORTION coefficients
+    TArray<float> LensDistortion;
+
+    int32 OriginalWidth = 0;
+    int32 OriginalHeight = 0;
+
+    // CamInHmd from LENS_POSE_*, already converted to UE axes and cm
+    bool bPoseAvailable = false;
+    FVector PoseTranslation = FVector::ZeroVector;
+    FQuat PoseRotation = FQuat::Identity;
+
+    bool HasIntrinsics() const { return Fx > 0.0f && Fy > 0.0f && CalibWidth > 0 && CalibHeight > 0; }
+
+    /** LensDistortion mapped to [K1,K2,P1,P2,K3,K4,K5,K6]. */
+    TArray<float> GetLensDistortionUE() const;
+};
+
+/** Frame counters for one stream since it was created. */
+struct FCamera2StreamStats
+{
+    int64 FramesDelivered = 0;
+    int64 FramesDropped = 0;
+    int64 CaptureFailures = 0;
+};
+
+/**
+ * Receives each processed frame of a stream on the camera thread, while its buffers are valid.
+ * Implementations copy what they need and return quickly; they must not call back into the stream.
+ */
+class ICamera2FrameSink
+{
+public:
+    virtual ~ICamera2FrameSink() = default;
+
+    /** A color frame; the planes are only valid during the call. */
+    virtual void ReceiveYuvFrame(const FCamera2YuvPlanes& Planes, const FCamera2FrameMetadata& Metadata) = 0;
+
+    /** A tightly packed BGRA frame (the grayscale fallback). */
+    virtual void ReceiveBgraFrame(const uint8* Bgra, int32 Width, int32 Height, const FCamera2FrameMetadata& Metadata) = 0;
+};
+
+/**
+ * One open camera: its Java Camera2Helper, texture, calibration snapshot, clock mapping and stats.
+ *
+ * Created and owned by UCamera2Subsystem. Start/Stop and the texture/projection accessors are
+ * game-thread only; the Handle* entry points are called from the JNI callbacks on camera threads.
+ */
+class ANDROIDCAMERA2PLUGIN_API FCameraStream : public TSharedFromThis<FCameraStream, ESPMode::ThreadSafe>
+{
+public:
+    FCameraStream(int32 InStreamId, bool bInPreferLeftCamera, FIntPoint InResolution = FIntPoint(1280, 960));
+    ~FCameraStream();
+
+    FCameraStream(const FCameraStream&) = delete;
+    FCameraStream& operator=(const FCameraStream&) = delete;
+
+    /** Create the texture and open the camera. Returns true when the camera is running. */
+    bool Start();
+
+    /** Close the camera and release the texture. */
+    void Stop();
+
+    /**
+     * Warm standby: stop frame delivery and conversion but keep the camera session, buffers and
+     * textures, so Resume() only reissues the capture request. The stream stays active; the texture
+     * keeps the last frame. Returns false if the stream is not running.
+     */
+    bool Pause();
+
+    /** Leave warm standby; restarts the stream if the camera was lost meanwhile. */
+    bool Resume();
+
+    bool IsActive() const { return bActive.load(std::memory_order_acquire); }
+    bool IsPaused() const { return bPaused.load(std::memory_order_acquire); }
+    int32 GetStreamId() const { return StreamId; }
+    FIntPoint GetResolution() const { return Resolution; }
+
+    /** Camera to open on the next Start(). */
+    void SetPreferLeftCamera(bool bInPreferLeft) { bPreferLeftCamera = bInPreferLeft; }
+    bool GetPreferLeftCamera() const { return bPreferLeftCamera; }
+
+    /** Latest fully uploaded camera texture. Changes between frames when Camera2.Texture.BufferCount > 1. */
+    UTexture2D* GetTexture() const { return TextureRing.GetTexture(); }
+
+    /** Keep a material's texture parameter on the latest camera texture (game thread). */
+    void BindTextureParameter(UMaterialInstanceDynamic* Material, FName ParameterName);
+
+    FCamera2TextureRing::FStats GetTextureStats() const { return TextureRing.GetStats(); }
+
+    /**
+     * Produce another texture from every frame: a region, scale, format and optional undistortion
+     * (FCamera2OutputDesc). All outputs are remapped from the YUV planes in one pass on the camera
+     * thread and uploaded through texture rings of their own. Replaces an output of the same name.
+     * Frames arriving as BGRA (grayscale fallback) leave the outputs unchanged. Game thread.
+     * @return false if the name is empty or the region lies outside the frame
+     */
+    bool AddOutput(const FCamera2OutputDesc& Desc);
+    bool RemoveOutput(FName Name);
+
+    /** Latest texture of an output, null before the stream started or for an unknown name (game thread). */
+    UTexture2D* GetOutputTexture(FName Name) const;
+
+    /** Keep a material's texture parameter on an output's latest texture (game thread). */
+    void BindOutputTextureParameter(FName Name, UMaterialInstanceDynamic* Material, FName ParameterName);
+
+    /**
+     * Lens model of an output's texture: the stream lens cropped and scaled (distortion kept), or
+     * the pinhole lens of the undistorted image. False for an unknown name or before the first frame.
+     */
+    bool GetOutputLens(FName Name, FCamera2LensModel& OutLens) const;
+
+    /**
+     * Hand every frame that passes decimation and change detection to Sink on the camera thread,
+     * full resolution and before conversion. The stream keeps a weak reference. Any thread.
+     */
+    void AddFrameSink(const TSharedRef<ICamera2FrameSink, ESPMode::ThreadSafe>& Sink);
+    void RemoveFrameSink(const TSharedRef<ICamera2FrameSink, ESPMode::ThreadSafe>& Sink);
+
+    /** Copy of the calibration received so far. */
+    FCamera2StreamCalibration GetCalibration() const;
+
+    /** Whether this stream uses the left camera: the selected camera once opened, the preference before. */
+    bool UsesLeftCamera() const;
+
+    /** CamInHmd from the device, or the Quest 3 reference pose for this stream's camera. */
+    FTransform GetCamInHmdTransform() const;
+
+    /** Lens model of the stream: runtime intrinsics when available, Quest 3 reference values otherwise. */
+    FCamera2LensModel GetLensModel() const;
+
+    /** Undistort LUT for the current lens model, rebuilt when the calibration changes (game thread). */
+    const FCamera2UndistortLUT& GetUndistortLUT();
+
+    /** Per-row poses of the latest frame, built on first use per frame (game thread). Null if unavailable. */
+    const FCamera2RowPoseTable* GetRowPoseTableForLatestFrame();
+
+    FCamera2ClockSync& GetClockSync() { return ClockSync; }
+
+    /** Metadata of the frame currently in the texture (game thread). Returns false before the first frame. */
+    bool GetLatestFrameMetadata(FCamera2FrameMetadata& OutMetadata) const;
+
+    /** FrameSequence of the frame in the texture, -1 before the first frame; compare to see whether a new one arrived (game thread). */
+    int64 GetFrameSequence() const { return bHasLatestFrameMetadata ? LatestFrameMetadata.FrameSequence : INDEX_NONE; }
+
+    FCamera2StreamStats GetStats() const;
+
+    /** Frames skipped by change detection (Camera2.Change.Enable). */
+    FCamera2ChangeDetector::FStats GetChangeStats() const { return ChangeDetector.GetStats(); }
+
+    /**
+     * Limit conversion and texture upload to these rectangles (stream pixels); empty restores the
+     * full frame. Rectangles are clamped to the frame and grown to even coordinates for the 4:2:0
+     * chroma. The texture keeps its size, so texture UVs do not change; pixels outside every region
+     * keep whatever they last showed.
+     */
+    void SetRegionsOfInterest(const TArray<FIntRect>& InRegions);
+    TArray<FIntRect> GetRegionsOfInterest() const;
+
+    /** Lens model of one region as an image of its own (e.g. the ROI<n> pipeline slot). */
+    bool GetRegionLensModel(int32 RegionIndex, FCamera2LensModel& OutLens) const;
+
+    /**
+     * Also feed every frame into Pipeline. Source slots are filled by name:
+     *   "BGRA"            - the full frame as uploaded to the texture (invalid while regions of interest are set)
+     *   "ROI0", "ROI1"... - each region of interest, in SetRegionsOfInterest order
+     *   "UndistortedBGRA" - undistorted, rescaled by Camera2.Undistort.Scale (see GetUndistortedLens)
+     *   "UndistortedLuma" - same geometry, 8-bit luma
+     * The undistorted slots come straight from the YUV planes in one pass and stay invalid for
+     * frames that arrive as BGRA (grayscale fallback). Slot names are resolved here, not per frame;
+     * other names stay invalid. Frames are dropped by the pipeline when it is full, never queued.
+     * Pass null to detach.
+     */
+    void SetFramePipeline(TSharedPtr<FCamera2FramePipeline, ESPMode::ThreadSafe> InPipeline);
+
+    /** Pinhole lens of the undistorted pipeline slots, once the first frame built their LUT. */
+    bool GetUndistortedLens(FCamera2LensModel& OutLens) const;
+
+    /**
+     * Keep a downsampled CPU copy of every frame for pixel queries (GetMirrorFrame). Built on the
+     * camera thread from the full frame, regardless of regions of interest.
+     */
+    void SetFrameMirrorEnabled(bool bEnabled);
+    bool IsFrameMirrorEnabled() const { return bFrameMirrorEnabled.load(std::memory_order_relaxed); }
+
+    /** Latest mirrored frame, or null while the mirror is disabled or before its first frame. Any thread. */
+    FCamera2FrameMirror::FFramePtr GetMirrorFrame() const { return FrameMirror.GetLatest(); }
+
+    /**
+     * Record the last frames (Camera2.History.Format, MaxFrames, BudgetMB) for lookup after the
+     * fact by sequence or timestamp. Recorded on the camera thread at full resolution, regardless
+     * of regions of interest; disabling drops the recorded frames.
+     */
+    void SetFrameHistoryEnabled(bool bEnabled);
+    bool IsFrameHistoryEnabled() const { return bFrameHistoryEnabled.load(std::memory_order_relaxed); }
+
+    /** Recorded frames; lookups may be made from any thread. */
+    const FCamera2FrameHistory& GetFrameHistory() const { return FrameHistory; }
+
+    /**
+     * Exposure, ISO, frame duration, AE/AWB locks and fps range. Replaces the repeating request of a
+     * running session and is kept for the next Start (game thread).
+     */
+    void SetSensorControls(const FCamera2SensorControls& InControls);
+    FCamera2SensorControls GetSensorControls() const { return SensorControls; }
+
+    /**
+     * Hold Camera2.Governor.LatencyBudgetMs under load: every Camera2.Governor.Interval seconds the
+     * governor looks at upload and pipeline latency, queued frames and thermal state, and may process
+     * only every Nth frame, shrink the undistorted pipeline slots and shed optional pipeline stages
+     * (game thread).
+     */
+    void SetGovernorEnabled(bool bEnabled);
+    bool IsGovernorEnabled() const { return Governor.IsValid(); }
+
+    /** Current governor state; level 0 (full quality) while the governor is off. */
+    FCamera2GovernorState GetGovernorState() const;
+
+    /** Milestone traces of this stream's starts, from Start to the first texture upload. */
+    const FCamera2StartupProfiler& GetStartupProfiler() const { return StartupProfiler; }
+
+    /**
+     * Typed characteristics of the selected camera, or null until they have arrived. They are made
+     * lazily: without a table (or with bRedump) this asks Java for one and returns at once; Java
+     * marshals it on a background thread and it is cached when it arrives. Only one request is in
+     * flight at a time, so polling is cheap, but OnCharacteristicsAvailable avoids polling at all.
+     * Any thread; from other threads the request itself is made on the game thread, which owns the
+     * Java helper. Before the stream has started, the table is of the preferred camera.
+     */
+    FCamera2CharacteristicsTablePtr GetCharacteristicsTable(bool bRedump = false);
+
+    /** A characteristics table was cached on the stream. Fired on the game thread. */
+    DECLARE_MULTICAST_DELEGATE_OneParam(FOnCharacteristicsAvailable, const FCamera2CharacteristicsTablePtr& /*Table*/);
+    FOnCharacteristicsAvailable OnCharacteristicsAvailable;
+
+    /**
+     * Characteristics exported as JSON, and the file under Saved/Camera2 they were written to (once
+     * per table); false until the table has arrived, see GetCharacteristicsTable.
+     */
+    bool GetCharacteristics(bool bRedump, FString& OutJson, FString& OutFilePath);
+
+    // Entry points for the JNI callbacks
+    void HandleFrame(const uint8* FrameData, int32 Width, int32 Height, const int64* Metadata, int32 MetadataCount,
+        int64 SensorClockNowNs, double EngineNow);
+    void HandleYuvFrame(const FCamera2YuvPlanes& Planes, const int64* Metadata, int32 MetadataCount,
+        int64 SensorClockNowNs, double EngineNow);
+    void HandleCameraSelected(const FString& CameraId, bool bIsLeftCamera);
+    void HandleIntrinsics(float Fx, float Fy, float Cx, float Cy, float Skew, int32 Width, int32 Height);
+    void HandleDistortion(const float* Coeffs, int32 Count);
+    void HandleOriginalResolution(int32 Width, int32 Height);
+    void HandleCameraPose(const FVector& TranslationCm, const FQuat& Rotation);
+    // False if the table is of a camera the stream no longer uses
+    bool HandleCharacteristics(const FCamera2CharacteristicsTablePtr& Table);
+    // Milestone reached by Camera2Helper (an ECamera2StartupMilestone value)
+    void HandleStartupMilestone(int32 Milestone);
+
+private:
+    struct FOutput;
+
+    // What a pipeline source slot is filled with, resolved from its name when the pipeline is set
+    enum class EPipelineSource : uint8
+    {
+        None,
+        Frame,
+        Region,
+        UndistortedBgra,
+        UndistortedLuma,
+    };
+
+    struct FPipelineSourceBinding
+    {
+        EPipelineSource Kind = EPipelineSource::None;
+        // Which region of interest, for Region
+        int32 RegionIndex = INDEX_NONE;
+    };
+
+    void CreateTexture();
+    void ReleaseTexture();
+
+    // Clock mapping, metadata and drop accounting for an incoming frame (camera thread)
+    void BeginFrame(const int64* Metadata, int32 MetadataCount, int64 SensorClockNowNs, double EngineNow,
+        FCamera2FrameMetadata& OutMetadata);
+
+    // Hand a BGRA frame to the pipeline and the texture upload; takes ownership of FrameData (new[]).
+    // With Regions, FrameData holds each region packed back to back instead of the full frame.
+    // Planes, when the frame came as YUV, feed the undistorted pipeline slots. A full frame may
+    // carry NumMips levels of mip chain after level 0.
+    void DeliverFrame(uint8* FrameData, const TArray<FIntRect>& Regions, const FCamera2FrameMetadata& FrameMetadata,
+        const FCamera2YuvPlanes* Planes, int32 NumMips = 1);
+
+    // Change detection and statistics for an incoming frame; false if it is unchanged and should be skipped (camera thread)
+    bool AnalyzeFrame(const uint8* Luma, int32 Width, int32 Height, int32 RowStride, int32 PixelStride,
+        FCamera2FrameMetadata& FrameMetadata);
+
+    // Sample load, step the governor and apply its state (game thread)
+    void TickGovernor();
+
+    // Texture ring of one output, once the stream's textures exist (game thread)
+    void CreateOutputTextures(FOutput& Output);
+
+    // Remap every output from this frame's planes and queue the uploads (camera thread)
+    void ProduceOutputs(const FCamera2YuvPlanes& Planes);
+
+    // Sinks still alive, pruning the rest (camera thread)
+    TArray<TSharedPtr<ICamera2FrameSink, ESPMode::ThreadSafe>, TInlineAllocator<2>> GetFrameSinks();
+
+    // Fill one pipeline source slot (camera thread)
+    void FillPipelineSource(const FPipelineSourceBinding& Source, FCamera2PipelineBuffer& Buffer, const uint8* FrameData,
+        const TArray<FIntRect>& Regions, const FCamera2YuvPlanes* Planes);
+    // Remap the planes into an undistorted BGRA or luma slot (camera thread)
+    void FillUndistortedPipelineSource(bool bUndistortedBgra, FCamera2PipelineBuffer& Buffer, const FCamera2YuvPlanes& Planes);
+
+    // Ask Java for a characteristics dump (game thread); clears bCharacteristicsRequested if it cannot
+    void RequestCharacteristics();
+
+#if PLATFORM_ANDROID
+    bool EnsureJavaHelper(JNIEnv* Env);
+    void ReleaseJavaHelper(JNIEnv* Env);
+    void RequestCharacteristicsDumpFromJava(JNIEnv* Env);
+    void ApplySensorControlsToJava(JNIEnv* Env);
+    bool CallJavaBool(JNIEnv* Env, const char* MethodName);
+
+    // Global ref to this stream's com.epicgames.ue4.Camera2Helper
+    jobject JavaHelper = nullptr;
+#endif
+
+    const int32 StreamId;
+    const FIntPoint Resolution;
+    bool bPreferLeftCamera = true;
+    FCamera2SensorControls SensorControls;
+    std::atomic<bool> bActive{ false };
+    std::atomic<bool> bPaused{ false };
+    // FPlatformTime::Seconds() of the last Resume until its first frame arrives, 0 otherwise
+    std::atomic<double> ResumeTime{ 0.0 };
+    FCamera2StartupProfiler StartupProfiler;
+
+    // Camera textures, created while the stream is started
+    FCamera2TextureRing TextureRing;
+    // Mip levels of the ring, for the camera thread to build with full frames
+    std::atomic<int32> TextureMips{ 1 };
+
+    mutable FCriticalSection CalibrationLock;
+    FCamera2StreamCalibration Calibration;
+    FCamera2CharacteristicsTablePtr Characteristics;
+    // Where GetCharacteristics exported Characteristics, empty until then
+    FString CharacteristicsJsonPath;
+    // A dump was asked of Java and has not arrived yet; lookups don't ask again meanwhile
+    std::atomic<bool> bCharacteristicsRequested{ false };
+
+    FCamera2ClockSync ClockSync;
+
+    FCriticalSection PipelineLock;
+    TSharedPtr<FCamera2FramePipeline, ESPMode::ThreadSafe> FramePipeline;
+    // One per source slot of FramePipeline, in GetSourceSlots order
+    TArray<FPipelineSourceBinding> PipelineSources;
+
+    // Extra textures (AddOutput); the list is copied by the camera thread per frame
+    mutable FCriticalSection OutputsLock;
+    TArray<TSharedPtr<FOutput, ESPMode::ThreadSafe>> Outputs;
+
+    FCriticalSection FrameSinksLock;
+    TArray<TWeakPtr<ICamera2FrameSink, ESPMode::ThreadSafe>> FrameSinks;
+
+    mutable FCriticalSection RegionsLock;
+    TArray<FIntRect> RegionsOfInterest;
+
+    // Remap for the undistorted pipeline slots; rebuilt on the camera thread when lens or scale change
+    FCamera2RemapLUT RemapLUT;
+    mutable FCriticalSection RemapLensLock;
+    FCamera2LensModel UndistortedLens;
+
+    std::atomic<bool> bFrameMirrorEnabled{ false };
+    FCamera2FrameMirror FrameMirror;
+
+    std::atomic<bool> bFrameHistoryEnabled{ false };
+    FCamera2FrameHistory FrameHistory;
+
+    FCamera2ChangeDetector ChangeDetector;
+
+    // Governor and what it currently asks of the camera thread
+    TUniquePtr<FCamera2Governor> Governor;
+    FTSTicker::FDelegateHandle GovernorTickerHandle;
+    std::atomic<int32> FrameDecimation{ 1 };
+    std::atomic<float> OutputScale{ 1.0f };
+    // Uploads queued for the game thread, and capture-to-upload latency since the last governor tick
+    std::atomic<int32> PendingUploads{ 0 };
+    double UploadLatencySumMs = 0.0;
+    int32 UploadLatencyCount = 0;
+
+    // Camera callback thread
+    int64 LastDeliveredFrameNumber = -1;
+    int64 DecimationCounter = 0;
+    std::atomic<int64> FramesDelivered{ 0 };
+    std::atomic<int64> FramesDropped{ 0 };
+    std::atomic<int64> CaptureFailures{ 0 };
+
+    // Game thread
+    FCamera2FrameMetadata LatestFrameMetadata;
+    bool bHasLatestFrameMetadata = false;
+    FCamera2UndistortLUT UndistortLUT;
+    FCamera2RowPoseTable RowPoseTable;
+    int64 RowPoseTableSensorTimestampNs = -1;
+};
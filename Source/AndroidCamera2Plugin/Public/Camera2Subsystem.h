@@ -0,0 +1,123 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "Camera2Stream.h"
+#include "Containers/Ticker.h"
+#include "HAL/CriticalSection.h"
+#include "Camera2Subsystem.generated.h"
+
+class UTexture2D;
+class UMaterialInstanceDynamic;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCamera2Frame, int32, StreamId, const FCamera2FrameMetadata&, Metadata);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnCamera2FrameNative, int32 /*StreamId*/, const FCamera2FrameMetadata& /*Metadata*/);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCamera2CharacteristicsAvailable, int32, StreamId);
+
+/**
+ * Owns every open camera stream. Each stream has its own Camera2Helper, texture, calibration,
+ * clock mapping and stats, so two cameras (e.g. left and right) can run side by side.
+ *
+ * Stream 0 is the default stream used by the USimpleCamera2Test functions. While
+ * Camera2.PauseInBackground is set, running streams go into warm standby when the app is
+ * backgrounded and resume when it returns.
+ */
+UCLASS()
+class ANDROIDCAMERA2PLUGIN_API UCamera2Subsystem : public UEngineSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    static constexpr int32 DefaultStreamId = 0;
+
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    /** Null before the engine is up or after shutdown. */
+    static UCamera2Subsystem* Get();
+
+    /** Open and start a new stream on the left or right camera. Returns its id, or -1 on failure. */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Streams")
+    static int32 OpenStream(bool bUseLeftCamera = true);
+
+    /** Stop a stream and release its texture. */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Streams")
+    static void CloseStream(int32 StreamId);
+
+    UFUNCTION(BlueprintPure, Category = "Camera2|Streams")
+    static UTexture2D* GetStreamTexture(int32 StreamId);
+
+    /** Keep a material's texture parameter on the stream's latest camera texture (the texture rotates each frame). */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Streams")
+    static void BindStreamTextureToMaterial(int32 StreamId, UMaterialInstanceDynamic* Material, FName ParameterName);
+
+    UFUNCTION(BlueprintPure, Category = "Camera2|Streams")
+    static bool IsStreamActive(int32 StreamId);
+
+    /** Warm standby: stop frames but keep the camera session and textures (see FCameraStream::Pause). */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Streams")
+    static bool PauseStream(int32 StreamId);
+
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Streams")
+    static bool ResumeStream(int32 StreamId);
+
+    UFUNCTION(BlueprintPure, Category = "Camera2|Streams")
+    static bool IsStreamPaused(int32 StreamId);
+
+    UFUNCTION(BlueprintPure, Category = "Camera2|Streams")
+    static TArray<int32> GetOpenStreamIds();
+
+    /** FrameSequence of the frame in a stream's texture; changes exactly when a new frame arrived. -1 before the first frame. */
+    UFUNCTION(BlueprintPure, Category = "Camera2|Streams")
+    static int64 GetStreamFrameSequence(int32 StreamId);
+
+    /**
+     * A new frame reached a stream's texture. Fired on the game thread at most once per stream and
+     * engine tick, with the newest frame's metadata; frames in between are coalesced.
+     */
+    UPROPERTY(BlueprintAssignable, Category = "Camera2|Streams")
+    FOnCamera2Frame OnCameraFrame;
+
+    /** Same as OnCameraFrame, for C++. */
+    FOnCamera2FrameNative OnCameraFrameNative;
+
+    /**
+     * A stream's camera characteristics arrived; the characteristic lookups now succeed. Fired on the
+     * game thread. In C++, FCameraStream::OnCharacteristicsAvailable also carries the table.
+     */
+    UPROPERTY(BlueprintAssignable, Category = "Camera2|Streams")
+    FOnCamera2CharacteristicsAvailable OnCharacteristicsAvailable;
+
+    TSharedPtr<FCameraStream, ESPMode::ThreadSafe> FindStream(int32 StreamId) const;
+
+    /** The default stream, created (not started) on first use. */
+    TSharedPtr<FCameraStream, ESPMode::ThreadSafe> GetOrCreateDefaultStream();
+
+    /** Camera preference used when the default stream is created. */
+    void SetDefaultPreferLeftCamera(bool bPreferLeft) { bDefaultPreferLeftCamera = bPreferLeft; }
+    bool GetDefaultPreferLeftCamera() const { return bDefaultPreferLeftCamera; }
+
+    /** Stream lookup for the JNI callbacks; safe from any thread, null once the subsystem is gone. */
+    static TSharedPtr<FCameraStream, ESPMode::ThreadSafe> FindStreamForCallback(int32 StreamId);
+
+private:
+    void HandleApplicationWillEnterBackground();
+    void HandleApplicationHasEnteredForeground();
+
+    // Fire OnCameraFrame for every stream whose texture got a new frame since the last tick
+    bool TickFrameNotifications(float DeltaTime);
+
+    mutable FCriticalSection StreamsLock;
+    TMap<int32, TSharedPtr<FCameraStream, ESPMode::ThreadSafe>> Streams;
+    int32 NextStreamId = DefaultStreamId + 1;
+    bool bDefaultPreferLeftCamera = true;
+
+    // Streams paused by HandleApplicationWillEnterBackground, resumed on return (game thread)
+    TArray<TWeakPtr<FCameraStream, ESPMode::ThreadSafe>> StreamsPausedForBackground;
+    FDelegateHandle WillEnterBackgroundHandle;
+    FDelegateHandle HasEnteredForegroundHandle;
+
+    // Last FrameSequence notified per stream (game thread)
+    TMap<int32, int64> NotifiedFrameSequences;
+    FTSTicker::FDelegateHandle FrameNotifyTickerHandle;
+};
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "PixelFormat.h"
+#include "RenderCommandFence.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UTexture2D;
+class UMaterialInstanceDynamic;
+
+/**
+ * N transient textures used round-robin for camera uploads, so the render thread never updates
+ * a texture the GPU may still be sampling.
+ *
+ * Each upload goes to a free slot and is fenced; once the render thread has passed the update,
+ * the newest completed slot is published and returned by GetTexture() (and pushed into bound
+ * material parameters). The previously published slot retires: it is reused only after the render
+ * thread has moved past the frames that could still sample it, plus Camera2.Texture.RetireFrames
+ * further frames for the GPU. With no free slot the upload is dropped rather than stalling.
+ *
+ * Game thread only. Frames advance with the core ticker, or by calling Tick() directly (tests).
+ */
+class ANDROIDCAMERA2PLUGIN_API FCamera2TextureRing
+{
+public:
+    struct FStats
+    {
+        int64 Uploads = 0;
+        int64 Published = 0;
+        // Uploads dropped because every slot was published, retiring or still uploading
+        int64 Dropped = 0;
+        // Completed uploads overtaken by a newer one before they were published
+        int64 Superseded = 0;
+    };
+
+    FCamera2TextureRing() = default;
+    ~FCamera2TextureRing();
+
+    FCamera2TextureRing(const FCamera2TextureRing&) = delete;
+    FCamera2TextureRing& operator=(const FCamera2TextureRing&) = delete;
+
+    /**
+     * Create NumBuffers textures (1 = a single texture updated in place, the old behaviour),
+     * cleared to dark gray. Slot 0 is published immediately.
+     * @param bAutoTick - advance frames from the core ticker
+     * @param Format - PF_B8G8R8A8 or a single-channel format such as PF_G8
+     * @param NumMips - mip levels per texture, clamped to the full chain (levels below 0 are filled by Upload)
+     */
+    bool Create(int32 Width, int32 Height, int32 NumBuffers, bool bAutoTick = true, EPixelFormat Format = PF_B8G8R8A8,
+        int32 NumMips = 1);
+
+    /** Wait for pending uploads and release the textures. */
+    void Release();
+
+    bool IsCreated() const { return Slots.Num() > 0; }
+    int32 GetNumBuffers() const { return Slots.Num(); }
+    int32 GetNumMips() const { return NumMips; }
+
+    /**
+     * Enqueue an update of the next free texture. Data holds each rectangle's pixels packed
+     * back to back and is deleted (delete[]) once uploaded or dropped.
+     * @param NumDataMips - with a single full-texture rectangle, Data may go on with the lower
+     *     levels tightly packed (Camera2ImageConversion::BuildMipChain); they are updated in the same
+     *     render command. Levels the data does not cover keep their previous contents.
+     * @return the slot written, or INDEX_NONE if the upload was dropped
+     */
+    int32 Upload(TArray<FIntRect> Rects, uint8* Data, int32 NumDataMips = 1);
+
+    /** Latest texture whose upload has completed. */
+    UTexture2D* GetTexture() const;
+    int32 GetPublishedSlot() const { return PublishedSlot; }
+
+    /** Keep a texture parameter of a material pointed at the published texture. */
+    void BindMaterialParameter(UMaterialInstanceDynamic* Material, FName ParameterName);
+
+    /** Advance one frame: publish completed uploads and free retired slots. */
+    void Tick();
+
+    /** Frames a slot may be reused after its retirement has reached the render thread. */
+    static int32 GetRetireFrames();
+
+    FStats GetStats() const { return Stats; }
+
+private:
+    enum class ESlotState : uint8
+    {
+        Free,
+        Uploading,
+        Published,
+        Retiring,
+    };
+
+    struct FSlot
+    {
+        UTexture2D* Texture = nullptr;
+        ESlotState State = ESlotState::Free;
+        int64 UploadSerial = 0;
+        int64 RetiredFrame = 0;
+        // Uploading: the update has been executed by the render thread.
+        // Retiring: every command that could reference the texture as published has been executed.
+        FRenderCommandFence Fence;
+    };
+
+    struct FMaterialBinding
+    {
+        TWeakObjectPtr<UMaterialInstanceDynamic> Material;
+        FName ParameterName;
+    };
+
+    void UpdateSlots();
+    void Publish(int32 Slot);
+    void UpdateMaterialBindings();
+    void EnqueueUpload(int32 Slot, TArray<FIntRect> Rects, uint8* Data, int32 NumDataMips);
+
+    TArray<FSlot> Slots;
+    TArray<FMaterialBinding> MaterialBindings;
+    FIntPoint Size = FIntPoint::ZeroValue;
+    int32 BytesPerPixel = 4;
+    int32 NumMips = 1;
+    int32 PublishedSlot = INDEX_NONE;
+    int64 NextUploadSerial = 1;
+    int64 FrameIndex = 0;
+    FStats Stats;
+    FTSTicker::FDelegateHandle TickerHandle;
+};
@@ -74,8 +74,201 @@ struct FQuest3CameraCalibration
     }
 };
 
+// Capture result metadata for one delivered camera frame
+USTRUCT(BlueprintType)
+struct FCamera2FrameMetadata
+{
+    GENERATED_BODY()
+
+    // Start of exposure of the first row (Image.getTimestamp(), sensor clock)
+    UPROPERTY(BlueprintReadOnly, Category = "Frame")
+    int64 SensorTimestampNs = 0;
+
+    // SensorTimestampNs mapped to engine time (FPlatformTime::Seconds())
+    UPROPERTY(BlueprintReadOnly, Category = "Frame")
+    double EngineTimestamp = 0.0;
+
+    // Capture frame number, -1 if the capture callback has not reported it yet
+    UPROPERTY(BlueprintReadOnly, Category = "Frame")
+    int64 FrameNumber = -1;
+
+    // Position among the frames this stream delivered since it was created, from 0; unlike FrameNumber it never resets
+    UPROPERTY(BlueprintReadOnly, Category = "Frame")
+    int64 FrameSequence = 0;
+
+    // Frames the camera produced since the previous delivered frame that were not delivered
+    UPROPERTY(BlueprintReadOnly, Category = "Frame")
+    int32 DroppedFramesBefore = 0;
+
+    // False if the CaptureResult had not arrived when the image was processed; the fields below are then 0
+    UPROPERTY(BlueprintReadOnly, Category = "Frame")
+    bool bHasCaptureResult = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Frame")
+    int64 ExposureTimeNs = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Frame")
+    int64 FrameDurationNs = 0;
+
+    // Time between the start of exposure of the first and last rows
+    UPROPERTY(BlueprintReadOnly, Category = "Frame")
+    int64 RollingShutterSkewNs = 0;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Frame")
+    int32 SensitivityIso = 0;
+
+    // Exposure controls in effect for this capture (see FCamera2SensorControls)
+    UPROPERTY(BlueprintReadOnly, Category = "Frame")
+    bool bManualExposure = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Frame")
+    bool bAutoExposureLocked = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Frame")
+    bool bAutoWhiteBalanceLocked = false;
+
+    // Luma statistics, computed while Camera2.Stats.Enable is set; the fields below are 0 otherwise
+    UPROPERTY(BlueprintReadOnly, Category = "Frame|Statistics")
+    bool bHasImageStats = false;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Frame|Statistics")
+    float MeanLuma = 0.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Frame|Statistics")
+    float LumaVariance = 0.0f;
+
+    // Variance of the Laplacian of the luma: higher is sharper, comparable between frames of one camera
+    UPROPERTY(BlueprintReadOnly, Category = "Frame|Statistics")
+    float Sharpness = 0.0f;
+
+    // 256-bin luma histogram over the sampled pixels (C++ only)
+    uint32 LumaHistogram[256] = {};
+
+    // Largest per-tile luma difference to the previous processed frame (Camera2.Change.Enable), -1 when not measured
+    UPROPERTY(BlueprintReadOnly, Category = "Frame|Statistics")
+    float ChangeScore = -1.0f;
+};
+
+// Exposure controls applied to the repeating capture request; zero values keep the device default
+USTRUCT(BlueprintType)
+struct FCamera2SensorControls
+{
+    GENERATED_BODY()
+
+    // Turn auto-exposure off and use the values below (needs the MANUAL_SENSOR capability)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sensor")
+    bool bManualExposure = false;
+
+    // Clamped to SENSOR_INFO_EXPOSURE_TIME_RANGE; short exposures cut motion blur under head motion
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sensor", meta = (EditCondition = "bManualExposure"))
+    int64 ExposureTimeNs = 0;
+
+    // Clamped to SENSOR_INFO_SENSITIVITY_RANGE
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sensor", meta = (EditCondition = "bManualExposure"))
+    int32 SensitivityIso = 0;
+
+    // 0 derives it from TargetFpsMax
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sensor", meta = (EditCondition = "bManualExposure"))
+    int64 FrameDurationNs = 0;
+
+    // Freeze the current auto-exposure (ignored with manual exposure)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sensor")
+    bool bLockAutoExposure = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sensor")
+    bool bLockAutoWhiteBalance = false;
+
+    // CONTROL_AE_TARGET_FPS_RANGE under auto-exposure; the closest supported range is used
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sensor")
+    int32 TargetFpsMin = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sensor")
+    int32 TargetFpsMax = 0;
+};
+
+// One step of a camera start (see FCamera2StartupTrace)
+USTRUCT(BlueprintType)
+struct FCamera2StartupStage
+{
+    GENERATED_BODY()
+
+    // Permission, TextureCreate, ClassLoading, StartCall, CameraProbe, Characteristics, OpenRequest,
+    // OpenCamera, SessionConfig, FirstImage, FirstConversion or FirstUpload
+    UPROPERTY(BlueprintReadOnly, Category = "Startup")
+    FName Name;
+
+    // From the start request to the beginning of this stage; -1 if the stage was not reached
+    UPROPERTY(BlueprintReadOnly, Category = "Startup")
+    float StartMs = -1.0f;
+
+    UPROPERTY(BlueprintReadOnly, Category = "Startup")
+    float DurationMs = -1.0f;
+};
+
+// Where the time went between StartCameraPreview and the first camera frame reaching the GPU
+USTRUCT(BlueprintType)
+struct FCamera2StartupTrace
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category = "Startup")
+    int32 StreamId = INDEX_NONE;
+
+    // False if the start failed or the stream stopped before its first upload
+    UPROPERTY(BlueprintReadOnly, Category = "Startup")
+    bool bComplete = false;
+
+    // Start request to first upload
+    UPROPERTY(BlueprintReadOnly, Category = "Startup")
+    float TotalMs = -1.0f;
+
+    // TotalMs exceeded Camera2.Startup.BudgetMs
+    UPROPERTY(BlueprintReadOnly, Category = "Startup")
+    bool bOverBudget = false;
+
+    // In startup order
+    UPROPERTY(BlueprintReadOnly, Category = "Startup")
+    TArray<FCamera2StartupStage> Stages;
+
+    // Completed starts averaged into this trace; 1 for a single start
+    UPROPERTY(BlueprintReadOnly, Category = "Startup")
+    int32 NumStarts = 0;
+};
+
+// An extra texture produced from every camera frame alongside the main one (see AddCameraOutput)
+USTRUCT(BlueprintType)
+struct FCamera2OutputDesc
+{
+    GENERATED_BODY()
+
+    // Key for the texture and intrinsics queries; adding a name again replaces that output
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output")
+    FName Name;
+
+    // Output size relative to the source region, 1/16 to 2 (0.25 = quarter-resolution thumbnail)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output", meta = (ClampMin = "0.0625", ClampMax = "2.0"))
+    float Scale = 1.0f;
+
+    // 8-bit luma (PF_G8) instead of BGRA
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output")
+    bool bLuma = false;
+
+    // Source region in stream pixels; a zero size means the full frame
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output")
+    FIntPoint RegionOrigin = FIntPoint::ZeroValue;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output")
+    FIntPoint RegionSize = FIntPoint::ZeroValue;
+
+    // Remove lens distortion: the output is then an ideal pinhole image
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Output")
+    bool bUndistorted = false;
+};
+
 /**
  * Simple Camera2 API - Basic camera to texture functionality
+ *
+ * Drives the default stream of UCamera2Subsystem; use UCamera2Subsystem::OpenStream for more cameras.
  */
 UCLASS(BlueprintType)
 class ANDROIDCAMERA2PLUGIN_API USimpleCamera2Test : public UObject
@@ -90,6 +283,21 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Camera2")
     static bool StartCameraPreview();
 
+    /**
+     * Stop frames without closing the camera: the session, buffers and texture stay alive, so
+     * ResumeCameraStream delivers again within a frame or two. The texture keeps the last frame.
+     * @return false if the camera is not running
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2")
+    static bool PauseCameraStream();
+
+    /** Resume after PauseCameraStream (restarts the camera if it was lost meanwhile). */
+    UFUNCTION(BlueprintCallable, Category = "Camera2")
+    static bool ResumeCameraStream();
+
+    UFUNCTION(BlueprintPure, Category = "Camera2")
+    static bool IsCameraStreamPaused();
+
     /**
      * Start camera preview with explicit camera selection
      * @param bUseLeftCamera - true for left camera (ID 50), false for right (ID 51)
@@ -106,11 +314,45 @@ public:
 
     /**
      * Get the camera preview texture (null if preview not started)
-     * @return texture containing camera feed
+     * @return latest fully uploaded texture containing camera feed; may differ from frame to frame
      */
     UFUNCTION(BlueprintCallable, Category = "Camera2")
     static class UTexture2D* GetCameraTexture();
 
+    /**
+     * Keep a material's texture parameter on the latest camera texture. The preview rotates
+     * between Camera2.Texture.BufferCount textures, so bind instead of setting GetCameraTexture() once.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2")
+    static void BindCameraTextureToMaterial(class UMaterialInstanceDynamic* Material, FName ParameterName);
+
+    /**
+     * Produce another texture from every frame of the default stream (region, scale, luma or BGRA,
+     * undistorted or not), e.g. a quarter-resolution thumbnail. All outputs come from one pass over
+     * the YUV planes. Adding a name again replaces that output.
+     * @return false if the name is empty or the region lies outside the frame
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Outputs")
+    static bool AddCameraOutput(const FCamera2OutputDesc& Desc);
+
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Outputs")
+    static bool RemoveCameraOutput(FName Name);
+
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Outputs")
+    static class UTexture2D* GetCameraOutputTexture(FName Name);
+
+    /** Keep a material's texture parameter on an output's latest texture. */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Outputs")
+    static void BindCameraOutputToMaterial(FName Name, class UMaterialInstanceDynamic* Material, FName ParameterName);
+
+    /**
+     * Intrinsics of an output's texture in its own pixels. Plain outputs keep the lens distortion
+     * of the stream; undistorted ones are ideal pinhole images.
+     * @return false for an unknown name or before the output's first frame
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Outputs")
+    static bool GetCameraOutputIntrinsics(FName Name, float& OutFx, float& OutFy, FVector2D& OutPrincipalPoint, FIntPoint& OutSize);
+
     // Intrinsic calibration accessors (pixels)
     UFUNCTION(BlueprintPure, Category = "Camera2|Intrinsics")
     static float GetCameraFx();
@@ -137,9 +379,35 @@ public:
     UFUNCTION(BlueprintPure, Category = "Camera2|Lens Distortion")
     static TArray<float> GetLensDistortionUE();
     
-    // Unified access to camera characteristics JSON + saved file path
+    // Unified access to camera characteristics JSON + saved file path. The dump is made in the background
+    // on first use (or bRedump); returns false until it has arrived, so poll it
     UFUNCTION(BlueprintCallable, Category = "Camera2|Characteristics")
-    static void GetCameraCharacteristics(bool bRedump, FString& OutJson, FString& OutFilePath);
+    static bool GetCameraCharacteristics(bool bRedump, FString& OutJson, FString& OutFilePath);
+
+    // Typed lookups by Android key name (e.g. android.sensor.info.activeArraySize), without JSON. Like
+    // GetCameraCharacteristics they request the characteristics on first use and return false until they arrive;
+    // UCamera2Subsystem::OnCharacteristicsAvailable fires when they do
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Characteristics")
+    static bool GetCameraCharacteristicInt(FName Key, int64& OutValue);
+
+    // Float, int, bool or rational (as a fraction)
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Characteristics")
+    static bool GetCameraCharacteristicFloat(FName Key, float& OutValue);
+
+    // All values of an integer key: arrays, sizes (w,h), rects (l,t,r,b), ranges (lower,upper), rationals (num,den)
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Characteristics")
+    static bool GetCameraCharacteristicInts(FName Key, TArray<int64>& OutValues);
+
+    // All values of a numeric key as floats; rationals become fractions
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Characteristics")
+    static bool GetCameraCharacteristicFloats(FName Key, TArray<float>& OutValues);
+
+    // Values the table has no typed layout for, as text
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Characteristics")
+    static bool GetCameraCharacteristicString(FName Key, FString& OutValue);
+
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Characteristics")
+    static TArray<FName> GetCameraCharacteristicKeys();
     
     // ============================================================================
     // CAMERA SELECTION (Quest 3: camera 50 = left, camera 51 = right)
@@ -175,7 +443,22 @@ public:
     // Use this directly in ComputeTagPose as the CamInHmd parameter
     UFUNCTION(BlueprintPure, Category = "Camera2|Pose")
     static FTransform GetCamInHmdTransform();
-    
+
+    /**
+     * HMD pose in world space at an engine time (FPlatformTime::Seconds() clock) the head was at it,
+     * interpolated from the pose history (late-update samples, or tick samples without rendering).
+     * @return false if the time is outside the retained history (~4 seconds)
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Pose")
+    static bool GetHmdPoseAtTime(double EngineTimeSeconds, FTransform& OutHmdToWorld);
+
+    /**
+     * World-from-camera transform at an engine time: GetCamInHmdTransform() composed with
+     * the interpolated HMD pose. Use the frame's exposure time to avoid lag under head motion.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Pose")
+    static bool GetWorldFromCameraAtTime(double EngineTimeSeconds, FTransform& OutWorldFromCamera);
+
     // ============================================================================
     // QUEST 3 HARDCODED CALIBRATION DATA
     // These values are extracted from actual Quest 3 device dumps and can be used
@@ -234,5 +517,246 @@ public:
      */
     UFUNCTION(BlueprintCallable, Category = "Camera2|Diagnostics")
     static void IsRuntimeCalibrationAvailable(bool& bOutHasIntrinsics, bool& bOutHasPose);
-    
+
+    // ============================================================================
+    // FRAME TIMING (sensor timestamps mapped to engine time)
+    // ============================================================================
+
+    /**
+     * Exposure-start time of the frame currently in the camera texture, in engine seconds
+     * (FPlatformTime::Seconds() domain). Pass to GetWorldFromCameraAtTime. 0 before the first frame.
+     */
+    UFUNCTION(BlueprintPure, Category = "Camera2|Timing")
+    static double GetLatestFrameTimestamp();
+
+    /** Raw sensor timestamp (Image.getTimestamp(), nanoseconds) of the frame currently in the camera texture. */
+    UFUNCTION(BlueprintPure, Category = "Camera2|Timing")
+    static int64 GetLatestFrameSensorTimestampNs();
+
+    /** Map a sensor timestamp to engine seconds. Returns false until enough frames were seen to fit the mapping. */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Timing")
+    static bool SensorTimestampToEngineTime(int64 SensorTimestampNs, double& OutEngineSeconds);
+
+    /** State of the sensor-to-engine clock mapping (drift estimate, residual jitter, rejected clock pairs). */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Diagnostics")
+    static void GetSensorClockSyncStats(bool& bOutValid, double& OutDriftPpm, double& OutResidualMs, int32& OutRejectedPairs);
+
+    /**
+     * Clock mapping of the default stream. Null when the camera subsystem is not available. The pointer
+     * shares ownership of the stream, so it stays usable if the stream is closed meanwhile.
+     */
+    static TSharedPtr<class FCamera2ClockSync, ESPMode::ThreadSafe> GetSensorClockSync();
+
+    /**
+     * Capture result metadata (exposure, frame duration, rolling-shutter skew, ISO, frame number)
+     * of the frame currently in the camera texture.
+     * @return false before the first frame
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Timing")
+    static bool GetLatestFrameMetadata(FCamera2FrameMetadata& OutMetadata);
+
+    /**
+     * FrameSequence of the frame currently in the camera texture, -1 before the first frame. Cheap:
+     * compare with the value seen last time to do work only when the image changed. For a push
+     * notification, bind UCamera2Subsystem::OnCameraFrame.
+     */
+    UFUNCTION(BlueprintPure, Category = "Camera2|Timing")
+    static int64 GetFrameSequence();
+
+    /**
+     * Latent: continue once a frame other than the current one is in the camera texture, including the
+     * first frame after the default stream was closed and reopened. Completes from
+     * UCamera2Subsystem::OnCameraFrame for the default stream, so it costs nothing per tick while waiting.
+     * @param TimeoutSeconds - give up after this long (0 = wait indefinitely); bOutTimedOut is then set
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Timing", meta = (Latent, LatentInfo = "LatentInfo", WorldContext = "WorldContextObject"))
+    static void WaitForNextCameraFrame(UObject* WorldContextObject, float TimeoutSeconds, FCamera2FrameMetadata& OutMetadata,
+        bool& bOutTimedOut, FLatentActionInfo LatentInfo);
+
+    /** Frames delivered, frames dropped (frame-number gaps) and failed captures since startup. */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Diagnostics")
+    static void GetFrameDropStats(int64& OutFramesDelivered, int64& OutFramesDropped, int64& OutCaptureFailures);
+
+    /**
+     * Switch between auto and manual exposure, lock AE/AWB or set the target fps range. Applied to
+     * the running session by replacing its repeating request (no reconfiguration), or on the next
+     * start; the values in effect come back in each frame's metadata.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Sensor")
+    static void SetCameraSensorControls(const FCamera2SensorControls& Controls);
+
+    UFUNCTION(BlueprintPure, Category = "Camera2|Sensor")
+    static FCamera2SensorControls GetCameraSensorControls();
+
+    /** Frames checked by change detection, frames skipped as unchanged, and the skip rate (0-1). */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Diagnostics")
+    static void GetFrameChangeStats(int64& OutFramesEvaluated, int64& OutFramesSkipped, float& OutSkipRate);
+
+    /**
+     * Let the governor hold Camera2.Governor.LatencyBudgetMs by processing fewer frames, shrinking
+     * derived outputs and shedding optional pipeline stages under load or thermal pressure.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Diagnostics")
+    static void SetCameraGovernorEnabled(bool bEnabled);
+
+    /** Governor level (0 = full quality) and the frame decimation it applies. */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Diagnostics")
+    static int32 GetCameraGovernorLevel(int32& OutDecimation);
+
+    /** Milestone breakdown of the last camera start, complete or not; false if the camera was never started. */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Diagnostics")
+    static bool GetCameraStartupTrace(FCamera2StartupTrace& OutTrace);
+
+    /** Stage times averaged over the last Camera2.Startup.AverageCount completed starts. */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Diagnostics")
+    static bool GetCameraStartupAverage(FCamera2StartupTrace& OutAverage);
+
+    /**
+     * Estimate motion blur of a frame in pixels from the HMD rotation during its exposure.
+     * Use to skip frames for detection during fast head turns.
+     * @return false without a capture result or pose history for the exposure window
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Timing")
+    static bool EstimateFrameMotionBlur(const FCamera2FrameMetadata& Metadata, float& OutBlurPixels);
+
+    // ============================================================================
+    // BATCHED PROJECTION (pinhole + GetLensDistortionUE coefficients)
+    // For large point sets call Camera2Projection::ProjectPoints/UnprojectPixels
+    // from C++ directly with SoA buffers to avoid the array conversions.
+    // ============================================================================
+
+    /**
+     * Project points to distorted pixels of the current stream (1280x960).
+     *
+     * @param Points - points in HMD space, or world space when bPointsInWorldSpace is set
+     * @param bPointsInWorldSpace - treat Points as world space and go through HmdToWorld
+     * @param HmdToWorld - HMD pose in world space (ignored for HMD-space points)
+     * @param OutPixels - pixel coordinates, same order as Points
+     * @param OutValid - false for points behind the camera, outside the lens model or outside the image
+     * @return false without valid intrinsics (pixels zero and all invalid)
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Projection")
+    static bool ProjectPointsToPixels(const TArray<FVector>& Points, bool bPointsInWorldSpace, const FTransform& HmdToWorld,
+        TArray<FVector2D>& OutPixels, TArray<bool>& OutValid);
+
+    /**
+     * Unproject distorted pixels of the current stream to undistorted unit rays.
+     *
+     * @param Pixels - pixel coordinates in the 1280x960 stream
+     * @param bRaysInWorldSpace - return rays in world space (through HmdToWorld) instead of HMD space
+     * @param HmdToWorld - HMD pose in world space (ignored for HMD-space rays)
+     * @param OutRayOrigin - camera center, shared by all rays
+     * @param OutRayDirections - unit directions, same order as Pixels
+     * @return false without a stream or valid intrinsics (directions zero)
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Projection")
+    static bool UnprojectPixelsToRays(const TArray<FVector2D>& Pixels, bool bRaysInWorldSpace, const FTransform& HmdToWorld,
+        FVector& OutRayOrigin, TArray<FVector>& OutRayDirections);
+
+    /**
+     * Project world points into the latest frame using a per-row camera pose (rolling shutter).
+     * Each row's pose comes from the HMD history at that row's capture time, so points stay put
+     * under fast head turns where a single per-frame pose smears them.
+     * @return false without frame metadata, pose history for the frame's readout or valid intrinsics
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Projection")
+    static bool ProjectWorldPointsRollingShutter(const TArray<FVector>& WorldPoints,
+        TArray<FVector2D>& OutPixels, TArray<bool>& OutValid);
+
+    /**
+     * Unproject pixels of the latest frame to world rays using a per-row camera pose (rolling shutter).
+     * Each ray starts at the camera center of its pixel's row.
+     * @return false as ProjectWorldPointsRollingShutter (rays empty or zero)
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Projection")
+    static bool UnprojectPixelsToWorldRaysRollingShutter(const TArray<FVector2D>& Pixels,
+        TArray<FVector>& OutRayOrigins, TArray<FVector>& OutRayDirections);
+
+    /**
+     * Per-row poses of the latest frame, built on first use per frame (game thread). Null if unavailable.
+     * The pointer shares ownership of the stream; the table is rebuilt in place for the next frame.
+     */
+    static TSharedPtr<const class FCamera2RowPoseTable, ESPMode::ThreadSafe> GetRowPoseTableForLatestFrame();
+
+    /**
+     * Lens model of the current stream: runtime intrinsics when available, Quest 3 reference values otherwise.
+     * Does not log, so it is safe to call every frame.
+     */
+    static struct FCamera2LensModel GetCurrentLensModel();
+
+    // ============================================================================
+    // REGIONS OF INTEREST (convert and upload only parts of the frame)
+    // ============================================================================
+
+    /**
+     * Add a rectangle of the 1280x960 stream to convert and upload; the rest of the camera
+     * texture keeps its last content. Bounds are grown to even pixel coordinates.
+     * @return index of the region, or -1 if it lies outside the frame
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Region Of Interest")
+    static int32 AddCameraRegionOfInterest(FIntPoint Origin, FIntPoint Size);
+
+    /** Go back to converting and uploading the full frame. */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Region Of Interest")
+    static void ClearCameraRegionsOfInterest();
+
+    /** Current regions as origin/size pairs, after clamping and even alignment. */
+    UFUNCTION(BlueprintPure, Category = "Camera2|Region Of Interest")
+    static void GetCameraRegionsOfInterest(TArray<FIntPoint>& OutOrigins, TArray<FIntPoint>& OutSizes);
+
+    /**
+     * GetCurrentQuest3Calibration re-derived for one region treated as an image of its own:
+     * Stream* fields describe the crop (principal point shifted, resolution = region size).
+     * @return false if there is no region with that index
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Region Of Interest")
+    static bool GetRegionOfInterestCalibration(int32 RegionIndex, FQuest3CameraCalibration& OutCalibration);
+
+    // ============================================================================
+    // FRAME MIRROR (CPU pixel queries, no GPU readback)
+    // ============================================================================
+
+    /**
+     * Keep a CPU copy of each frame, downsampled by Camera2.Mirror.Downsample, for the queries
+     * below. Costs one downsample pass per frame on the camera thread while enabled.
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Frame Mirror")
+    static void SetCameraFrameMirrorEnabled(bool bEnabled);
+
+    /**
+     * Color of a stream pixel in the latest mirrored frame (the average of its downsample block).
+     * @return false if the mirror is disabled, has no frame yet or the pixel is outside the frame
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Frame Mirror")
+    static bool GetCameraPixelAt(FIntPoint Pixel, FColor& OutColor);
+
+    /** Mean luma (0-255) of a stream rectangle in the latest mirrored frame. Constant time. */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Frame Mirror")
+    static bool GetCameraMeanLuminanceInRect(FIntPoint Origin, FIntPoint Size, float& OutMean);
+
+    /** Luma histogram of a stream rectangle, NumBins (1-256) equal bins over 0-255, counted in mirror pixels. */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Frame Mirror")
+    static bool GetCameraHistogram(FIntPoint Origin, FIntPoint Size, int32 NumBins, TArray<int32>& OutBins);
+
+    // ============================================================================
+    // FRAME HISTORY (recent frames for processing after the fact)
+    // ============================================================================
+
+    /** Record the last Camera2.History.MaxFrames frames, within Camera2.History.BudgetMB. Disabling drops them. */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Frame History")
+    static void SetCameraFrameHistoryEnabled(bool bEnabled);
+
+    /**
+     * Metadata of the recorded frame captured closest to an engine time (FPlatformTime::Seconds()).
+     * Pass OutMetadata.FrameSequence to C++ (FCamera2FrameHistory::FindBySequence) for the pixels.
+     * @param MaxDeltaSeconds - reject frames further away than this (0 = any)
+     * @return false if no recorded frame is close enough
+     */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Frame History")
+    static bool FindCameraHistoryFrame(double EngineTime, double MaxDeltaSeconds, FCamera2FrameMetadata& OutMetadata);
+
+    /** Frames held, bytes held, and frames evicted or rejected since the stream was created. */
+    UFUNCTION(BlueprintCallable, Category = "Camera2|Frame History")
+    static void GetCameraFrameHistoryStats(int32& OutFrames, int64& OutBytes, int64& OutEvicted, int64& OutRejected);
+
 };
\ No newline at end of file